@@ -0,0 +1,21 @@
+#ifndef BENCHMARKS_H
+#define BENCHMARKS_H
+
+#include <stdint.h>
+#include "workload.h"
+
+#define BENCH_RUNS 20  /* Measured runs per configuration */
+
+/* Timing of repeated runs of a job */
+typedef struct {
+    uint64_t min_us;
+    uint64_t max_us;
+    uint64_t avg_us;
+} bench_stats_t;
+
+void bench_measure(void (*job)(jobReturn_t*), uint32_t runs, bench_stats_t *stats);
+
+void interference_benchmark(void);
+void dsp_benchmark(void);
+
+#endif /* BENCHMARKS_H */
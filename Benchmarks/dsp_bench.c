@@ -0,0 +1,68 @@
+/**
+ * @file dsp_bench.c
+ * @brief DSP kernel benchmark: cycles per sample of the portable and SIMD
+ *        variants, and the call counts that fill the task budgets.
+ */
+#include <stdio.h>
+#include "bsp.h"
+#include "hardware/sync.h"
+#include "dsp.h"
+#include "benchmarks.h"
+
+#define DSP_BENCH_CALLS 200  /* Kernel calls per measurement */
+
+typedef struct {
+    const char* name;
+    uint32_t budget_cycles;
+} budget_t;
+
+static const budget_t budgets[] = {
+    { "A", EXECUTION_TIME_A },
+    { "C", EXECUTION_TIME_C },
+    { "E", EXECUTION_TIME_E },
+};
+#define NUM_BUDGETS (sizeof(budgets) / sizeof(budgets[0]))
+
+/**
+ * @brief Cycles per sample of a kernel, times 100.
+ */
+static uint32_t cycles_per_sample_x100(dsp_kernel_t kernel, dsp_variant_t variant) {
+    jobReturn_t result;
+
+    uint32_t irq = save_and_disable_interrupts();
+    job_dsp(&result, kernel, variant, DSP_BENCH_CALLS);
+    restore_interrupts(irq);
+
+    uint64_t cycles = (result.stop - result.start) * CYCLES_PER_US;
+    return (uint32_t)((cycles * 100) / ((uint64_t)DSP_BENCH_CALLS * dsp_samples_per_call(kernel)));
+}
+/*-----------------------------------------------------------*/
+
+void dsp_benchmark(void) {
+    dsp_init();
+
+    printf("\n--- DSP kernels (%u calls, SIMD %s) ---\n", DSP_BENCH_CALLS,
+           dsp_simd_available() ? "available" : "not available, portable fallback");
+    printf("Kernel  | Portable cyc/sample | SIMD cyc/sample | Speedup x100\n");
+
+    for (dsp_kernel_t k = 0; k < DSP_NUM_KERNELS; k++) {
+        uint32_t portable = cycles_per_sample_x100(k, DSP_VARIANT_PORTABLE);
+        uint32_t simd = cycles_per_sample_x100(k, DSP_VARIANT_SIMD);
+
+        printf("%-7s | %16u.%02u | %12u.%02u | %u\n", dsp_kernel_name(k),
+               portable / 100, portable % 100, simd / 100, simd % 100,
+               simd ? (portable * 100) / simd : 0);
+    }
+
+    printf("\nCalls per job filling the execution-time budgets (portable / SIMD)\n");
+    for (uint32_t b = 0; b < NUM_BUDGETS; b++) {
+        printf("Budget %s:", budgets[b].name);
+        for (dsp_kernel_t k = 0; k < DSP_NUM_KERNELS; k++) {
+            printf("  %s %u/%u", dsp_kernel_name(k),
+                   dsp_calibrate(k, DSP_VARIANT_PORTABLE, budgets[b].budget_cycles),
+                   dsp_calibrate(k, DSP_VARIANT_SIMD, budgets[b].budget_cycles));
+        }
+        printf("\n");
+    }
+}
+/*-----------------------------------------------------------*/
@@ -0,0 +1,130 @@
+/**
+ * @file interference.c
+ * @brief Inter-core memory interference: runs an aggressor kernel on core 1
+ *        and measures the execution-time inflation of jobs on core 0.
+ */
+#include <stdio.h>
+#include "bsp.h"
+#include "pico/multicore.h"
+#include "benchmarks.h"
+
+#define VICTIM_ACCESSES 20000  /* Word accesses per memory victim job */
+
+typedef struct {
+    const char* name;
+    mem_stress_t cfg;
+} aggressor_t;
+
+typedef struct {
+    const char* name;
+    void (*job)(jobReturn_t*);
+} victim_t;
+
+static const aggressor_t aggressors[] = {
+    { "SRAM seq read",   { .target = MEM_TARGET_SRAM,      .pattern = MEM_ACCESS_SEQUENTIAL } },
+    { "SRAM rand write", { .target = MEM_TARGET_SRAM,      .pattern = MEM_ACCESS_RANDOM, .write = true } },
+    { "SRAM8 write",     { .target = MEM_TARGET_SRAM_BANK, .pattern = MEM_ACCESS_SEQUENTIAL, .write = true } },
+    { "XIP stride 64",   { .target = MEM_TARGET_XIP,       .pattern = MEM_ACCESS_STRIDED, .stride = 64 } },
+    { "APB timer read",  { .target = MEM_TARGET_PERIPH,    .pattern = MEM_ACCESS_SEQUENTIAL } },
+};
+#define NUM_AGGRESSORS (sizeof(aggressors) / sizeof(aggressors[0]))
+
+static void victim_sram(jobReturn_t* retval) {
+    static const mem_stress_t cfg = { .target = MEM_TARGET_SRAM, .pattern = MEM_ACCESS_SEQUENTIAL };
+    job_mem_stress(retval, &cfg, VICTIM_ACCESSES);
+}
+
+static void victim_bank(jobReturn_t* retval) {
+    static const mem_stress_t cfg = { .target = MEM_TARGET_SRAM_BANK, .pattern = MEM_ACCESS_SEQUENTIAL };
+    job_mem_stress(retval, &cfg, VICTIM_ACCESSES);
+}
+
+static void victim_xip(jobReturn_t* retval) {
+    static const mem_stress_t cfg = { .target = MEM_TARGET_XIP, .pattern = MEM_ACCESS_SEQUENTIAL };
+    job_mem_stress(retval, &cfg, VICTIM_ACCESSES);
+}
+
+static const victim_t victims[] = {
+    { "job_A",      job_A },
+    { "job_E",      job_E },
+    { "SRAM read",  victim_sram },
+    { "SRAM8 read", victim_bank },
+    { "XIP read",   victim_xip },
+};
+#define NUM_VICTIMS (sizeof(victims) / sizeof(victims[0]))
+
+/* Aggressor running on core 1 */
+static const mem_stress_t* volatile aggressor_cfg;
+static volatile bool aggressor_stop;
+
+static void aggressor_core1(void) {
+    while (!aggressor_stop) {
+        (void)mem_stress(aggressor_cfg, 1024);
+    }
+    while (true) {
+        tight_loop_contents();
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void aggressor_start(const mem_stress_t* cfg) {
+    aggressor_cfg = cfg;
+    aggressor_stop = false;
+    multicore_reset_core1();
+    multicore_launch_core1(aggressor_core1);
+    sleep_ms(1);  /* Let the aggressor reach its steady state */
+}
+/*-----------------------------------------------------------*/
+
+static void aggressor_end(void) {
+    aggressor_stop = true;
+    sleep_ms(1);
+    multicore_reset_core1();
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Measure every victim alone and against every aggressor.
+ *
+ * Prints the inflation of the worst-case execution time relative to the
+ * isolated run, and per victim the largest inflation, which is the margin
+ * to add to single-core WCETs.
+ */
+void interference_benchmark(void)
+{
+    printf("\n========== Inter-core Interference ==========\n");
+    printf("Victim     | Aggressor       | Base max   | Max        | Avg        | Inflation\n");
+    printf("-----------+-----------------+------------+------------+------------+----------\n");
+
+    for (uint32_t v = 0; v < NUM_VICTIMS; v++) {
+        bench_stats_t base;
+        uint32_t worst_permille = 0;
+
+        bench_measure(victims[v].job, BENCH_RUNS, &base);
+        printf("%-10s | %-15s | %7llu us | %7llu us | %7llu us |      -\n",
+               victims[v].name, "none", base.max_us, base.max_us, base.avg_us);
+
+        for (uint32_t a = 0; a < NUM_AGGRESSORS; a++) {
+            bench_stats_t loaded;
+
+            aggressor_start(&aggressors[a].cfg);
+            bench_measure(victims[v].job, BENCH_RUNS, &loaded);
+            aggressor_end();
+
+            uint32_t permille = 0;
+            if (loaded.max_us > base.max_us && base.max_us > 0) {
+                permille = (uint32_t)(((loaded.max_us - base.max_us) * 1000) / base.max_us);
+            }
+            if (permille > worst_permille) {
+                worst_permille = permille;
+            }
+            printf("%-10s | %-15s | %7llu us | %7llu us | %7llu us | %4u.%u %%\n",
+                   victims[v].name, aggressors[a].name, base.max_us, loaded.max_us,
+                   loaded.avg_us, permille / 10, permille % 10);
+        }
+        printf("%-10s | WCET margin: %u.%u %%\n", victims[v].name,
+               worst_permille / 10, worst_permille % 10);
+    }
+    printf("=============================================\n\n");
+}
+/*-----------------------------------------------------------*/
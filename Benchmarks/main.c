@@ -0,0 +1,72 @@
+#include <stdio.h>
+#include "bsp.h"
+#include "hardware/sync.h"
+#include "benchmarks.h"
+
+/*************************************************************/
+
+/* Benchmark suites to run (1 = enabled) */
+#define RUN_INTERFERENCE_BENCH 1
+#define RUN_DSP_BENCH          1
+
+/**
+ * @brief Run a job repeatedly with interrupts disabled and collect its timing.
+ *
+ * @param job Job to measure
+ * @param runs Number of runs
+ * @param stats Filled with min/max/average execution time
+ */
+void bench_measure(void (*job)(jobReturn_t*), uint32_t runs, bench_stats_t *stats)
+{
+    jobReturn_t result;
+    uint64_t total = 0;
+
+    stats->min_us = UINT64_MAX;
+    stats->max_us = 0;
+
+    for (uint32_t i = 0; i < runs; i++) {
+        uint32_t irq = save_and_disable_interrupts();
+        job(&result);
+        restore_interrupts(irq);
+
+        uint64_t exec = result.stop - result.start;
+        total += exec;
+        if (exec < stats->min_us) {
+            stats->min_us = exec;
+        }
+        if (exec > stats->max_us) {
+            stats->max_us = exec;
+        }
+    }
+    stats->avg_us = total / runs;
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Main function.
+ *
+ * @return int
+ */
+int main()
+{
+    BSP_Init();  /* Initialize all components on the lab-kit. */
+
+    printf("\n========================================\n");
+    printf("Benchmarks Started\n");
+    printf("========================================\n");
+
+#if RUN_INTERFERENCE_BENCH
+    interference_benchmark();
+#endif
+#if RUN_DSP_BENCH
+    dsp_benchmark();
+#endif
+
+    printf("Benchmarks done\n");
+    while (true) {
+        tight_loop_contents();  /* Idle loop */
+    }
+
+    return 0;
+}
+/*-----------------------------------------------------------*/
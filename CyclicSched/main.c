@@ -1,41 +1,95 @@
 #include <stdio.h>
+#include <string.h>
 #include "bsp.h"
+#include "hardware/timer.h"
+#include "hardware/irq.h"
+#include "hardware/sync.h"
 #include "workload.h"
+#include "let.h"
+#include "dag.h"
+#include "schedule.h"
+#include "forkjoin.h"
+#include "fuzz.h"
+#include "fault.h"
+#include "pwcet_budgets.h"
+#include "isr_load.h"
+#include "trace_budget.h"
+#include "deadline_alarm.h"
+#include "overload.h"
 
 /*************************************************************/
 
-/* Cyclic scheduler parameters */
-#define MINOR_FRAME_MS 5      /* Minor frame duration: 5ms */
-#define HYPERPERIOD_MS 100    /* Hyperperiod: 100ms */
-#define NUM_FRAMES 20         /* Number of frames in hyperperiod */
-#define MAX_TASKS_PER_FRAME 4 /* Maximum tasks in a single frame */
+/* Cyclic scheduler parameters (frame/hyperperiod sizes in schedule.h) */
 #define MAX_JOBS_PER_HYPERPERIOD 50  /* Maximum job executions per hyperperiod */
+#define USE_SYNTHESIZED_SCHEDULE 0   /* 1: replace the table below by schedule_synthesize() */
+#define ENABLE_FORK_JOIN 0           /* 1: split Task_E over both cores (occupies core 1) */
+#define TASK_E_FJ_WCET_US 2100       /* Half of Task_E plus fork/join overhead */
+#define USE_PWCET_BUDGETS 0          /* 1: table synthesis and checks use pwcet_budgets.h */
+#define ENABLE_SELF_CHECK 1          /* 1: check run-time invariants and report violations */
+#define FUZZ_INPUTS 0                /* 1: generated Task_C inputs and random task-set checks */
+#define FUZZ_SEED 1                  /* Reproduces the generated inputs */
+#define FUZZ_TABLE_ITERATIONS 1000   /* Random task sets checked at start-up */
+#define ENABLE_FRAME_RESYNC 1        /* 1: drop frames whose window passed without dispatch */
+#define ENABLE_FAULT_INJECTION 0     /* 1: inject the faults of the plan below */
+#define FAULT_PLAN_RANDOM 0          /* 1: random plan from FAULT_SEED instead of the script */
+#define FAULT_SEED 1
+#define FAULT_HORIZON_MS 30000       /* Random plan: faults spread over this time */
+#define TIME_TRIGGERED 0             /* 1: dispatch each job at its timetable start instead of by frames */
+#define TT_ALARM_LEAD_US 20          /* The alarm fires this early; the dispatch spins to the exact start */
+#define ONLINE_EDF 0                 /* 1: run released jobs in EDF order from the frame tick instead of
+                                        the table (ignored when TIME_TRIGGERED) */
+#define EDF_QUEUE_LEN 16             /* Ready queue capacity of the online EDF dispatcher */
+#define ENABLE_ISR_LOAD 1            /* 1: account time in interrupt handlers (jobs run in the timer
+                                        interrupt and are not counted) */
+#define COMPACT_SCHEDULE 0           /* 1: dispatch frames from per-task offset cycles instead of the
+                                        frame table */
+#define ENABLE_TRACE_BUDGET 1        /* 1: limit the time spent in hyperperiod reports; full reports
+                                        are sampled and summaries fill the gaps */
+#define TRACE_BUDGET_US 5000         /* Report time per hyperperiod */
+#define VARIABLE_FRAMES 0            /* 1: replace the table by one whose frames have their own lengths,
+                                        cut at job releases (ignored with COMPACT_SCHEDULE) */
+#define ENABLE_DEADLINE_ALARM 1      /* 1: detect misses at the deadline with a timer alarm that
+                                        preempts the late job, instead of at its completion */
+#define DEADLINE_RECOVERY recovery_signal  /* Run by the alarm for a late job, NULL for none */
+#define ENABLE_OVERLOAD_WARNING 1    /* 1: predict misses from a sliding window of measured execution
+                                        times and warn before they happen */
+#define OVERLOAD_WINDOW_JOBS 16      /* Jobs per task in the window */
+#define OVERLOAD_HEADROOM_US 500     /* Warn when the predicted headroom drops below this */
 
-/* Task function pointer type */
-typedef void (*task_func_t)(jobReturn_t*);
+/* Non-uniform frames need the frame table */
+#if VARIABLE_FRAMES && !COMPACT_SCHEDULE
+#define NON_UNIFORM_FRAMES 1
+#else
+#define NON_UNIFORM_FRAMES 0
+#endif
 
-/* Frame schedule structure - defines which tasks run in each frame */
-typedef struct {
-    task_func_t tasks[MAX_TASKS_PER_FRAME];  /* Task functions to execute */
-    const char* names[MAX_TASKS_PER_FRAME];   /* Task names for logging */
-    uint8_t num_tasks;                         /* Number of tasks in this frame */
-} frame_schedule_t;
+/* Execution time budget of a task: measured pWCET or nominal */
+#if USE_PWCET_BUDGETS
+#define TASK_BUDGET_US(task, nominal_us) PWCET_BUDGET_US_##task
+#else
+#define TASK_BUDGET_US(task, nominal_us) (nominal_us)
+#endif
 
 /* Job execution record */
 typedef struct {
     uint32_t frame;          /* Frame number */
     const char* task_name;   /* Task name */
-    uint64_t release_time;   /* Release time (frame start) */
+    uint64_t release_time;   /* Release time (frame start, or planned start when time-triggered) */
     uint64_t start_time;     /* Actual execution start time */
     uint64_t completion_time; /* Completion time */
     uint64_t exec_time;      /* Execution time */
     uint64_t deadline;       /* Absolute deadline for this job */
     bool deadline_missed;    /* Flag indicating if deadline was missed */
+    bool alarmed;            /* Miss already counted by the deadline alarm */
 } job_record_t;
 
 /* Global variables */
 static uint32_t current_frame = 0;
+static uint32_t num_frames = NUM_FRAMES;           /* Frames per hyperperiod */
+static uint32_t frame_starts_us[NUM_FRAMES + 1];   /* Frame starts in the hyperperiod (frame table) */
+static uint64_t hyperperiod_us = (uint64_t)HYPERPERIOD_MS * 1000;  /* Length of the dispatched hyperperiod */
 static repeating_timer_t frame_timer;
+static uint64_t frame_timer_target = 0;    /* Time the frame timer was set to fire the running callback */
 static job_record_t job_log[MAX_JOBS_PER_HYPERPERIOD];
 static uint32_t job_count = 0;
 static uint32_t hyperperiod_count = 0;
@@ -45,15 +99,183 @@ static uint64_t scheduler_start_time = 0;  /* Absolute start time of scheduler *
 static uint32_t deadline_misses_current = 0;  /* Misses in current hyperperiod */
 static uint32_t deadline_misses_total = 0;    /* Total misses since start */
 
+/* Misses detected by the deadline alarm in the last hyperperiod, already in
+ * the counters above; jobs that never completed appear only here */
+static deadline_miss_t alarm_log[DEADLINE_ALARM_QUEUE_LEN];
+static uint32_t alarm_count = 0;
+static uint32_t alarm_lost_seen = 0;  /* Records lost to a full queue, already seen by the check */
+
+/* Run-time invariant violations (ENABLE_SELF_CHECK) */
+static invariants_t invariants;
+static uint32_t frames_dropped = 0;  /* Frames dropped by the resync */
+
+/* Start time of each job relative to its periodic release. Its spread is
+ * the start-time jitter of the task. */
+typedef struct {
+    uint32_t jobs;           /* Table jobs dispatched this hyperperiod, gives their release */
+    uint32_t samples;        /* Starts accounted this hyperperiod */
+    uint32_t offset_min_us;  /* This hyperperiod */
+    uint32_t offset_max_us;
+    uint32_t jitter_last_us; /* Last completed hyperperiod */
+    uint32_t jitter_max_us;
+} start_stats_t;
+
+static uint64_t hyperperiod_start = 0;  /* Absolute start of the current hyperperiod */
+
+/* Interrupt load of the last hyperperiod (ENABLE_ISR_LOAD) and the largest
+ * frame budget it competes with */
+static isr_load_t isr_load;
+static uint32_t frame_budget_max_us = 0;
+static uint32_t frame_budget_len_us = MINOR_FRAME_MS * 1000;  /* Length of that frame */
+
+/* One job to dispatch, in absolute time */
+typedef struct {
+    uint8_t task;               /* Task index */
+    uint32_t frame;             /* Frame logged with the job */
+    uint64_t release;           /* Logged release: frame start, planned start or EDF release */
+    uint64_t periodic_release;  /* k * period: reference of the start jitter */
+    uint64_t deadline;
+    uint64_t admit_until;       /* Task_C only runs if it can complete by this time */
+} dispatch_t;
+
+/* Online EDF dispatch (ONLINE_EDF): released jobs sorted by deadline */
+typedef struct {
+    uint8_t task;
+    uint64_t release;
+    uint64_t deadline;
+} edf_job_t;
+
+/* Task set. Indices are used by the precedence edges and chains. */
+enum { TASK_B, TASK_A, TASK_F, TASK_C, TASK_D, TASK_E, NUM_TASKS };
+
+static const task_desc_t tasks[NUM_TASKS] = {
+    [TASK_B] = { .task = job_B, .name = "Task_B", .period_ms = 5,  .deadline_ms = 5,
+                 .wcet_us = TASK_BUDGET_US(TASK_B, 1000) },
+    [TASK_A] = { .task = job_A, .name = "Task_A", .period_ms = 10, .deadline_ms = 10,
+                 .wcet_us = TASK_BUDGET_US(TASK_A, 1000) },
+    [TASK_F] = { .task = job_F, .name = "Task_F", .period_ms = 20, .deadline_ms = 20,
+                 .wcet_us = TASK_BUDGET_US(TASK_F, 2000) },
+    [TASK_C] = { .task = job_C, .name = "Task_C", .period_ms = 25, .deadline_ms = 25,
+                 .wcet_us = TASK_BUDGET_US(TASK_C, 2000) },
+    [TASK_D] = { .task = job_D, .name = "Task_D", .period_ms = 50, .deadline_ms = 50,
+                 .wcet_us = TASK_BUDGET_US(TASK_D, 2000) },
+    [TASK_E] = { .task = job_E, .name = "Task_E", .period_ms = 50, .deadline_ms = 50,
+                 .wcet_us = TASK_BUDGET_US(TASK_E, ENABLE_FORK_JOIN ? TASK_E_FJ_WCET_US : 4000) },
+};
+
+static start_stats_t start_stats[NUM_TASKS];
+
+static edf_job_t edf_queue[EDF_QUEUE_LEN];
+static uint32_t edf_queue_len = 0;
+static uint32_t edf_released[NUM_TASKS];   /* Jobs released since start */
+static uint32_t edf_completed[NUM_TASKS];  /* Jobs completed or skipped since start */
+static uint32_t edf_overflows = 0;         /* Releases lost to a full ready queue */
+
+/* Precedence: the sensor (B) feeds the filter (A) which feeds the actuator (F) */
+#define NUM_EDGES 2
+static const dag_edge_t precedence[NUM_EDGES] = {
+    { .pred = TASK_B, .succ = TASK_A },
+    { .pred = TASK_A, .succ = TASK_F },
+};
+
+static const task_set_t task_set = {
+    .tasks = tasks, .num_tasks = NUM_TASKS, .edges = precedence, .num_edges = NUM_EDGES
+};
+
+/* Cause-effect chains analyzed at start-up and measured at run-time */
+#define NUM_CHAINS 1
+static const dag_chain_t chains[NUM_CHAINS] = {
+    { .name = "B->A->F", .length = 3, .tasks = {TASK_B, TASK_A, TASK_F} },
+};
+static dag_chain_bound_t chain_bounds[NUM_CHAINS];
+
+/* LET dataflow along the chain. Inputs are sampled at the job's logical
+ * release and outputs published at its logical deadline, so the data a job
+ * sees does not depend on the frame it was placed in. */
+typedef struct {
+    const task_desc_t *desc; /* Task bound to the channels */
+    let_channel_t *input;    /* Channel sampled at release (NULL for sensor) */
+    let_channel_t *output;   /* Channel published at deadline (NULL for actuator) */
+    uint32_t seq;            /* Job counter of the task */
+    uint64_t last_age;       /* Age of the data used by the last job (us) */
+    uint64_t max_age;        /* Maximum data age observed (us) */
+} let_binding_t;
+
+static let_token_t sensor_storage[LET_NUM_BUFFERS];
+static let_token_t filter_storage[LET_NUM_BUFFERS];
+static let_channel_t sensor_channel;
+static let_channel_t filter_channel;
+
+#define NUM_LET_BINDINGS 3
+static let_binding_t let_bindings[NUM_LET_BINDINGS] = {
+    { .desc = &tasks[TASK_B], .input = NULL,            .output = &sensor_channel },
+    { .desc = &tasks[TASK_A], .input = &sensor_channel, .output = &filter_channel },
+    { .desc = &tasks[TASK_F], .input = &filter_channel, .output = NULL },
+};
+
+/* Measured end-to-end data age of the chain: actuator output - sensor release */
+static uint64_t chain_age_last = 0;
+static uint64_t chain_age_max = 0;
+
+/* Fork-join execution of Task_E: segment 0 on core 0, segment 1 on core 1 */
+static fj_job_t task_E_fj = { .func = job_E_segment, .num_segments = FJ_MAX_SEGMENTS };
+static fj_stats_t task_E_fj_stats;
+static uint64_t task_E_fj_span_max = 0;
+
+/* Time-triggered mode (TIME_TRIGGERED): jobs sorted by start time within the
+ * hyperperiod. The report is printed from the main loop, from a copy of the
+ * log, so that printing does not delay the dispatches. */
+static timetable_entry_t timetable[MAX_TIMETABLE_ENTRIES];
+static uint32_t timetable_len = 0;
+static uint32_t tt_next = 0;                 /* Next entry to dispatch */
+static unsigned int tt_alarm;
+static uint32_t tt_dispatch_error = 0;       /* Dispatch - planned start, this hyperperiod (us) */
+static uint32_t tt_dispatch_error_last = 0;  /* Last completed hyperperiod */
+static uint32_t tt_dispatch_error_max = 0;
+static job_record_t report_log[MAX_JOBS_PER_HYPERPERIOD];
+static uint32_t report_count = 0;
+static uint32_t report_misses = 0;
+static uint32_t report_hyperperiod = 0;
+static bool report_detail = false;
+static volatile bool report_pending = false;
+static uint32_t reports_dropped = 0;         /* Hyperperiods ended while the previous report printed */
+
+/* Compact schedule (COMPACT_SCHEDULE): the frame table compressed to one
+ * offset cycle per task, decoded at each frame. Its major cycle of minor
+ * frames replaces the table's hyperperiod for releases, logs and reports. */
+static compact_schedule_t compact;
+
+/* Report time budget (ENABLE_TRACE_BUDGET) */
+static trace_budget_t trace_budget;
+static uint32_t frames_dropped_reported = 0;  /* Resync drops already seen by a report */
+
+/* Overload prediction (ENABLE_OVERLOAD_WARNING): table modes predict each
+ * frame at its start, online EDF and time-triggered each hyperperiod */
+static overload_t overload;
+static uint32_t overload_warnings_reported = 0;  /* Warnings already seen by a report */
+static bool overload_event = false;              /* Warning raised since the previous report */
+static rta_irq_t overload_irqs[ISR_LOAD_MAX_SOURCES];  /* Interrupt model of the last hyperperiod */
+static uint8_t overload_num_irqs = 0;
+
+/* Fault plan (ENABLE_FAULT_INJECTION), times relative to the scheduler start */
+static fault_event_t fault_plan[FAULT_MAX_EVENTS] = {
+    { .at_ms = 1000, .kind = FAULT_OVERRUN,       .task = TASK_A,         .param = 3000 },
+    { .at_ms = 2000, .kind = FAULT_LATE_TIMER,    .task = FAULT_ANY_TASK, .param = 2000 },
+    { .at_ms = 3000, .kind = FAULT_LOST_TICK,     .task = FAULT_ANY_TASK },
+    { .at_ms = 4000, .kind = FAULT_SWITCH_STUCK,  .task = FAULT_ANY_TASK, .param = 255, .duration_ms = 100 },
+    { .at_ms = 5000, .kind = FAULT_SWITCH_BOUNCE, .task = FAULT_ANY_TASK, .param = 0x0F, .duration_ms = 100 },
+};
+#define FAULT_PLAN_SCRIPTED_EVENTS 5
+
 /* Static schedule table for the hyperperiod (20 frames)
  * Custom cyclic schedule pattern:
- * BAD, BF, BA, BC, BAF, BC, BA, BE, BAF, B, BAD, BC, BAF, BD, BA, BC, BAF, BE, BA, B
+ * BAD, BF, BA, BC, BAF, BC, BA, BE, BAF, B, BAD, BC, BAF, B, BA, BC, BAF, BE, BA, B
  *
  * Execution pattern per hyperperiod:
  *   A: frames 0,2,4,6,8,10,12,14,16,18 (10 times)
  *   B: frames 0-19 (20 times, every frame) - ALWAYS FIRST
  *   C: frames 3,5,11,15 (4 times)
- *   D: frames 0,10,13 (3 times)
+ *   D: frames 0,10 (2 times)
  *   E: frames 7,17 (2 times)
  *   F: frames 1,4,8,12,16 (5 times)
  */
@@ -84,8 +306,8 @@ static frame_schedule_t schedule[NUM_FRAMES] = {
     { .tasks = {job_B, job_C}, .names = {"Task_B", "Task_C"}, .num_tasks = 2 },
     /* Frame 12 (60ms): B, A, F | Load: 1+1+2=4ms */
     { .tasks = {job_B, job_A, job_F}, .names = {"Task_B", "Task_A", "Task_F"}, .num_tasks = 3 },
-    /* Frame 13 (65ms): B, D | Load: 1+2=3ms */
-    { .tasks = {job_B, job_D}, .names = {"Task_B", "Task_D"}, .num_tasks = 2 },
+    /* Frame 13 (65ms): B | Load: 1ms (Task_D's second job ran in frame 10) */
+    { .tasks = {job_B}, .names = {"Task_B"}, .num_tasks = 1 },
     /* Frame 14 (70ms): B, A | Load: 1+1=2ms */
     { .tasks = {job_B, job_A}, .names = {"Task_B", "Task_A"}, .num_tasks = 2 },
     /* Frame 15 (75ms): B, C | Load: 1+C (C is variable via GPIO) */
@@ -101,47 +323,761 @@ static frame_schedule_t schedule[NUM_FRAMES] = {
 };
 
 
+/**
+ * @brief Find the LET binding of a task
+ *
+ * @param task Task function
+ * @return Binding, or NULL if the task does not take part in the dataflow
+ */
+static let_binding_t *let_find_binding(task_func_t task) {
+    for (uint32_t i = 0; i < NUM_LET_BINDINGS; i++) {
+        if (let_bindings[i].desc->task == task) {
+            return &let_bindings[i];
+        }
+    }
+    return NULL;
+}
+
 /**
  * @brief Print all job executions from the last hyperperiod
+ *
+ * @param log Jobs of the hyperperiod, count entries
+ * @param misses Deadline misses of the hyperperiod
  */
-void print_hyperperiod_report(void) {
-    printf("\n========== Hyperperiod %u Report ==========\n", hyperperiod_count);
+void print_hyperperiod_report(const job_record_t *log, uint32_t count, uint32_t hyperperiod, uint32_t misses) {
+    printf("\n========== Hyperperiod %u Report ==========\n", hyperperiod);
     printf("Frame | Task   | Release    | Start      | Complete   | Deadline   | Exec Time | Status\n");
     printf("------+--------+------------+------------+------------+------------+-----------+---------\n");
 
-    for (uint32_t i = 0; i < job_count; i++) {
+    for (uint32_t i = 0; i < count; i++) {
         const char* status;
-        if (job_log[i].exec_time == 0 && job_log[i].deadline_missed) {
+        if (log[i].exec_time == 0 && log[i].deadline_missed) {
             status = " SKIPPED";
-        } else if (job_log[i].deadline_missed) {
+        } else if (log[i].deadline_missed) {
             status = "  MISS  ";
         } else {
             status = "   OK   ";
         }
 
         printf(" %2u   | %-6s | %10llu | %10llu | %10llu | %10llu | %6llu us | %s\n",
-               job_log[i].frame,
-               job_log[i].task_name,
-               job_log[i].release_time,
-               job_log[i].start_time,
-               job_log[i].completion_time,
-               job_log[i].deadline,
-               job_log[i].exec_time,
+               log[i].frame,
+               log[i].task_name,
+               log[i].release_time,
+               log[i].start_time,
+               log[i].completion_time,
+               log[i].deadline,
+               log[i].exec_time,
                status);
     }
 
     printf("========================================================================================\n");
-    printf("Total jobs scheduled: %u\n", job_count);
-    printf("Deadline misses (this hyperperiod): %u\n", deadline_misses_current);
+    printf("Total jobs scheduled: %u\n", count);
+    printf("Deadline misses (this hyperperiod): %u\n", misses);
     printf("Deadline misses (total): %u\n", deadline_misses_total);
+    if (ENABLE_DEADLINE_ALARM) {
+        deadline_alarm_print();
+        for (uint32_t i = 0; i < alarm_count; i++) {
+            printf("  Missed at deadline: %s, deadline %llu us, detected %u us late\n",
+                   tasks[alarm_log[i].job].name, alarm_log[i].deadline_us, alarm_log[i].latency_us);
+        }
+    }
+    if (ENABLE_OVERLOAD_WARNING) {
+        overload_print(&overload);
+    }
+    for (uint32_t i = 0; i < NUM_LET_BINDINGS; i++) {
+        if (let_bindings[i].input != NULL) {
+            printf("LET data age %s: last %llu us, max %llu us\n",
+                   let_bindings[i].desc->name, let_bindings[i].last_age, let_bindings[i].max_age);
+        }
+    }
+
+    printf("Start jitter (%s, last/max):",
+           TIME_TRIGGERED ? "time-triggered" : (ONLINE_EDF ? "online EDF" : "frame-based"));
+    for (int i = 0; i < NUM_TASKS; i++) {
+        printf(" %s %u/%u us", tasks[i].name, start_stats[i].jitter_last_us, start_stats[i].jitter_max_us);
+    }
+    printf("\n");
+    if (TIME_TRIGGERED) {
+        printf("Dispatch error vs timetable: last %u us, max %u us\n",
+               tt_dispatch_error_last, tt_dispatch_error_max);
+    }
+    if (frames_dropped > 0) {
+        printf("Frames dropped by resync (total): %u\n", frames_dropped);
+    }
+    if (reports_dropped > 0) {
+        printf("Reports dropped while printing (total): %u\n", reports_dropped);
+    }
+    if (ONLINE_EDF && !TIME_TRIGGERED) {
+        printf("EDF ready queue: %u job(s) pending, %u release(s) lost to overflow\n",
+               edf_queue_len, edf_overflows);
+    }
+    if (ENABLE_ISR_LOAD) {
+        rta_irq_t irqs[ISR_LOAD_MAX_SOURCES];
+        uint8_t num_irqs = isr_load_model(&isr_load, irqs, ISR_LOAD_MAX_SOURCES);
+        isr_load_print(&isr_load);
+        printf("Interrupt interference per frame: %llu us, largest frame budget %u us of %u us\n",
+               rta_irq_interference(irqs, num_irqs, MINOR_FRAME_MS * 1000),
+               frame_budget_max_us, frame_budget_len_us);
+    }
+    if (ENABLE_SELF_CHECK) {
+        fuzz_print_invariants(&invariants);
+    }
+    if (ENABLE_FAULT_INJECTION) {
+        fault_print_log(time_us_64());
+    }
+    if (ENABLE_TRACE_BUDGET) {
+        trace_budget_print(&trace_budget);
+    }
 
-    if (deadline_misses_current > 0) {
+    if (overload_event) {
+        printf("\n*** EARLY WARNING: overload predicted at %llu us, headroom %ld us ***\n",
+               overload.warning_us, (long)overload.warning_headroom_us);
+    }
+    if (misses > 0) {
         printf("\n*** WARNING: Deadline misses detected! ***\n");
         printf("Response Strategy: SKIP TASK_C IF INSUFFICIENT TIME BEFORE EXECUTION\n");
     }
     printf("\n");
 }
 
+/**
+ * @brief One-line report of a hyperperiod whose full report is not printed;
+ *        it opens with the report header so the analyzer counts it
+ */
+static void print_hyperperiod_summary(uint32_t count, uint32_t hyperperiod, uint32_t misses) {
+    printf("\n========== Hyperperiod %u Summary: %u jobs, %u miss(es), %u total; trace last %u us, "
+           "credit %lld us, detail dropped %u\n", hyperperiod, count, misses, deadline_misses_total,
+           trace_budget.last_cost_us, trace_budget.credit_us, trace_budget.detail_dropped);
+}
+
+/**
+ * @brief Print the report of a hyperperiod, full or summary, and charge
+ *        its time to the report budget
+ */
+static void print_budgeted_report(const job_record_t *log, uint32_t count, uint32_t hyperperiod,
+                                  uint32_t misses, bool detail) {
+    uint64_t start = time_us_64();
+
+    if (detail) {
+        print_hyperperiod_report(log, count, hyperperiod, misses);
+    } else {
+        print_hyperperiod_summary(count, hyperperiod, misses);
+    }
+    if (ENABLE_TRACE_BUDGET) {
+        trace_budget_charge(&trace_budget, detail, (uint32_t)(time_us_64() - start));
+    }
+}
+
+/**
+ * @brief Check that the miss counter agrees with the logged jobs and the
+ *        misses posted by the deadline alarm, and that every job released
+ *        in the hyperperiod was logged, run or skipped
+ *
+ * Only possible while the log holds every job of the hyperperiod. Online
+ * EDF may run a job in the hyperperiod after its release, so its job count
+ * is not checked.
+ */
+static void self_check_hyperperiod(uint32_t misses) {
+    uint32_t logged_misses = alarm_count;
+    uint32_t released = 0;
+    bool records_lost = false;
+
+    if (ENABLE_DEADLINE_ALARM) {
+        deadline_alarm_stats_t alarm_stats;
+        deadline_alarm_get_stats(&alarm_stats);
+        records_lost = alarm_stats.lost != alarm_lost_seen;
+        alarm_lost_seen = alarm_stats.lost;
+    }
+    if (job_count >= MAX_JOBS_PER_HYPERPERIOD || records_lost) {
+        return;
+    }
+    for (uint32_t i = 0; i < job_count; i++) {
+        logged_misses += job_log[i].deadline_missed && !job_log[i].alarmed;
+    }
+    if (logged_misses != misses) {
+        invariants.miss_mismatches++;
+    }
+
+    for (int t = 0; t < NUM_TASKS; t++) {
+        released += (uint32_t)(hyperperiod_us / ((uint64_t)tasks[t].period_ms * 1000));
+    }
+    if ((!ONLINE_EDF || TIME_TRIGGERED) && job_count != released) {
+        invariants.job_count_mismatches++;
+    }
+}
+
+/**
+ * @brief Index of a task in the task set from its workload function
+ */
+static uint8_t task_index_of(task_func_t task) {
+    uint8_t t = 0;
+    while (t < NUM_TASKS && tasks[t].task != task) {
+        t++;
+    }
+    return t;
+}
+
+/**
+ * @brief Execution time of Task_C at the current switch setting
+ */
+static uint32_t task_c_exec_us(void) {
+    /* Note: actual execution is this - 10us, but we add margin */
+    return job_C_exec_us(workload_switch_value());
+}
+
+/**
+ * @brief Start of a frame relative to the scheduler start, in microseconds
+ *
+ * @param frame Frame number since start
+ */
+static uint64_t frame_offset_us(uint32_t frame) {
+    if (COMPACT_SCHEDULE) {
+        return (uint64_t)frame * MINOR_FRAME_MS * 1000;
+    }
+    return (uint64_t)(frame / num_frames) * hyperperiod_us + frame_starts_us[frame % num_frames];
+}
+
+/**
+ * @brief Tasks of a frame in dispatch order, from the frame table or the
+ *        compact schedule
+ *
+ * @param jobs Filled with task indices, MAX_TASKS_PER_FRAME entries
+ * @return Number of tasks
+ */
+static uint8_t frame_jobs(uint32_t local_frame, uint8_t *jobs) {
+    uint8_t n = 0;
+
+    if (COMPACT_SCHEDULE) {
+        uint32_t mask = schedule_compact_frame(&compact, local_frame);
+        for (uint8_t i = 0; i < compact.num_tasks && n < MAX_TASKS_PER_FRAME; i++) {
+            if (mask & (1u << compact.order[i])) {
+                jobs[n++] = compact.order[i];
+            }
+        }
+    } else {
+        for (; n < schedule[local_frame].num_tasks; n++) {
+            jobs[n] = task_index_of(schedule[local_frame].tasks[n]);
+        }
+    }
+    return n;
+}
+
+/**
+ * @brief Count a deadline miss
+ *
+ * Interrupts are off so that a miss counted by the alarm interrupt at the
+ * same time is not lost.
+ */
+static void count_miss(void) {
+    uint32_t save = save_and_disable_interrupts();
+    deadline_misses_current++;
+    deadline_misses_total++;
+    restore_interrupts(save);
+}
+
+/**
+ * @brief Log a job as skipped and count it as a deadline miss
+ */
+static void log_skipped_job(uint32_t frame, uint8_t t, uint64_t release, uint64_t deadline) {
+    /* A dispatched job whose alarm fired was already counted and signalled */
+    bool alarmed = ENABLE_DEADLINE_ALARM && deadline_alarm_disarm(t, NULL);
+
+    if (job_count < MAX_JOBS_PER_HYPERPERIOD) {
+        job_log[job_count].frame = frame;
+        job_log[job_count].task_name = tasks[t].name;
+        job_log[job_count].release_time = release;
+        job_log[job_count].start_time = 0;
+        job_log[job_count].completion_time = 0;
+        job_log[job_count].exec_time = 0;
+        job_log[job_count].deadline = deadline;
+        job_log[job_count].deadline_missed = true;
+        job_log[job_count].alarmed = alarmed;
+        job_count++;
+    } else {
+        invariants.dropped_logs++;
+    }
+
+    /* Count the miss, with LED indication */
+    if (!alarmed) {
+        count_miss();
+        BSP_ToggleLED(LED_RED);
+    }
+}
+
+/**
+ * @brief Recovery action: signal the miss on the red LED
+ */
+static void recovery_signal(uint8_t t, uint64_t deadline_us, uint64_t now_us) {
+    BSP_ToggleLED(LED_RED);
+}
+
+static const deadline_handler_t deadline_recovery = DEADLINE_RECOVERY;
+
+/**
+ * @brief Deadline alarm handler: a job is still pending at its deadline
+ *
+ * Runs in the alarm interrupt, above the frame timer, so it preempts the
+ * late job. The miss is counted here, its record was posted by the alarm
+ * for the report, and the configured recovery starts. The job's own log
+ * entry, if it completes, does not count it again.
+ */
+static void deadline_missed(uint8_t t, uint64_t deadline_us, uint64_t now_us) {
+    count_miss();
+    if (deadline_recovery != NULL) {
+        deadline_recovery(t, deadline_us, now_us);
+    }
+}
+
+/**
+ * @brief Periodic release of a task's next job in the frame table
+ *
+ * @return Release, UINT64_MAX for jobs beyond the task's count (table error)
+ */
+static uint64_t table_release(uint8_t t) {
+    start_stats_t *stats = &start_stats[t];
+
+    if (stats->jobs >= hyperperiod_us / ((uint64_t)tasks[t].period_ms * 1000)) {
+        return UINT64_MAX;
+    }
+    return hyperperiod_start + ((uint64_t)stats->jobs++ * tasks[t].period_ms * 1000);
+}
+
+/**
+ * @brief Account the start of a job against its periodic release
+ */
+static void record_start(uint8_t t, uint64_t periodic_release, uint64_t start) {
+    start_stats_t *stats = &start_stats[t];
+
+    if (start < periodic_release) {
+        return;
+    }
+
+    uint32_t offset = (uint32_t)(start - periodic_release);
+    if (stats->samples == 0 || offset < stats->offset_min_us) {
+        stats->offset_min_us = offset;
+    }
+    if (stats->samples == 0 || offset > stats->offset_max_us) {
+        stats->offset_max_us = offset;
+    }
+    stats->samples++;
+}
+
+/**
+ * @brief Close the start statistics of a hyperperiod
+ */
+static void close_start_stats(void) {
+    for (int i = 0; i < NUM_TASKS; i++) {
+        start_stats_t *stats = &start_stats[i];
+        stats->jitter_last_us = stats->offset_max_us - stats->offset_min_us;
+        if (stats->jitter_last_us > stats->jitter_max_us) {
+            stats->jitter_max_us = stats->jitter_last_us;
+        }
+        stats->jobs = 0;
+        stats->samples = 0;
+        stats->offset_min_us = 0;
+        stats->offset_max_us = 0;
+    }
+}
+
+/**
+ * @brief Predict the headroom of a window from the demand estimates and
+ *        update the early warning
+ *
+ * Every job of the window runs at its task's estimate, Task_C at the
+ * current switch setting, and the interrupts take the interference of the
+ * last hyperperiod's model.
+ *
+ * @param task_jobs Jobs of each task in the window
+ * @param window_us Time the window leaves for them
+ */
+static void predict_overload(const uint32_t *task_jobs, uint64_t window_us, uint64_t now) {
+    int64_t headroom = (int64_t)window_us -
+                       (int64_t)rta_irq_interference(overload_irqs, overload_num_irqs, window_us);
+
+    if (task_jobs[TASK_C] > 0) {
+        overload_forecast(&overload, TASK_C, task_c_exec_us());
+    }
+    for (uint8_t t = 0; t < NUM_TASKS; t++) {
+        headroom -= (int64_t)task_jobs[t] * overload_demand_us(&overload, t);
+    }
+    if (headroom < INT32_MIN) {
+        headroom = INT32_MIN;
+    }
+    overload_predict(&overload, (headroom > INT32_MAX) ? INT32_MAX : (int32_t)headroom, now);
+}
+
+/**
+ * @brief Predict the next hyperperiod: its total demand against its length
+ *
+ * Used where jobs are not bound to frames (online EDF, time-triggered).
+ */
+static void predict_hyperperiod(uint64_t now) {
+    uint32_t task_jobs[NUM_TASKS];
+
+    for (uint8_t t = 0; t < NUM_TASKS; t++) {
+        task_jobs[t] = (uint32_t)(hyperperiod_us / ((uint64_t)tasks[t].period_ms * 1000));
+    }
+    predict_overload(task_jobs, hyperperiod_us, now);
+}
+
+/**
+ * @brief End of a hyperperiod: check, report and reset the log
+ */
+static void end_hyperperiod(void) {
+    BSP_ToggleLED(LED_GREEN);
+
+    /* Close the miss count and take the alarm's records together, so a miss
+     * detected meanwhile goes to the next hyperperiod in both */
+    uint32_t save = save_and_disable_interrupts();
+    uint32_t misses = deadline_misses_current;
+    deadline_misses_current = 0;
+    alarm_count = 0;
+    while (alarm_count < DEADLINE_ALARM_QUEUE_LEN && ENABLE_DEADLINE_ALARM &&
+           deadline_alarm_take_miss(&alarm_log[alarm_count])) {
+        alarm_count++;
+    }
+    restore_interrupts(save);
+
+    if (ENABLE_SELF_CHECK) {
+        self_check_hyperperiod(misses);
+    }
+    close_start_stats();
+    if (ENABLE_ISR_LOAD) {
+        isr_load_sample(&isr_load);
+        if (ENABLE_OVERLOAD_WARNING) {
+            overload_num_irqs = isr_load_model(&isr_load, overload_irqs, ISR_LOAD_MAX_SOURCES);
+        }
+    }
+    if (ENABLE_OVERLOAD_WARNING && (ONLINE_EDF || TIME_TRIGGERED)) {
+        predict_hyperperiod(time_us_64());
+    }
+    overload_event = overload.warnings != overload_warnings_reported;
+    overload_warnings_reported = overload.warnings;
+
+    /* Misses (skipped jobs included), dropped frames and overload warnings
+     * always get a full report */
+    bool detail = true;
+    if (ENABLE_TRACE_BUDGET) {
+        detail = trace_budget_detail(&trace_budget, misses > 0 ||
+                                                    frames_dropped != frames_dropped_reported ||
+                                                    overload_event);
+        frames_dropped_reported = frames_dropped;
+    }
+
+    if (TIME_TRIGGERED) {
+        tt_dispatch_error_last = tt_dispatch_error;
+        tt_dispatch_error = 0;
+
+        /* Printed by the main loop; a report still being printed is not
+         * overwritten, this one is dropped and counted instead */
+        if (report_pending) {
+            reports_dropped++;
+        } else {
+            memcpy(report_log, job_log, job_count * sizeof(job_record_t));
+            report_count = job_count;
+            report_misses = misses;
+            report_hyperperiod = hyperperiod_count;
+            report_detail = detail;
+            report_pending = true;
+        }
+    } else {
+        /* Print report for completed hyperperiod (inside the timer interrupt,
+         * not charged to it) */
+        isr_load_pause();
+        print_budgeted_report(job_log, job_count, hyperperiod_count, misses, detail);
+        isr_load_resume();
+    }
+
+    /* Reset for next hyperperiod */
+    job_count = 0;
+    hyperperiod_count++;
+    hyperperiod_start += hyperperiod_us;
+}
+
+/**
+ * @brief Advance to the next frame; reports at the end of a hyperperiod
+ */
+static void end_frame(void) {
+    /* Move to next frame */
+    current_frame++;
+
+    /* Check if hyperperiod completed */
+    if (current_frame % num_frames == 0) {
+        end_hyperperiod();
+    }
+}
+
+/**
+ * @brief Drop the current frame, whose window passed without dispatch
+ *
+ * Its jobs are logged as skipped and their LET job counters advance, so
+ * the following jobs keep their logical release times.
+ */
+static void drop_frame(uint64_t now) {
+    uint32_t local_frame = current_frame % num_frames;
+    uint64_t frame_start = scheduler_start_time + frame_offset_us(current_frame);
+    uint64_t frame_end = scheduler_start_time + frame_offset_us(current_frame + 1);
+
+    uint8_t jobs[MAX_TASKS_PER_FRAME];
+    uint8_t num_jobs = ONLINE_EDF ? 0 : frame_jobs(local_frame, jobs);
+
+    /* Online EDF: the jobs stay queued and are dropped once their deadline passed */
+    for (uint8_t i = 0; i < num_jobs; i++) {
+        uint8_t t = jobs[i];
+        let_binding_t *binding = let_find_binding(tasks[t].task);
+        if (binding != NULL) {
+            binding->seq++;
+        }
+        table_release(t);
+        log_skipped_job(local_frame, t, frame_start, frame_end);
+    }
+
+    frames_dropped++;
+    if (ENABLE_SELF_CHECK) {
+        invariants.stalls++;
+    }
+    if (ENABLE_FAULT_INJECTION) {
+        fault_detected(FAULT_DETECT_STALL, now);
+    }
+    end_frame();
+}
+
+/**
+ * @brief Execute one job and log it
+ */
+static void run_job(const dispatch_t *job) {
+    uint8_t t = job->task;
+    uint32_t frame = job->frame;
+    uint64_t release = job->release;
+    uint64_t deadline = job->deadline;
+    task_func_t task = tasks[t].task;
+    jobReturn_t result;
+    uint32_t fault_param;
+
+    /* Special handling for Task_C: check if there's enough time before executing */
+    if (task == job_C) {
+        /* Read the switches to get actual execution time for Task_C */
+        uint32_t task_c_wcet_us = task_c_exec_us();
+
+        /* Check if there's enough time to complete Task_C */
+        uint64_t current_time = time_us_64();
+        int64_t time_remaining = (int64_t)job->admit_until - (int64_t)current_time;
+
+        if (time_remaining < (int64_t)task_c_wcet_us) {
+            /* Not enough time - skip Task_C */
+            log_skipped_job(frame, t, release, deadline);
+            if (ENABLE_FAULT_INJECTION) {
+                fault_detected(FAULT_DETECT_SKIP, current_time);
+            }
+
+            /* Note: Skip printf here to avoid blocking the scheduler */
+
+            return;
+        }
+    }
+
+    /* Sample LET inputs at the job's logical release */
+    let_binding_t *binding = let_find_binding(task);
+    const let_token_t *input = NULL;
+    uint64_t let_release = 0;
+    uint64_t let_deadline = 0;
+    if (binding != NULL) {
+        let_release = scheduler_start_time +
+                      ((uint64_t)binding->seq * binding->desc->period_ms * 1000);
+        let_deadline = let_release + (binding->desc->deadline_ms * 1000);
+        input = let_token_sample(binding->input, let_release);
+    }
+
+    /* Execute the task (Task_E forks its second half to core 1). The job
+     * runs in interrupt context but is not interrupt load. */
+    isr_load_pause();
+    if (ENABLE_FORK_JOIN && task == job_E) {
+        fj_run(&task_E_fj, &result);
+        fj_stats(&task_E_fj, &task_E_fj_stats);
+        if (task_E_fj_stats.span_us > task_E_fj_span_max) {
+            task_E_fj_span_max = task_E_fj_stats.span_us;
+        }
+    } else {
+        task(&result);
+    }
+    record_start(t, job->periodic_release, result.start);
+
+    /* Injected overrun: the job runs longer than its workload */
+    if (ENABLE_FAULT_INJECTION && fault_pending(FAULT_OVERRUN, t, result.stop, &fault_param)) {
+        BSP_WaitClkCycles(fault_param * CYCLES_PER_US);
+        result.stop = time_us_64();
+    }
+    isr_load_resume();
+
+    /* A job that returns after its alarm fired missed its deadline, even
+     * if its own stop time raced the alarm */
+    uint64_t detected_at = result.stop;
+    bool alarmed = ENABLE_DEADLINE_ALARM && deadline_alarm_disarm(t, &detected_at);
+    bool missed = alarmed || (result.stop > deadline);
+
+    if (ENABLE_OVERLOAD_WARNING) {
+        overload_record(&overload, t, (uint32_t)(result.stop - result.start));
+    }
+
+    /* Publish LET outputs, visible from the job's logical deadline */
+    if (binding != NULL) {
+        if (input != NULL && input->origin_us != 0) {
+            binding->last_age = let_release - input->origin_us;
+            if (binding->last_age > binding->max_age) {
+                binding->max_age = binding->last_age;
+            }
+            if (binding->output == NULL) {
+                chain_age_last = let_deadline - input->origin_us;
+                if (chain_age_last > chain_age_max) {
+                    chain_age_max = chain_age_last;
+                }
+            }
+        }
+        let_token_publish(binding->output, input, binding->seq, let_release, let_deadline);
+        binding->seq++;
+    }
+
+    /* Record job execution (avoid buffer overflow) */
+    if (job_count < MAX_JOBS_PER_HYPERPERIOD) {
+        job_log[job_count].frame = frame;
+        job_log[job_count].task_name = tasks[t].name;
+        job_log[job_count].release_time = release;
+        job_log[job_count].start_time = result.start;
+        job_log[job_count].completion_time = result.stop;
+        job_log[job_count].exec_time = result.stop - result.start;
+        job_log[job_count].deadline = deadline;
+        job_log[job_count].deadline_missed = missed;
+        job_log[job_count].alarmed = alarmed;
+        job_count++;
+    } else {
+        invariants.dropped_logs++;
+    }
+
+    if (ENABLE_SELF_CHECK && result.start < release) {
+        invariants.early_starts++;
+    }
+
+    /* Count the deadline miss detected after execution (the alarm counted its own) */
+    if (missed) {
+        if (!alarmed) {
+            count_miss();
+
+            /* LED indication - Toggle red LED to signal error */
+            BSP_ToggleLED(LED_RED);
+        }
+
+        if (ENABLE_FAULT_INJECTION) {
+            fault_detected(FAULT_DETECT_MISS, detected_at);
+        }
+
+        /* Note: Skip printf here to avoid blocking the scheduler */
+    }
+}
+
+/**
+ * @brief Release the jobs of all tasks due by now into the EDF ready queue
+ *
+ * The queue stays sorted by deadline; equal deadlines keep release order.
+ */
+static void edf_release(uint64_t now) {
+    for (uint8_t t = 0; t < NUM_TASKS; t++) {
+        uint64_t release;
+        while ((release = scheduler_start_time +
+                          ((uint64_t)edf_released[t] * tasks[t].period_ms * 1000)) <= now) {
+            edf_released[t]++;
+            if (edf_queue_len == EDF_QUEUE_LEN) {
+                edf_overflows++;
+                edf_completed[t]++;  /* Never runs: successors must not wait for it */
+                continue;
+            }
+
+            edf_job_t job = { .task = t, .release = release,
+                              .deadline = release + ((uint64_t)tasks[t].deadline_ms * 1000) };
+            uint32_t i = edf_queue_len++;
+            while (i > 0 && edf_queue[i - 1].deadline > job.deadline) {
+                edf_queue[i] = edf_queue[i - 1];
+                i--;
+            }
+            edf_queue[i] = job;
+        }
+    }
+}
+
+/**
+ * @brief Check whether the predecessor jobs of a queued job are done
+ */
+static bool edf_preds_done(const edf_job_t *job) {
+    for (uint8_t e = 0; e < NUM_EDGES; e++) {
+        if (precedence[e].succ == job->task) {
+            uint8_t pred = precedence[e].pred;
+            if (edf_completed[pred] <= dag_pred_job(tasks[pred].period_ms, job->release - scheduler_start_time)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Remove a job from the ready queue
+ */
+static edf_job_t edf_remove(uint32_t i) {
+    edf_job_t job = edf_queue[i];
+    edf_queue_len--;
+    memmove(&edf_queue[i], &edf_queue[i + 1], (edf_queue_len - i) * sizeof(edf_job_t));
+    edf_completed[job.task]++;
+    return job;
+}
+
+/**
+ * @brief Online non-preemptive EDF dispatch from the frame tick
+ *
+ * Releases the due jobs, then runs ready jobs to completion in deadline
+ * order as long as the frame has time left; a job may complete after the
+ * frame end. Jobs whose deadline passed in the queue are skipped, and
+ * Task_C is admitted only if it can complete by its own deadline.
+ */
+static void edf_dispatch(uint32_t local_frame, uint64_t frame_end) {
+    uint64_t now = time_us_64();
+
+    edf_release(now);
+
+    while (edf_queue_len > 0 && now < frame_end) {
+        /* Expired jobs */
+        for (uint32_t i = 0; i < edf_queue_len;) {
+            if (edf_queue[i].deadline <= now) {
+                edf_job_t expired = edf_remove(i);
+                let_binding_t *binding = let_find_binding(tasks[expired.task].task);
+                if (binding != NULL) {
+                    binding->seq++;
+                }
+                log_skipped_job(local_frame, expired.task, expired.release, expired.deadline);
+            } else {
+                i++;
+            }
+        }
+
+        /* Earliest deadline among the jobs whose predecessors are done */
+        uint32_t next = 0;
+        while (next < edf_queue_len && !edf_preds_done(&edf_queue[next])) {
+            next++;
+        }
+        if (next == edf_queue_len) {
+            break;
+        }
+
+        edf_job_t ready = edf_remove(next);
+        dispatch_t job = { .task = ready.task, .frame = local_frame, .release = ready.release,
+                           .periodic_release = ready.release, .deadline = ready.deadline,
+                           .admit_until = ready.deadline };
+        if (ENABLE_DEADLINE_ALARM) {
+            deadline_alarm_arm(ready.task, ready.deadline);
+        }
+        run_job(&job);
+        now = time_us_64();
+    }
+}
+
 /**
  * @brief Frame timer callback - executes tasks for the current frame
  *
@@ -149,114 +1085,157 @@ void print_hyperperiod_report(void) {
  * @return true to keep timer running
  */
 bool frame_callback(repeating_timer_t *tmr) {
-    jobReturn_t result;
     uint64_t actual_time = time_us_64();
-    uint32_t local_frame = current_frame % NUM_FRAMES;
+    uint32_t fault_param;
 
     /* Initialize scheduler start time on first callback */
     if (current_frame == 0) {
         scheduler_start_time = actual_time;
+        hyperperiod_start = actual_time;
+        if (ENABLE_FAULT_INJECTION) {
+            fault_start(actual_time);
+        }
+    }
+
+    /* Injected timer faults: a lost tick dispatches nothing, a late one dispatches late */
+    if (ENABLE_FAULT_INJECTION) {
+        if (fault_pending(FAULT_LOST_TICK, FAULT_ANY_TASK, actual_time, &fault_param)) {
+            uint64_t frame_end = scheduler_start_time + frame_offset_us(current_frame + 1);
+            tmr->delay_us = -(int64_t)(frame_end - frame_timer_target);
+            frame_timer_target = frame_end;
+            return true;
+        }
+        if (fault_pending(FAULT_LATE_TIMER, FAULT_ANY_TASK, actual_time, &fault_param)) {
+            BSP_WaitClkCycles(fault_param * CYCLES_PER_US);
+            actual_time = time_us_64();
+        }
+    }
+
+    /* Resync: frames whose window passed (lost tick, long overrun) are dropped
+     * so that the table stays aligned with time */
+    if (ENABLE_FRAME_RESYNC) {
+        while (actual_time >= scheduler_start_time + frame_offset_us(current_frame + 1)) {
+            drop_frame(actual_time);
+        }
     }
 
+    uint32_t local_frame = current_frame % num_frames;
+
     /* Calculate absolute deadline based on scheduler start time, not actual callback time */
-    uint64_t frame_start = scheduler_start_time + (current_frame * MINOR_FRAME_MS * 1000);
-    uint64_t frame_deadline = frame_start + (MINOR_FRAME_MS * 1000);  /* Deadline in microseconds */
-
-    /* Execute all tasks scheduled for this frame (in order) */
-    for (uint8_t i = 0; i < schedule[local_frame].num_tasks; i++) {
-        /* Special handling for Task_C: check if there's enough time before executing */
-        if (schedule[local_frame].tasks[i] == job_C) {
-            /* Read GPIO switches to get actual execution time for Task_C */
-            bool bit7 = BSP_GetInput(SW_10);
-            bool bit6 = BSP_GetInput(SW_11);
-            bool bit5 = BSP_GetInput(SW_12);
-            bool bit4 = BSP_GetInput(SW_13);
-            bool bit3 = BSP_GetInput(SW_14);
-            bool bit2 = BSP_GetInput(SW_15);
-            bool bit1 = BSP_GetInput(SW_16);
-            bool bit0 = BSP_GetInput(SW_17);
-
-            uint8_t switch_value = (bit7 << 7) | (bit6 << 6) | (bit5 << 5) | (bit4 << 4) |
-                                   (bit3 << 3) | (bit2 << 2) | (bit1 << 1) | bit0;
-
-            /* Calculate Task_C's actual execution time from GPIO */
-            uint32_t task_c_wcet_us = ((switch_value * 8000) / 256);  /* Note: actual execution is this - 10us, but we add margin */
-
-            /* Check if there's enough time to complete Task_C */
-            uint64_t current_time = time_us_64();
-            int64_t time_remaining = (int64_t)frame_deadline - (int64_t)current_time;
-
-            if (time_remaining < (int64_t)task_c_wcet_us) {
-                /* Not enough time - skip Task_C */
-                if (job_count < MAX_JOBS_PER_HYPERPERIOD) {
-                    job_log[job_count].frame = local_frame;
-                    job_log[job_count].task_name = schedule[local_frame].names[i];
-                    job_log[job_count].release_time = frame_start;
-                    job_log[job_count].start_time = 0;
-                    job_log[job_count].completion_time = 0;
-                    job_log[job_count].exec_time = 0;
-                    job_log[job_count].deadline = frame_deadline;
-                    job_log[job_count].deadline_missed = true;
-                    job_count++;
-                }
+    uint64_t frame_start = scheduler_start_time + frame_offset_us(current_frame);
+    uint64_t frame_deadline = scheduler_start_time + frame_offset_us(current_frame + 1);  /* Deadline in microseconds */
+
+    /* The timer fires again at the end of this frame (frames may differ in
+     * length). The delay counts from this callback's target, which lags the
+     * frame after a resync drop; from the frame start the next frame would
+     * be dispatched before its start. */
+    tmr->delay_us = -(int64_t)(frame_deadline - frame_timer_target);
+    frame_timer_target = frame_deadline;
 
-                deadline_misses_current++;
-                deadline_misses_total++;
+    /* A frame dispatched after its own end means the scheduler stalled */
+    if (ENABLE_SELF_CHECK && actual_time > frame_start) {
+        uint64_t lateness = actual_time - frame_start;
+        if (lateness > invariants.max_lateness_us) {
+            invariants.max_lateness_us = lateness;
+        }
+        if (lateness >= frame_deadline - frame_start) {
+            invariants.stalls++;
+        }
+    }
 
-                /* LED indication */
-                BSP_ToggleLED(LED_RED);
+    /* Generated input for this frame's Task_C job */
+    if (FUZZ_INPUTS) {
+        fuzz_next_switch();
+    }
 
-                /* Note: Skip printf here to avoid blocking the scheduler */
+    if (ONLINE_EDF) {
+        edf_dispatch(local_frame, frame_deadline);
+    } else {
+        /* Execute all tasks scheduled for this frame (in order) */
+        uint8_t jobs[MAX_TASKS_PER_FRAME];
+        uint8_t num_jobs = frame_jobs(local_frame, jobs);
 
-                continue;  /* Skip Task_C, move to next task */
+        /* Will the frame's jobs fit in the time it has left? */
+        if (ENABLE_OVERLOAD_WARNING) {
+            uint32_t task_jobs[NUM_TASKS] = {0};
+            for (uint8_t i = 0; i < num_jobs; i++) {
+                task_jobs[jobs[i]]++;
             }
+            predict_overload(task_jobs, (frame_deadline > actual_time) ? frame_deadline - actual_time : 0,
+                             actual_time);
         }
 
-        /* Execute the task */
-        schedule[local_frame].tasks[i](&result);
-
-        /* Record job execution (avoid buffer overflow) */
-        if (job_count < MAX_JOBS_PER_HYPERPERIOD) {
-            job_log[job_count].frame = local_frame;
-            job_log[job_count].task_name = schedule[local_frame].names[i];
-            job_log[job_count].release_time = frame_start;
-            job_log[job_count].start_time = result.start;
-            job_log[job_count].completion_time = result.stop;
-            job_log[job_count].exec_time = result.stop - result.start;
-            job_log[job_count].deadline = frame_deadline;
-            job_log[job_count].deadline_missed = (result.stop > frame_deadline);
-            job_count++;
+        /* All jobs of the frame are released at its start */
+        for (uint8_t i = 0; i < num_jobs && ENABLE_DEADLINE_ALARM; i++) {
+            deadline_alarm_arm(jobs[i], frame_deadline);
+        }
+        for (uint8_t i = 0; i < num_jobs; i++) {
+            uint8_t t = jobs[i];
+            dispatch_t job = { .task = t, .frame = local_frame, .release = frame_start,
+                               .periodic_release = table_release(t), .deadline = frame_deadline,
+                               .admit_until = frame_deadline };
+            run_job(&job);
         }
+    }
 
-        /* Check for deadline miss after execution */
-        if (result.stop > frame_deadline) {
-            deadline_misses_current++;
-            deadline_misses_total++;
+    end_frame();
 
-            /* LED indication - Toggle red LED to signal error */
-            BSP_ToggleLED(LED_RED);
+    return true;  /* Keep timer running */
+}
 
-            /* Note: Skip printf here to avoid blocking the scheduler */
-        }
-    }
+/**
+ * @brief Time-triggered dispatcher, run by the hardware alarm
+ *
+ * The alarm is set TT_ALARM_LEAD_US before the next planned start and the
+ * dispatch spins to the exact instant, so the start does not depend on
+ * the interrupt latency. Entries whose start already passed (an overrun)
+ * are dispatched back to back, late.
+ */
+static void tt_alarm_callback(unsigned int alarm_num) {
+    do {
+        const timetable_entry_t *entry = &timetable[tt_next];
+        const task_desc_t *task = &tasks[entry->task];
+        uint64_t start = hyperperiod_start + entry->start_us;
+        uint64_t release = hyperperiod_start + ((uint64_t)entry->job * task->period_ms * 1000);
+        uint64_t deadline = release + ((uint64_t)task->deadline_ms * 1000);
 
-    /* Move to next frame */
-    current_frame++;
+        /* Task_C has to complete before the next planned start */
+        uint64_t next_start = (tt_next + 1 < timetable_len) ?
+                              hyperperiod_start + timetable[tt_next + 1].start_us :
+                              hyperperiod_start + hyperperiod_us + timetable[0].start_us;
 
-    /* Check if hyperperiod completed */
-    if (current_frame % NUM_FRAMES == 0) {
-        BSP_ToggleLED(LED_GREEN);
+        while (time_us_64() < start) {
+            tight_loop_contents();
+        }
 
-        /* Print report for completed hyperperiod */
-        print_hyperperiod_report();
+        uint32_t error = (uint32_t)(time_us_64() - start);
+        if (error > tt_dispatch_error) {
+            tt_dispatch_error = error;
+        }
+        if (error > tt_dispatch_error_max) {
+            tt_dispatch_error_max = error;
+        }
+        if (ENABLE_SELF_CHECK && error > invariants.max_lateness_us) {
+            invariants.max_lateness_us = error;
+        }
 
-        /* Reset for next hyperperiod */
-        job_count = 0;
-        deadline_misses_current = 0;
-        hyperperiod_count++;
-    }
+        if (FUZZ_INPUTS && task->task == job_C) {
+            fuzz_next_switch();
+        }
+        dispatch_t job = { .task = entry->task, .frame = entry->start_us / (MINOR_FRAME_MS * 1000),
+                           .release = start, .periodic_release = release, .deadline = deadline,
+                           .admit_until = (next_start < deadline) ? next_start : deadline };
+        if (ENABLE_DEADLINE_ALARM) {
+            deadline_alarm_arm(entry->task, deadline);
+        }
+        run_job(&job);
 
-    return true;  /* Keep timer running */
+        if (++tt_next == timetable_len) {
+            tt_next = 0;
+            end_hyperperiod();
+        }
+    } while (hardware_alarm_set_target(alarm_num, from_us_since_boot(
+                 hyperperiod_start + timetable[tt_next].start_us - TT_ALARM_LEAD_US)));
 }
 
 /**
@@ -268,29 +1247,221 @@ int main()
 {
     BSP_Init();  /* Initialize all components on the lab-kit. */
 
+#if FUZZ_INPUTS
+    /* Task_C follows the generated sequence instead of the switches */
+    fuzz_init(FUZZ_SEED);
+    workload_set_switch_source(fuzz_switch_source);
+#endif
+
+#if ENABLE_FAULT_INJECTION
+    /* Switch faults are applied on top of the input selected above */
+    static const char *task_names[NUM_TASKS];
+    uint32_t num_fault_events = FAULT_PLAN_SCRIPTED_EVENTS;
+    if (FAULT_PLAN_RANDOM) {
+        num_fault_events = FAULT_MAX_EVENTS;
+        fault_random_plan(fault_plan, num_fault_events, NUM_TASKS, FAULT_HORIZON_MS, FAULT_SEED);
+    }
+    for (int i = 0; i < NUM_TASKS; i++) {
+        task_names[i] = tasks[i].name;
+    }
+    fault_init(fault_plan, num_fault_events, task_names,
+               FUZZ_INPUTS ? fuzz_switch_source : workload_read_switches);
+    workload_set_switch_source(fault_switch_source);
+#endif
+
+    trace_budget_init(&trace_budget, TRACE_BUDGET_US);
+    overload_init(&overload, NUM_TASKS, OVERLOAD_WINDOW_JOBS, OVERLOAD_HEADROOM_US);
+
+    /* LET channels for the sensor -> filter -> actuator chain */
+    let_init(&sensor_channel, sensor_storage, sizeof(let_token_t));
+    let_init(&filter_channel, filter_storage, sizeof(let_token_t));
+
+#if USE_SYNTHESIZED_SCHEDULE
+    if (!schedule_synthesize(&task_set, schedule)) {
+        printf("Schedule synthesis failed, using the static table\n");
+    }
+#endif
+
+#if NON_UNIFORM_FRAMES
+    static frame_schedule_t variable_schedule[NUM_FRAMES];
+    if (schedule_synthesize_frames(&task_set, variable_schedule)) {
+        memcpy(schedule, variable_schedule, sizeof(schedule));
+    } else {
+        printf("Non-uniform frame synthesis failed, using minor frames\n");
+    }
+#endif
+    num_frames = schedule_frame_starts(schedule, frame_starts_us);
+    if (num_frames == 0) {
+        printf("Frame durations do not add up to the hyperperiod\n");
+        while (true) {
+            tight_loop_contents();
+        }
+    }
+
+#if COMPACT_SCHEDULE
+    /* Extra runs of a task in one period are dropped by the compression */
+    uint32_t compact_dropped = schedule_compact_from_table(&task_set, schedule, &compact);
+    if (compact_dropped == UINT32_MAX) {
+        compact_dropped = 0;
+        if (!schedule_compact_synthesize(&task_set, &compact)) {
+            printf("Compact schedule construction failed\n");
+            while (true) {
+                tight_loop_contents();
+            }
+        }
+    }
+
+    /* Frames, releases and reports follow the major cycle (the timetable
+     * keeps its own hyperperiod) */
+    if (!TIME_TRIGGERED) {
+        num_frames = compact.major_frames;
+        hyperperiod_us = (uint64_t)compact.major_frames * MINOR_FRAME_MS * 1000;
+    }
+#endif
+
+#if TIME_TRIGGERED
+    timetable_len = schedule_timetable(&task_set, timetable, MAX_TIMETABLE_ENTRIES);
+    if (timetable_len == 0) {
+        printf("Timetable construction failed\n");
+        while (true) {
+            tight_loop_contents();
+        }
+    }
+#endif
+
+    /* Offline analysis: the dispatched schedule must respect release windows and precedence */
+#if COMPACT_SCHEDULE
+    uint32_t violations = schedule_compact_check(&task_set, &compact, true);
+#else
+    uint32_t violations = schedule_check(&task_set, schedule, true);
+#endif
+    uint32_t chain_periods[NUM_TASKS];
+    uint32_t chain_deadlines[NUM_TASKS];
+    for (int i = 0; i < NUM_TASKS; i++) {
+        chain_periods[i] = tasks[i].period_ms;
+        chain_deadlines[i] = tasks[i].deadline_ms;
+    }
+    for (int i = 0; i < NUM_CHAINS; i++) {
+        dag_analyze_let_chain(&chains[i], chain_periods, chain_deadlines, &chain_bounds[i]);
+    }
+
     printf("\n========================================\n");
     printf("Cyclic Scheduler Started\n");
     printf("Minor Frame: %d ms\n", MINOR_FRAME_MS);
-    printf("Hyperperiod: %d ms (%d frames)\n", HYPERPERIOD_MS, NUM_FRAMES);
+    printf("Hyperperiod: %u ms (%u frames)\n", (unsigned)(hyperperiod_us / 1000), num_frames);
     printf("========================================\n");
     printf("Schedule Preview:\n");
-    for (int i = 0; i < NUM_FRAMES; i++) {
-        printf("  F%02d: ", i);
-        for (int j = 0; j < schedule[i].num_tasks; j++) {
-            printf("%s", schedule[i].names[j]);
-            if (j < schedule[i].num_tasks - 1) printf(", ");
+    for (uint32_t i = 0; i < num_frames; i++) {
+        uint8_t jobs[MAX_TASKS_PER_FRAME];
+        uint8_t n = frame_jobs(i, jobs);
+        printf("  F%02u (%2u ms): ", i, (unsigned)((frame_offset_us(i + 1) - frame_offset_us(i)) / 1000));
+        for (int j = 0; j < n; j++) {
+            printf("%s", tasks[jobs[j]].name);
+            if (j < n - 1) printf(", ");
+        }
+        printf("\n");
+    }
+    printf("Schedule check: %u violation(s)\n", violations);
+#if COMPACT_SCHEDULE
+    printf("Compact schedule: %u frames, %u offsets, %u bytes (frame table %u bytes), "
+           "%u extra job(s) dropped\n", compact.major_frames, compact.num_offsets,
+           (unsigned)sizeof(compact), (unsigned)sizeof(schedule), compact_dropped);
+    for (uint8_t i = 0; i < compact.num_tasks; i++) {
+        const compact_task_t *task = &compact.tasks[i];
+        printf("  %s: every %u frames, offsets", tasks[i].name, task->period_frames);
+        for (uint16_t k = 0; k < task->cycle; k++) {
+            printf(" %u", compact.offsets[task->first + k]);
         }
         printf("\n");
     }
+#endif
+    if (ONLINE_EDF && !TIME_TRIGGERED) {
+        printf("Dispatch: online non-preemptive EDF from the frame tick (table not used)\n");
+    }
+    if (TIME_TRIGGERED) {
+        printf("Time-triggered: %u jobs per hyperperiod\n", timetable_len);
+        for (uint32_t i = 0; i < timetable_len; i++) {
+            printf("  %6u us: %s\n", timetable[i].start_us, tasks[timetable[i].task].name);
+        }
+    }
+#if FUZZ_INPUTS
+    uint32_t synthesized;
+    uint32_t fuzz_failures = schedule_fuzz(FUZZ_TABLE_ITERATIONS, FUZZ_SEED, &synthesized);
+    printf("Schedule fuzz: %u random task sets, %u synthesized, %u property failure(s)\n",
+           FUZZ_TABLE_ITERATIONS, synthesized, fuzz_failures);
+    printf("Task_C inputs generated from seed %u\n", FUZZ_SEED);
+#endif
+    for (int i = 0; i < NUM_CHAINS; i++) {
+        printf("Chain %s: worst-case latency %llu us, data age %llu us\n",
+               chains[i].name, chain_bounds[i].max_latency_us, chain_bounds[i].max_age_us);
+    }
     printf("========================================\n");
-    printf("Collecting data... Reports printed every %d ms\n\n", HYPERPERIOD_MS);
+    printf("Collecting data... Reports printed every %u ms\n", (unsigned)(hyperperiod_us / 1000));
+    if (ENABLE_TRACE_BUDGET) {
+        printf("Report budget: %u us per hyperperiod; full reports sampled down to 1/%u, "
+               "then summaries\n", TRACE_BUDGET_US, TRACE_MAX_SAMPLE_EVERY);
+    }
+    if (ENABLE_OVERLOAD_WARNING) {
+        printf("Overload warning: headroom below %d us per %s, estimates from the last %d jobs\n",
+               OVERLOAD_HEADROOM_US, (ONLINE_EDF || TIME_TRIGGERED) ? "hyperperiod" : "frame",
+               OVERLOAD_WINDOW_JOBS);
+    }
+    printf("\n");
 
-    /* Start the cyclic scheduler with 5ms frame timer */
-    /* Note: scheduler_start_time will be initialized on first callback */
-    add_repeating_timer_ms(-MINOR_FRAME_MS, frame_callback, NULL, &frame_timer);
+    /* Core 1 executes the forked segments */
+    if (ENABLE_FORK_JOIN) {
+        fj_core1_init();
+    }
 
-    /* Main loop - scheduler runs in timer callback */
+    /* Above the frame timer and the time-triggered alarm, which run the jobs */
+    if (ENABLE_DEADLINE_ALARM) {
+        deadline_alarm_init(deadline_missed, PICO_HIGHEST_IRQ_PRIORITY);
+    }
+
+    if (TIME_TRIGGERED) {
+        /* First hyperperiod starts one frame from now */
+        hyperperiod_start = time_us_64() + (MINOR_FRAME_MS * 1000);
+        scheduler_start_time = hyperperiod_start;
+        if (ENABLE_FAULT_INJECTION) {
+            fault_start(scheduler_start_time);
+        }
+        tt_alarm = (unsigned int)hardware_alarm_claim_unused(true);
+        hardware_alarm_set_callback(tt_alarm, tt_alarm_callback);
+        hardware_alarm_set_target(tt_alarm, from_us_since_boot(
+            hyperperiod_start + timetable[0].start_us - TT_ALARM_LEAD_US));
+    } else {
+        /* Start the cyclic scheduler with 5ms frame timer */
+        /* Note: scheduler_start_time will be initialized on first callback.
+         * The timer's first target is at most a few us after this estimate,
+         * so delays counted from it never fire a frame early. */
+        frame_timer_target = time_us_64() + frame_offset_us(1);
+        add_repeating_timer_us(-(int64_t)frame_offset_us(1), frame_callback, NULL, &frame_timer);
+    }
+
+    /* Interrupt accounting covers the scheduler's timer interrupt from here on */
+    if (ENABLE_ISR_LOAD) {
+        for (uint32_t i = 0; i < num_frames; i++) {
+            uint8_t jobs[MAX_TASKS_PER_FRAME];
+            uint8_t n = frame_jobs(i, jobs);
+            uint32_t budget = 0;
+            for (uint8_t j = 0; j < n; j++) {
+                budget += tasks[jobs[j]].wcet_us;
+            }
+            if (budget > frame_budget_max_us) {
+                frame_budget_max_us = budget;
+                frame_budget_len_us = (uint32_t)(frame_offset_us(i + 1) - frame_offset_us(i));
+            }
+        }
+        printf("Interrupt accounting: %u source(s)\n\n", isr_load_init());
+    }
+
+    /* Main loop - scheduler runs in timer callback (time-triggered: alarm
+     * callback, and the reports are printed here) */
     while (true) {
+        if (report_pending) {
+            print_budgeted_report(report_log, report_count, report_hyperperiod, report_misses, report_detail);
+            report_pending = false;
+        }
         tight_loop_contents();  /* Idle loop */
     }
 
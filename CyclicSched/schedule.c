@@ -0,0 +1,916 @@
+/**
+ * @file schedule.c
+ * @brief Offline helpers for the cyclic executive: synthesizes a frame table
+ *        (of minor frames or of frames with their own lengths) from the task
+ *        set and checks a table against release windows and precedence
+ *        constraints, assigns the jobs exact start times for the
+ *        time-triggered mode and builds compact per-task schedules for long
+ *        hyperperiods.
+ */
+#include <stdio.h>
+#include <string.h>
+#include "schedule.h"
+#include "fuzz.h"
+
+#define FRAME_US (MINOR_FRAME_MS * 1000)
+#define MAX_JOBS_PER_TASK NUM_FRAMES  /* No task has a period below one frame */
+
+/**
+ * @brief Check that all predecessors of a job have already been placed.
+ *
+ * @param placed Number of placed jobs per task
+ * @param succ Task index of the job
+ * @param release_us Release of the job relative to the hyperperiod start
+ */
+static bool preds_placed(const task_set_t *set, const uint32_t *placed,
+                         uint8_t succ, uint64_t release_us) {
+    for (uint8_t e = 0; e < set->num_edges; e++) {
+        if (set->edges[e].succ == succ) {
+            uint8_t pred = set->edges[e].pred;
+            if (placed[pred] <= dag_pred_job(set->tasks[pred].period_ms, release_us)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Frame boundaries of a table.
+ *
+ * Frames run back to back from the hyperperiod start, each for its own
+ * duration (0 is one minor frame); the table ends with the frame that
+ * reaches the hyperperiod.
+ *
+ * @param starts_us Filled with the frame starts and, after the last frame,
+ *        the hyperperiod
+ * @return Number of frames, 0 if the durations do not add up to the
+ *         hyperperiod
+ */
+uint32_t schedule_frame_starts(const frame_schedule_t table[NUM_FRAMES], uint32_t starts_us[NUM_FRAMES + 1]) {
+    uint32_t n = 0;
+
+    starts_us[0] = 0;
+    while (n < NUM_FRAMES && starts_us[n] < HYPERPERIOD_MS * 1000) {
+        uint32_t duration_ms = (table[n].duration_ms != 0) ? table[n].duration_ms : MINOR_FRAME_MS;
+        starts_us[n + 1] = starts_us[n] + duration_ms * 1000;
+        n++;
+    }
+    return (starts_us[n] == HYPERPERIOD_MS * 1000) ? n : 0;
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Fill frames with non-preemptive EDF over the job windows.
+ *
+ * A frame starts at each marked millisecond of the hyperperiod. Each frame
+ * is filled with released jobs in deadline order (ties broken by
+ * precedence order) as long as they fit and complete by their deadline. A
+ * job only becomes eligible once the predecessor jobs it depends on are
+ * placed, which places successors after their predecessors. Frames past
+ * NUM_FRAMES are filled but not stored, so that a layout can be tested
+ * before it fits the table.
+ *
+ * @param cut cut[ms] marks a frame start; cut[0] must be set
+ * @return Number of frames, 0 if some job cannot be placed inside its window
+ */
+static uint32_t fill_frames(const task_set_t *set, const bool cut[HYPERPERIOD_MS],
+                            frame_schedule_t table[NUM_FRAMES]) {
+    uint8_t order[DAG_MAX_TASKS];
+    uint8_t rank[DAG_MAX_TASKS];
+    uint32_t placed[DAG_MAX_TASKS] = {0};
+    uint32_t f = 0;
+
+    if (!dag_topological_order(set->num_tasks, set->edges, set->num_edges, order)) {
+        return 0;
+    }
+    for (uint8_t i = 0; i < set->num_tasks; i++) {
+        rank[order[i]] = i;
+    }
+
+    for (uint32_t start_ms = 0; start_ms < HYPERPERIOD_MS; f++) {
+        frame_schedule_t scratch;
+        frame_schedule_t *frame = (f < NUM_FRAMES) ? &table[f] : &scratch;
+        uint32_t end_ms = start_ms + 1;
+        while (end_ms < HYPERPERIOD_MS && !cut[end_ms]) {
+            end_ms++;
+        }
+        uint64_t frame_start = (uint64_t)start_ms * 1000;
+        uint64_t frame_end = (uint64_t)end_ms * 1000;
+        uint32_t load = 0;
+
+        frame->num_tasks = 0;
+        frame->duration_ms = (uint16_t)(end_ms - start_ms);
+
+        while (frame->num_tasks < MAX_TASKS_PER_FRAME) {
+            uint8_t best = set->num_tasks;
+            uint64_t best_deadline = UINT64_MAX;
+
+            for (uint8_t t = 0; t < set->num_tasks; t++) {
+                const task_desc_t *task = &set->tasks[t];
+                uint64_t release = (uint64_t)placed[t] * task->period_ms * 1000;
+                uint64_t deadline = release + (uint64_t)task->deadline_ms * 1000;
+
+                if (placed[t] >= HYPERPERIOD_MS / task->period_ms || release > frame_start ||
+                    deadline < frame_end || load + task->wcet_us > frame_end - frame_start ||
+                    !preds_placed(set, placed, t, release)) {
+                    continue;
+                }
+                if (deadline < best_deadline ||
+                    (deadline == best_deadline && rank[t] < rank[best])) {
+                    best = t;
+                    best_deadline = deadline;
+                }
+            }
+            if (best == set->num_tasks) {
+                break;
+            }
+
+            frame->tasks[frame->num_tasks] = set->tasks[best].task;
+            frame->names[frame->num_tasks] = set->tasks[best].name;
+            frame->num_tasks++;
+            load += set->tasks[best].wcet_us;
+            placed[best]++;
+        }
+
+        /* A job still pending with its deadline at this frame's end is lost */
+        for (uint8_t t = 0; t < set->num_tasks; t++) {
+            const task_desc_t *task = &set->tasks[t];
+            uint64_t release = (uint64_t)placed[t] * task->period_ms * 1000;
+            if (placed[t] < HYPERPERIOD_MS / task->period_ms &&
+                release + (uint64_t)task->deadline_ms * 1000 <= frame_end) {
+                return 0;
+            }
+        }
+        start_ms = end_ms;
+    }
+    return f;
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Build a frame table of minor frames with non-preemptive EDF over
+ *        the job windows.
+ *
+ * @param set Task set to schedule
+ * @param table Filled with the synthesized schedule
+ * @return false if some job cannot be placed inside its window
+ */
+bool schedule_synthesize(const task_set_t *set, frame_schedule_t table[NUM_FRAMES]) {
+    bool cut[HYPERPERIOD_MS] = {false};
+
+    for (uint32_t ms = 0; ms < HYPERPERIOD_MS; ms += MINOR_FRAME_MS) {
+        cut[ms] = true;
+    }
+    return fill_frames(set, cut, table) == NUM_FRAMES;
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Build a frame table whose frames have their own lengths.
+ *
+ * Frame boundaries start at every job release and deadline, so that no
+ * window is cut by a frame. Boundaries are then removed one at a time,
+ * earliest first, as long as the jobs still fit: each removal saves a
+ * frame interrupt and joins the slack of two frames.
+ *
+ * @return false if some job cannot be placed or more than NUM_FRAMES
+ *         frames remain
+ */
+bool schedule_synthesize_frames(const task_set_t *set, frame_schedule_t table[NUM_FRAMES]) {
+    bool cut[HYPERPERIOD_MS] = {false};
+
+    for (uint8_t t = 0; t < set->num_tasks; t++) {
+        const task_desc_t *task = &set->tasks[t];
+        for (uint32_t release = 0; release < HYPERPERIOD_MS; release += task->period_ms) {
+            cut[release] = true;
+            if (release + task->deadline_ms < HYPERPERIOD_MS) {
+                cut[release + task->deadline_ms] = true;
+            }
+        }
+    }
+    if (fill_frames(set, cut, table) == 0) {
+        return false;
+    }
+
+    for (uint32_t ms = 1; ms < HYPERPERIOD_MS; ms++) {
+        if (cut[ms]) {
+            cut[ms] = false;
+            if (fill_frames(set, cut, table) == 0) {
+                cut[ms] = true;
+            }
+        }
+    }
+
+    uint32_t n = fill_frames(set, cut, table);
+    return n > 0 && n <= NUM_FRAMES;
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Verify a frame table against the task set.
+ *
+ * Checks that the frames cover the hyperperiod, that every job runs
+ * exactly once inside its [release, deadline] window, that frames are not overloaded and that each job runs after the
+ * predecessor jobs it depends on.
+ *
+ * @param verbose Print each violation
+ * @return Number of violations found
+ */
+uint32_t schedule_check(const task_set_t *set, const frame_schedule_t table[NUM_FRAMES], bool verbose) {
+    uint8_t slot[DAG_MAX_TASKS][MAX_JOBS_PER_TASK];  /* frame * MAX_TASKS_PER_FRAME + position */
+    uint32_t jobs[DAG_MAX_TASKS] = {0};
+    uint32_t starts_us[NUM_FRAMES + 1];
+    uint32_t num_frames = schedule_frame_starts(table, starts_us);
+    uint32_t violations = 0;
+
+    if (num_frames == 0) {
+        if (verbose) printf("Schedule check: frame durations do not add up to the hyperperiod\n");
+        return 1;
+    }
+
+    for (uint32_t f = 0; f < num_frames; f++) {
+        uint32_t frame_us = starts_us[f + 1] - starts_us[f];
+        uint32_t load = 0;
+
+        for (uint8_t p = 0; p < table[f].num_tasks; p++) {
+            uint8_t t = 0;
+            while (t < set->num_tasks && set->tasks[t].task != table[f].tasks[p]) {
+                t++;
+            }
+            if (t == set->num_tasks) {
+                if (verbose) printf("Schedule check: F%02u runs a task outside the task set\n", f);
+                violations++;
+                continue;
+            }
+
+            const task_desc_t *task = &set->tasks[t];
+            uint64_t release = (uint64_t)jobs[t] * task->period_ms * 1000;
+            uint64_t deadline = release + (uint64_t)task->deadline_ms * 1000;
+            if (jobs[t] >= HYPERPERIOD_MS / task->period_ms) {
+                if (verbose) printf("Schedule check: %s runs too often (F%02u)\n", task->name, f);
+                violations++;
+                continue;
+            }
+            if (release > starts_us[f] || deadline < starts_us[f + 1]) {
+                if (verbose) printf("Schedule check: %s job %u outside its window (F%02u)\n", task->name, jobs[t], f);
+                violations++;
+            }
+            slot[t][jobs[t]++] = (uint8_t)(f * MAX_TASKS_PER_FRAME + p);
+            load += task->wcet_us;
+        }
+        if (load > frame_us) {
+            if (verbose) printf("Schedule check: F%02u overloaded (%u us)\n", f, load);
+            violations++;
+        }
+    }
+
+    for (uint8_t t = 0; t < set->num_tasks; t++) {
+        if (jobs[t] != HYPERPERIOD_MS / set->tasks[t].period_ms) {
+            if (verbose) printf("Schedule check: %s runs %u of %u jobs\n", set->tasks[t].name,
+                                jobs[t], HYPERPERIOD_MS / set->tasks[t].period_ms);
+            violations++;
+        }
+    }
+
+    /* Precedence: each successor job runs after the predecessor job it reads */
+    for (uint8_t e = 0; e < set->num_edges; e++) {
+        uint8_t pred = set->edges[e].pred;
+        uint8_t succ = set->edges[e].succ;
+
+        for (uint32_t k = 0; k < jobs[succ]; k++) {
+            uint64_t release = (uint64_t)k * set->tasks[succ].period_ms * 1000;
+            uint32_t kp = dag_pred_job(set->tasks[pred].period_ms, release);
+            if (kp >= jobs[pred] || slot[pred][kp] > slot[succ][k]) {
+                if (verbose) printf("Schedule check: %s job %u runs before %s job %u\n",
+                                    set->tasks[succ].name, k, set->tasks[pred].name, kp);
+                violations++;
+            }
+        }
+    }
+    return violations;
+}
+/*-----------------------------------------------------------*/
+
+/* Job placed in a timetable under construction */
+typedef struct {
+    const task_set_t *set;
+    timetable_entry_t *table;
+    uint32_t count;
+} timetable_t;
+
+/**
+ * @brief Check whether a job of a task can start at a time.
+ *
+ * The job has to finish by its deadline, must not overlap a placed job
+ * (each followed by TIMETABLE_GAP_US) and must start after the predecessor
+ * jobs it depends on have finished.
+ */
+static bool timetable_fits(const timetable_t *tt, uint8_t t, uint32_t job, uint64_t start) {
+    const task_desc_t *task = &tt->set->tasks[t];
+    uint64_t release = (uint64_t)job * task->period_ms * 1000;
+    uint64_t end = start + task->wcet_us + TIMETABLE_GAP_US;
+
+    if (start < release || start + task->wcet_us > release + (uint64_t)task->deadline_ms * 1000 ||
+        end > (uint64_t)HYPERPERIOD_MS * 1000) {
+        return false;
+    }
+
+    for (uint32_t i = 0; i < tt->count; i++) {
+        const timetable_entry_t *e = &tt->table[i];
+        uint64_t e_end = e->start_us + tt->set->tasks[e->task].wcet_us + TIMETABLE_GAP_US;
+        if (start < e_end && e->start_us < end) {
+            return false;
+        }
+    }
+
+    for (uint8_t k = 0; k < tt->set->num_edges; k++) {
+        if (tt->set->edges[k].succ != t) {
+            continue;
+        }
+        uint8_t pred = tt->set->edges[k].pred;
+        uint32_t pred_job = dag_pred_job(tt->set->tasks[pred].period_ms, release);
+        for (uint32_t i = 0; i < tt->count; i++) {
+            const timetable_entry_t *e = &tt->table[i];
+            if (e->task == pred && e->job == pred_job &&
+                start < e->start_us + tt->set->tasks[pred].wcet_us) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Place all jobs of a task.
+ *
+ * Candidate starts are the releases and the ends of placed jobs; the
+ * earliest start that fits is always one of them. A common offset from
+ * the releases is tried first, then the earliest start of each job.
+ */
+static bool timetable_place_task(timetable_t *tt, uint8_t t, uint32_t max_entries) {
+    const task_desc_t *task = &tt->set->tasks[t];
+    uint32_t period_us = task->period_ms * 1000;
+    uint32_t num_jobs = HYPERPERIOD_MS / task->period_ms;
+    uint32_t placed = tt->count;
+    uint64_t best = UINT64_MAX;
+
+    if (tt->count + num_jobs > max_entries) {
+        return false;
+    }
+
+    /* Common offset: candidates are 0 and placed job ends shifted to each release */
+    for (uint32_t c = 0; c <= placed; c++) {
+        for (uint32_t k = 0; k < num_jobs; k++) {
+            uint64_t anchor = 0;
+            if (c < placed) {
+                const timetable_entry_t *e = &tt->table[c];
+                anchor = e->start_us + tt->set->tasks[e->task].wcet_us + TIMETABLE_GAP_US;
+            }
+            if (anchor < (uint64_t)k * period_us) {
+                continue;
+            }
+            uint64_t offset = anchor - (uint64_t)k * period_us;
+            if (offset >= best) {
+                continue;
+            }
+
+            bool all_fit = true;
+            for (uint32_t j = 0; j < num_jobs && all_fit; j++) {
+                all_fit = timetable_fits(tt, t, j, (uint64_t)j * period_us + offset);
+            }
+            if (all_fit) {
+                best = offset;
+            }
+            if (c == placed) {
+                break;  /* Offset 0 needs no other release */
+            }
+        }
+    }
+
+    if (best != UINT64_MAX) {
+        for (uint32_t j = 0; j < num_jobs; j++) {
+            tt->table[tt->count++] = (timetable_entry_t){
+                .start_us = (uint32_t)((uint64_t)j * period_us + best), .task = t, .job = (uint8_t)j };
+        }
+        return true;
+    }
+
+    /* No common offset: earliest start of each job on its own */
+    for (uint32_t j = 0; j < num_jobs; j++) {
+        uint64_t release = (uint64_t)j * period_us;
+        uint64_t start = UINT64_MAX;
+
+        if (timetable_fits(tt, t, j, release)) {
+            start = release;
+        }
+        for (uint32_t c = 0; c < tt->count; c++) {
+            const timetable_entry_t *e = &tt->table[c];
+            uint64_t end = e->start_us + tt->set->tasks[e->task].wcet_us;
+            uint64_t candidates[2] = { end, end + TIMETABLE_GAP_US };
+            for (uint32_t i = 0; i < 2; i++) {
+                if (candidates[i] < start && timetable_fits(tt, t, j, candidates[i])) {
+                    start = candidates[i];
+                }
+            }
+        }
+        if (start == UINT64_MAX) {
+            return false;
+        }
+        tt->table[tt->count++] = (timetable_entry_t){ .start_us = (uint32_t)start, .task = t, .job = (uint8_t)j };
+    }
+    return true;
+}
+
+/**
+ * @brief Assign every job of the hyperperiod an exact start time.
+ *
+ * Tasks are placed by increasing period, predecessors first. Each task
+ * gets the smallest common offset from its releases at which all its jobs
+ * fit, so its start times have no jitter; only if there is none, each job
+ * takes the earliest start that fits in its window.
+ *
+ * @param table Filled with the entries, sorted by start time
+ * @return Number of entries, 0 if some job does not fit in its window
+ */
+uint32_t schedule_timetable(const task_set_t *set, timetable_entry_t *table, uint32_t max_entries) {
+    timetable_t tt = { .set = set, .table = table, .count = 0 };
+    bool done[DAG_MAX_TASKS] = {false};
+
+    if (!dag_is_acyclic(set->num_tasks, set->edges, set->num_edges)) {
+        return 0;
+    }
+
+    for (uint8_t n = 0; n < set->num_tasks; n++) {
+        /* Next task: shortest period among those whose predecessors are placed */
+        uint8_t next = set->num_tasks;
+        for (uint8_t t = 0; t < set->num_tasks; t++) {
+            bool ready = !done[t];
+            for (uint8_t e = 0; e < set->num_edges && ready; e++) {
+                ready = (set->edges[e].succ != t || done[set->edges[e].pred]);
+            }
+            if (ready && (next == set->num_tasks || set->tasks[t].period_ms < set->tasks[next].period_ms)) {
+                next = t;
+            }
+        }
+        if (!timetable_place_task(&tt, next, max_entries)) {
+            return 0;
+        }
+        done[next] = true;
+    }
+
+    /* Sort by start time */
+    for (uint32_t i = 1; i < tt.count; i++) {
+        timetable_entry_t e = table[i];
+        uint32_t j = i;
+        while (j > 0 && table[j - 1].start_us > e.start_us) {
+            table[j] = table[j - 1];
+            j--;
+        }
+        table[j] = e;
+    }
+    return tt.count;
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Tasks running in a frame of a compact schedule, constant time per task.
+ *
+ * @param frame Frame number since start; wraps at the major cycle
+ * @return Bit mask of task indices
+ */
+uint32_t schedule_compact_frame(const compact_schedule_t *compact, uint32_t frame) {
+    uint32_t f = frame % compact->major_frames;
+    uint32_t mask = 0;
+
+    for (uint8_t t = 0; t < compact->num_tasks; t++) {
+        const compact_task_t *task = &compact->tasks[t];
+        if (task->cycle == 0) {
+            continue;  /* Not placed yet */
+        }
+        uint32_t k = f / task->period_frames;
+        if (f % task->period_frames == compact->offsets[task->first + k % task->cycle]) {
+            mask |= 1u << t;
+        }
+    }
+    return mask;
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Verify a compact schedule against the task set, from its offset
+ *        cycles and without expanding it into a frame table.
+ *
+ * Same properties as schedule_check() over the major cycle: every job runs
+ * once in a minor frame inside its window, no frame is overloaded or runs
+ * more than MAX_TASKS_PER_FRAME tasks, and each job runs after the
+ * predecessor jobs it depends on.
+ *
+ * @param verbose Print each violation
+ * @return Number of violations found
+ */
+uint32_t schedule_compact_check(const task_set_t *set, const compact_schedule_t *compact, bool verbose) {
+    uint8_t rank[DAG_MAX_TASKS];
+    uint32_t violations = 0;
+
+    if (compact->num_tasks != set->num_tasks || compact->major_frames == 0) {
+        if (verbose) printf("Schedule check: compact schedule does not match the task set\n");
+        return 1;
+    }
+    for (uint8_t i = 0; i < compact->num_tasks; i++) {
+        rank[compact->order[i]] = i;
+    }
+
+    /* Offsets: one run per period, inside the window (cycles hold every job's offset) */
+    for (uint8_t t = 0; t < set->num_tasks; t++) {
+        const task_desc_t *task = &set->tasks[t];
+        const compact_task_t *c = &compact->tasks[t];
+
+        if (c->cycle == 0 || c->period_frames * MINOR_FRAME_MS != task->period_ms ||
+            compact->major_frames % c->period_frames != 0 ||
+            (compact->major_frames / c->period_frames) % c->cycle != 0) {
+            if (verbose) printf("Schedule check: %s has no offset cycle for its period\n", task->name);
+            return violations + 1;
+        }
+        for (uint16_t j = 0; j < c->cycle; j++) {
+            uint16_t offset = compact->offsets[c->first + j];
+            if (offset >= c->period_frames || offset >= task->deadline_ms / MINOR_FRAME_MS) {
+                if (verbose) printf("Schedule check: %s offset %u outside its window\n", task->name, offset);
+                violations++;
+            }
+        }
+    }
+
+    for (uint32_t f = 0; f < compact->major_frames; f++) {
+        uint32_t mask = schedule_compact_frame(compact, f);
+        uint32_t load = 0;
+        uint32_t count = 0;
+
+        for (uint8_t t = 0; t < set->num_tasks; t++) {
+            if (mask & (1u << t)) {
+                load += set->tasks[t].wcet_us;
+                count++;
+            }
+        }
+        if (load > FRAME_US || count > MAX_TASKS_PER_FRAME) {
+            if (verbose) printf("Schedule check: F%02u overloaded (%u us, %u tasks)\n", f, load, count);
+            violations++;
+        }
+    }
+
+    /* Precedence: each successor job runs after the predecessor job it reads */
+    for (uint8_t e = 0; e < set->num_edges; e++) {
+        uint8_t pred = set->edges[e].pred;
+        uint8_t succ = set->edges[e].succ;
+        const compact_task_t *p = &compact->tasks[pred];
+        const compact_task_t *c = &compact->tasks[succ];
+
+        for (uint32_t k = 0; k < compact->major_frames / c->period_frames; k++) {
+            uint32_t kp = dag_pred_job(set->tasks[pred].period_ms, (uint64_t)k * set->tasks[succ].period_ms * 1000);
+            uint32_t fs = k * c->period_frames + compact->offsets[c->first + k % c->cycle];
+            uint32_t fp = kp * p->period_frames + compact->offsets[p->first + kp % p->cycle];
+            if (fp > fs || (fp == fs && rank[pred] > rank[succ])) {
+                if (verbose) printf("Schedule check: %s job %u runs before %s job %u\n",
+                                    set->tasks[succ].name, k, set->tasks[pred].name, kp);
+                violations++;
+            }
+        }
+    }
+    return violations;
+}
+/*-----------------------------------------------------------*/
+
+static uint32_t gcd32(uint32_t a, uint32_t b) {
+    while (b != 0) {
+        uint32_t r = a % b;
+        a = b;
+        b = r;
+    }
+    return a;
+}
+
+/**
+ * @brief Set up an empty compact schedule: periods in frames, major cycle
+ *        and dispatch order.
+ *
+ * @param rank Filled with the position of each task in the dispatch order
+ */
+static bool compact_init(const task_set_t *set, compact_schedule_t *compact, uint8_t *rank) {
+    if (!dag_topological_order(set->num_tasks, set->edges, set->num_edges, compact->order)) {
+        return false;
+    }
+    compact->num_tasks = set->num_tasks;
+    compact->num_offsets = 0;
+    compact->major_frames = 1;
+
+    for (uint8_t i = 0; i < set->num_tasks; i++) {
+        const task_desc_t *task = &set->tasks[i];
+        if (task->period_ms % MINOR_FRAME_MS != 0) {
+            return false;
+        }
+        uint32_t period_frames = task->period_ms / MINOR_FRAME_MS;
+        compact->tasks[i] = (compact_task_t){ .period_frames = (uint16_t)period_frames };
+        compact->major_frames = (compact->major_frames / gcd32(compact->major_frames, period_frames)) *
+                                period_frames;
+        rank[compact->order[i]] = i;
+    }
+    return true;
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Check whether job k of an unplaced task can run in frame f.
+ *
+ * The frame must lie in the job's window, keep its load within the frame
+ * and come after the frames of the predecessor jobs (or be the same frame,
+ * with the predecessor earlier in the dispatch order).
+ */
+static bool compact_fits(const task_set_t *set, const compact_schedule_t *compact, const uint8_t *rank,
+                         uint8_t t, uint32_t k, uint32_t f) {
+    const task_desc_t *task = &set->tasks[t];
+    uint32_t release = k * compact->tasks[t].period_frames;
+    uint32_t mask = schedule_compact_frame(compact, f);
+    uint32_t load = task->wcet_us;
+    uint32_t count = 1;
+
+    if (f < release || f >= release + task->deadline_ms / MINOR_FRAME_MS) {
+        return false;
+    }
+    for (uint8_t u = 0; u < set->num_tasks; u++) {
+        if (mask & (1u << u)) {
+            load += set->tasks[u].wcet_us;
+            count++;
+        }
+    }
+    if (load > FRAME_US || count > MAX_TASKS_PER_FRAME) {
+        return false;
+    }
+
+    for (uint8_t e = 0; e < set->num_edges; e++) {
+        if (set->edges[e].succ != t) {
+            continue;
+        }
+        uint8_t pred = set->edges[e].pred;
+        const compact_task_t *p = &compact->tasks[pred];
+        if (p->cycle == 0) {
+            return false;  /* Predecessors are placed first */
+        }
+        uint32_t kp = dag_pred_job(set->tasks[pred].period_ms, (uint64_t)k * task->period_ms * 1000);
+        uint32_t fp = kp * p->period_frames + compact->offsets[p->first + kp % p->cycle];
+        if (fp > f || (fp == f && rank[pred] > rank[t])) {
+            return false;
+        }
+    }
+    return true;
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Place all jobs of a task with the shortest offset cycle that fits.
+ *
+ * A cycle of one (a single offset for every job) is tried first; longer
+ * cycles that divide the task's job count follow, each job of the cycle
+ * taking the earliest offset that fits in all its repetitions.
+ */
+static bool compact_place_task(const task_set_t *set, compact_schedule_t *compact, const uint8_t *rank,
+                               uint8_t t) {
+    compact_task_t *task = &compact->tasks[t];
+    uint32_t num_jobs = compact->major_frames / task->period_frames;
+
+    for (uint32_t cycle = 1; cycle <= num_jobs; cycle++) {
+        if (num_jobs % cycle != 0 || compact->num_offsets + cycle > MAX_COMPACT_OFFSETS) {
+            continue;
+        }
+
+        bool fits = true;
+        for (uint32_t j = 0; j < cycle && fits; j++) {
+            fits = false;
+            for (uint32_t o = 0; o < task->period_frames && !fits; o++) {
+                fits = true;
+                for (uint32_t k = j; k < num_jobs && fits; k += cycle) {
+                    fits = compact_fits(set, compact, rank, t, k, k * task->period_frames + o);
+                }
+                if (fits) {
+                    compact->offsets[compact->num_offsets + j] = (uint16_t)o;
+                }
+            }
+        }
+        if (fits) {
+            task->first = compact->num_offsets;
+            task->cycle = (uint16_t)cycle;
+            compact->num_offsets += cycle;
+            return true;
+        }
+    }
+    return false;
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Build a compact schedule for a task set of any hyperperiod.
+ *
+ * Periods must be multiples of the minor frame; the major cycle is their
+ * least common multiple. Tasks are placed by increasing period,
+ * predecessors first, as for the timetable. Storage grows with the offset
+ * cycles, not with the hyperperiod.
+ *
+ * @return false if some job does not fit in its window
+ */
+bool schedule_compact_synthesize(const task_set_t *set, compact_schedule_t *compact) {
+    uint8_t rank[DAG_MAX_TASKS];
+    bool done[DAG_MAX_TASKS] = {false};
+
+    if (!compact_init(set, compact, rank)) {
+        return false;
+    }
+
+    for (uint8_t n = 0; n < set->num_tasks; n++) {
+        uint8_t next = set->num_tasks;
+        for (uint8_t t = 0; t < set->num_tasks; t++) {
+            bool ready = !done[t];
+            for (uint8_t e = 0; e < set->num_edges && ready; e++) {
+                ready = (set->edges[e].succ != t || done[set->edges[e].pred]);
+            }
+            if (ready && (next == set->num_tasks || set->tasks[t].period_ms < set->tasks[next].period_ms)) {
+                next = t;
+            }
+        }
+        if (!compact_place_task(set, compact, rank, next)) {
+            return false;
+        }
+        done[next] = true;
+    }
+    return true;
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Compress a frame table into per-task offset cycles.
+ *
+ * Each job is taken from the first frame of its period that runs the task;
+ * further runs in the same period are extra jobs and are dropped. The
+ * dispatch order within a frame becomes the precedence order.
+ *
+ * @return Number of dropped extra jobs, UINT32_MAX if a job is missing or
+ *         the offsets do not fit
+ */
+uint32_t schedule_compact_from_table(const task_set_t *set, const frame_schedule_t table[NUM_FRAMES],
+                                     compact_schedule_t *compact) {
+    uint8_t rank[DAG_MAX_TASKS];
+    uint32_t dropped = 0;
+
+    if (!compact_init(set, compact, rank) || compact->major_frames != NUM_FRAMES) {
+        return UINT32_MAX;
+    }
+    for (uint32_t f = 0; f < NUM_FRAMES; f++) {
+        if (table[f].duration_ms != 0 && table[f].duration_ms != MINOR_FRAME_MS) {
+            return UINT32_MAX;  /* Only tables of minor frames */
+        }
+    }
+
+    for (uint8_t t = 0; t < set->num_tasks; t++) {
+        compact_task_t *task = &compact->tasks[t];
+        uint32_t num_jobs = NUM_FRAMES / task->period_frames;
+        uint16_t offsets[MAX_JOBS_PER_TASK];
+        bool seen[MAX_JOBS_PER_TASK] = {false};
+
+        for (uint32_t f = 0; f < NUM_FRAMES; f++) {
+            for (uint8_t p = 0; p < table[f].num_tasks; p++) {
+                if (table[f].tasks[p] != set->tasks[t].task) {
+                    continue;
+                }
+                uint32_t k = f / task->period_frames;
+                if (seen[k]) {
+                    dropped++;
+                } else {
+                    offsets[k] = (uint16_t)(f - k * task->period_frames);
+                    seen[k] = true;
+                }
+            }
+        }
+
+        /* Shortest cycle the offsets repeat with */
+        uint32_t cycle = 1;
+        for (uint32_t k = 0; k < num_jobs; k++) {
+            if (!seen[k]) {
+                return UINT32_MAX;
+            }
+            while (offsets[k] != offsets[k % cycle] || num_jobs % cycle != 0) {
+                cycle++;
+                k = 0;
+            }
+        }
+        if (compact->num_offsets + cycle > MAX_COMPACT_OFFSETS) {
+            return UINT32_MAX;
+        }
+        memcpy(&compact->offsets[compact->num_offsets], offsets, cycle * sizeof(uint16_t));
+        task->first = compact->num_offsets;
+        task->cycle = (uint16_t)cycle;
+        compact->num_offsets += cycle;
+    }
+    return dropped;
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Property check of synthesis and checking on random task sets.
+ *
+ * Each task set has 2-6 tasks with periods dividing the hyperperiod,
+ * deadlines of whole frames up to the period, random WCETs and random
+ * forward precedence edges. The properties are:
+ *  - a set with utilization above 100% is never synthesized,
+ *  - a synthesized table passes schedule_check(),
+ *  - removing a job from a synthesized table makes schedule_check() fail,
+ *  - a table with frames of their own lengths passes schedule_check().
+ * The first counterexample is printed.
+ *
+ * @param synthesized Number of task sets that could be synthesized
+ * @return Number of task sets violating a property
+ */
+uint32_t schedule_fuzz(uint32_t iterations, uint32_t seed, uint32_t *synthesized) {
+    static const uint32_t periods_ms[] = { 5, 10, 20, 25, 50, 100 };
+    static const task_func_t funcs[DAG_MAX_TASKS] = { job_A, job_B, job_C, job_D, job_E, job_F };
+    static const char* names[DAG_MAX_TASKS] = { "T0", "T1", "T2", "T3", "T4", "T5" };
+    static frame_schedule_t table[NUM_FRAMES];
+    task_desc_t tasks[DAG_MAX_TASKS];
+    dag_edge_t edges[DAG_MAX_TASKS * (DAG_MAX_TASKS - 1) / 2];
+    uint32_t state = (seed != 0) ? seed : 1;
+    uint32_t failures = 0;
+
+    *synthesized = 0;
+
+    for (uint32_t it = 0; it < iterations; it++) {
+        task_set_t set = { .tasks = tasks, .edges = edges };
+        uint8_t num_tasks = (uint8_t)fuzz_range(&state, 2, 6);
+        uint8_t num_edges = 0;
+        uint64_t demand_us = 0;
+
+        for (uint8_t t = 0; t < num_tasks; t++) {
+            uint32_t period = periods_ms[fuzz_rand(&state) % 6];
+            tasks[t].task = funcs[t];
+            tasks[t].name = names[t];
+            tasks[t].period_ms = period;
+            tasks[t].deadline_ms = MINOR_FRAME_MS * fuzz_range(&state, 1, period / MINOR_FRAME_MS);
+            tasks[t].wcet_us = fuzz_range(&state, 100, FRAME_US - 1000);
+            demand_us += (uint64_t)tasks[t].wcet_us * (HYPERPERIOD_MS / period);
+
+            for (uint8_t p = 0; p < t; p++) {
+                if ((fuzz_rand(&state) & 3) == 0) {
+                    edges[num_edges].pred = p;
+                    edges[num_edges].succ = t;
+                    num_edges++;
+                }
+            }
+        }
+        set.num_tasks = num_tasks;
+        set.num_edges = num_edges;
+
+        if (!schedule_synthesize(&set, table)) {
+            continue;
+        }
+        (*synthesized)++;
+
+        const char* property = NULL;
+        if (demand_us > (uint64_t)HYPERPERIOD_MS * 1000) {
+            property = "overloaded set synthesized";
+        } else if (schedule_check(&set, table, false) != 0) {
+            property = "synthesized table fails the check";
+        } else {
+            /* Drop one job: the checker has to notice */
+            uint32_t f = fuzz_rand(&state) % NUM_FRAMES;
+            while (table[f].num_tasks == 0) {
+                f = (f + 1) % NUM_FRAMES;
+            }
+            uint8_t p = (uint8_t)(fuzz_rand(&state) % table[f].num_tasks);
+            table[f].num_tasks--;
+            memmove(&table[f].tasks[p], &table[f].tasks[p + 1],
+                    (table[f].num_tasks - p) * sizeof(task_func_t));
+            memmove(&table[f].names[p], &table[f].names[p + 1],
+                    (table[f].num_tasks - p) * sizeof(const char*));
+            if (schedule_check(&set, table, false) == 0) {
+                property = "checker misses a dropped job";
+            }
+        }
+        if (property == NULL && schedule_synthesize_frames(&set, table) &&
+            schedule_check(&set, table, false) != 0) {
+            property = "non-uniform table fails the check";
+        }
+
+        if (property != NULL) {
+            if (failures == 0) {
+                printf("Schedule fuzz: iteration %u: %s\n", it, property);
+                for (uint8_t t = 0; t < num_tasks; t++) {
+                    printf("  %s: T=%u ms, D=%u ms, C=%u us\n", tasks[t].name,
+                           tasks[t].period_ms, tasks[t].deadline_ms, tasks[t].wcet_us);
+                }
+                for (uint8_t e = 0; e < num_edges; e++) {
+                    printf("  %s -> %s\n", tasks[edges[e].pred].name, tasks[edges[e].succ].name);
+                }
+            }
+            failures++;
+        }
+    }
+    return failures;
+}
+/*-----------------------------------------------------------*/
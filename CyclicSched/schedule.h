@@ -0,0 +1,84 @@
+#ifndef SCHEDULE_H
+#define SCHEDULE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "workload.h"
+#include "dag.h"
+
+/* Cyclic scheduler parameters */
+#define MINOR_FRAME_MS 5      /* Minor frame duration: 5ms */
+#define HYPERPERIOD_MS 100    /* Hyperperiod: 100ms */
+#define NUM_FRAMES 20         /* Number of frames in hyperperiod */
+#define MAX_TASKS_PER_FRAME 4 /* Maximum tasks in a single frame */
+#define MAX_TIMETABLE_ENTRIES 64  /* Jobs per hyperperiod in the time-triggered table */
+#define TIMETABLE_GAP_US 50       /* Time kept free after each job for dispatch and logging */
+#define MAX_COMPACT_OFFSETS 32    /* Frame offsets shared by all tasks of a compact schedule */
+
+/* Task function pointer type */
+typedef void (*task_func_t)(jobReturn_t*);
+
+/* Frame schedule structure - defines which tasks run in each frame */
+typedef struct {
+    task_func_t tasks[MAX_TASKS_PER_FRAME];  /* Task functions to execute */
+    const char* names[MAX_TASKS_PER_FRAME];   /* Task names for logging */
+    uint8_t num_tasks;                         /* Number of tasks in this frame */
+    uint16_t duration_ms;                      /* Frame length; 0 = MINOR_FRAME_MS */
+} frame_schedule_t;
+
+/* Periodic task descriptor */
+typedef struct {
+    task_func_t task;        /* Workload function */
+    const char* name;        /* Task name for logging */
+    uint32_t period_ms;      /* Period */
+    uint32_t deadline_ms;    /* Relative deadline */
+    uint32_t wcet_us;        /* Execution time budget used for synthesis */
+} task_desc_t;
+
+/* Time-triggered table entry: one job and its exact start in the hyperperiod */
+typedef struct {
+    uint32_t start_us;       /* Relative to the hyperperiod start */
+    uint8_t task;            /* Index into the task set */
+    uint8_t job;             /* Job of the task in the hyperperiod */
+} timetable_entry_t;
+
+/* Task of a compact schedule: job k runs in frame k * period_frames +
+ * offsets[first + k % cycle], so a task keeping one offset costs a single
+ * entry however long the hyperperiod is */
+typedef struct {
+    uint16_t period_frames;
+    uint16_t cycle;          /* Jobs before the offsets repeat */
+    uint16_t first;          /* First offset of the task in compact_schedule_t.offsets */
+} compact_task_t;
+
+/* Compact schedule: per-task offset cycles nested in the major cycle */
+typedef struct {
+    compact_task_t tasks[DAG_MAX_TASKS];
+    uint8_t order[DAG_MAX_TASKS];          /* Dispatch order within a frame (precedence) */
+    uint16_t offsets[MAX_COMPACT_OFFSETS];
+    uint16_t num_offsets;
+    uint8_t num_tasks;
+    uint32_t major_frames;                 /* Hyperperiod of the task set in frames */
+} compact_schedule_t;
+
+/* Task set: descriptors plus precedence edges (indices into tasks) */
+typedef struct {
+    const task_desc_t *tasks;
+    uint8_t num_tasks;
+    const dag_edge_t *edges;
+    uint8_t num_edges;
+} task_set_t;
+
+bool schedule_synthesize(const task_set_t *set, frame_schedule_t table[NUM_FRAMES]);
+bool schedule_synthesize_frames(const task_set_t *set, frame_schedule_t table[NUM_FRAMES]);
+uint32_t schedule_frame_starts(const frame_schedule_t table[NUM_FRAMES], uint32_t starts_us[NUM_FRAMES + 1]);
+uint32_t schedule_check(const task_set_t *set, const frame_schedule_t table[NUM_FRAMES], bool verbose);
+uint32_t schedule_timetable(const task_set_t *set, timetable_entry_t *table, uint32_t max_entries);
+bool schedule_compact_synthesize(const task_set_t *set, compact_schedule_t *compact);
+uint32_t schedule_compact_from_table(const task_set_t *set, const frame_schedule_t table[NUM_FRAMES],
+                                     compact_schedule_t *compact);
+uint32_t schedule_compact_frame(const compact_schedule_t *compact, uint32_t frame);
+uint32_t schedule_compact_check(const task_set_t *set, const compact_schedule_t *compact, bool verbose);
+uint32_t schedule_fuzz(uint32_t iterations, uint32_t seed, uint32_t *synthesized);
+
+#endif /* SCHEDULE_H */
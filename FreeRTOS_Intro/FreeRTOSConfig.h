@@ -77,8 +77,12 @@
 #define configAPPLICATION_ALLOCATED_HEAP        0
 #define configKERNEL_PROVIDED_STATIC_MEMORY     1
 
-/* Hook function related definitions. */
+/* Hook function related definitions. Stack overflows are caught by the
+ * PSPLIM stack limit without a per-switch cost (common/crash_log.c); the
+ * software check can be selected by the build to compare its cost. */
+#ifndef configCHECK_FOR_STACK_OVERFLOW
 #define configCHECK_FOR_STACK_OVERFLOW          0
+#endif
 #define configUSE_MALLOC_FAILED_HOOK            0
 #define configUSE_DAEMON_TASK_STARTUP_HOOK      0
 
@@ -0,0 +1,225 @@
+/**
+ * @file alloc_bench.c
+ * @brief Allocation benchmark: the fixed-block pool against heap_4
+ *        (pvPortMalloc/vPortFree) under three churn patterns.
+ *
+ *  - messages: a FIFO of in-flight payloads of 8..64 bytes, the oldest
+ *    freed when a new one arrives,
+ *  - trace: per period a burst of 48-byte records, all freed by the report,
+ *  - mixed: 8..256 byte blocks allocated and freed in random order.
+ * Every call is timed with the cycle counter; the maximum includes any
+ * interrupt that lands in it, for both allocators alike. Fragmentation is
+ * the worst seen during the run: for heap_4 the free space outside the
+ * largest free block, for the pool the unused bytes of the blocks in use.
+ * Results are printed as CSV lines starting with "ALLOC,".
+ */
+#include <stdio.h>
+#include "FreeRTOS.h"
+#include "task.h"
+#include "pool.h"
+#include "fuzz.h"
+#include "workload.h"
+#include "benchmarks.h"
+
+#define ALLOC_SLOTS 32             /* Live blocks a pattern holds at most */
+#define ALLOC_OPS 2000             /* Allocations per pattern */
+#define MESSAGE_DEPTH 8            /* In-flight messages */
+#define TRACE_RECORD_BYTES 48
+#define TRACE_RECORDS 24           /* Records per period */
+#define ALLOC_SEED 0x2545F491u
+
+typedef enum {
+    PATTERN_MESSAGES,
+    PATTERN_TRACE,
+    PATTERN_MIXED,
+    NUM_PATTERNS
+} alloc_pattern_t;
+
+static const char* pattern_names[NUM_PATTERNS] = { "messages", "trace", "mixed" };
+
+typedef struct {
+    const char* name;
+    void *(*alloc)(size_t size);
+    void (*free)(void *block);
+    bool is_pool;
+} allocator_t;
+
+static const allocator_t allocators[] = {
+    { "pool",   pool_alloc,   pool_free, true },
+    { "heap_4", pvPortMalloc, vPortFree, false },
+};
+#define NUM_ALLOCATORS (sizeof(allocators) / sizeof(allocators[0]))
+
+/* Results of one pattern on one allocator, in cycles */
+typedef struct {
+    uint32_t allocs;
+    uint32_t frees;
+    uint64_t alloc_total;
+    uint32_t alloc_max;
+    uint64_t free_total;
+    uint32_t free_max;
+    uint32_t failures;
+    uint32_t frag_max_permille;
+} alloc_result_t;
+
+/* Live blocks and the size each was requested with */
+static void *slots[ALLOC_SLOTS];
+static uint16_t requested[ALLOC_SLOTS];
+static uint32_t requested_bytes;
+static uint32_t block_bytes;
+
+/**
+ * @brief Fragmentation of the allocator's current state in permille.
+ */
+static uint32_t fragmentation(const allocator_t *a) {
+    if (a->is_pool) {
+        return (block_bytes > 0) ? ((block_bytes - requested_bytes) * 1000) / block_bytes : 0;
+    }
+    HeapStats_t heap;
+    vPortGetHeapStats(&heap);
+    if (heap.xAvailableHeapSpaceInBytes == 0) {
+        return 0;
+    }
+    return ((heap.xAvailableHeapSpaceInBytes - heap.xSizeOfLargestFreeBlockInBytes) * 1000) /
+           heap.xAvailableHeapSpaceInBytes;
+}
+/*-----------------------------------------------------------*/
+
+static void timed_alloc(const allocator_t *a, uint32_t slot, uint32_t size, alloc_result_t *r) {
+    uint32_t start = bench_cycles();
+    void *block = a->alloc(size);
+    uint32_t cycles = bench_cycles() - start;
+
+    r->allocs++;
+    r->alloc_total += cycles;
+    if (cycles > r->alloc_max) {
+        r->alloc_max = cycles;
+    }
+    if (block == NULL) {
+        r->failures++;
+        return;
+    }
+    slots[slot] = block;
+    requested[slot] = (uint16_t)size;
+    requested_bytes += size;
+    block_bytes += a->is_pool ? pool_block_size(block) : size;
+
+    uint32_t frag = fragmentation(a);
+    if (frag > r->frag_max_permille) {
+        r->frag_max_permille = frag;
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void timed_free(const allocator_t *a, uint32_t slot, alloc_result_t *r) {
+    void *block = slots[slot];
+
+    if (block == NULL) {
+        return;
+    }
+    requested_bytes -= requested[slot];
+    block_bytes -= a->is_pool ? pool_block_size(block) : requested[slot];
+
+    uint32_t start = bench_cycles();
+    a->free(block);
+    uint32_t cycles = bench_cycles() - start;
+
+    slots[slot] = NULL;
+    r->frees++;
+    r->free_total += cycles;
+    if (cycles > r->free_max) {
+        r->free_max = cycles;
+    }
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Run one pattern; every block is freed at the end.
+ */
+static void run_pattern(alloc_pattern_t pattern, const allocator_t *a, alloc_result_t *r) {
+    uint32_t rng = ALLOC_SEED;  /* Same sequence for both allocators */
+
+    switch (pattern) {
+    case PATTERN_MESSAGES:
+        for (uint32_t i = 0; i < ALLOC_OPS; i++) {
+            uint32_t slot = i % MESSAGE_DEPTH;
+            timed_free(a, slot, r);
+            timed_alloc(a, slot, fuzz_range(&rng, 8, 64), r);
+        }
+        break;
+    case PATTERN_TRACE:
+        for (uint32_t i = 0; i < ALLOC_OPS / TRACE_RECORDS; i++) {
+            for (uint32_t slot = 0; slot < TRACE_RECORDS; slot++) {
+                timed_alloc(a, slot, TRACE_RECORD_BYTES, r);
+            }
+            for (uint32_t slot = 0; slot < TRACE_RECORDS; slot++) {
+                timed_free(a, slot, r);
+            }
+        }
+        break;
+    case PATTERN_MIXED:
+        while (r->allocs < ALLOC_OPS) {
+            uint32_t slot = fuzz_rand(&rng) % ALLOC_SLOTS;
+            if (slots[slot] != NULL) {
+                timed_free(a, slot, r);
+            } else {
+                timed_alloc(a, slot, fuzz_range(&rng, 8, POOL_MAX_BLOCK), r);
+            }
+        }
+        break;
+    default:
+        break;
+    }
+
+    for (uint32_t slot = 0; slot < ALLOC_SLOTS; slot++) {
+        timed_free(a, slot, r);
+    }
+}
+/*-----------------------------------------------------------*/
+
+static uint32_t pool_fallbacks(void) {
+    uint32_t total = 0;
+
+    for (uint8_t c = 0; c < POOL_NUM_CLASSES; c++) {
+        pool_stats_t stats;
+        pool_get_stats(c, &stats);
+        total += stats.fallbacks;
+    }
+    return total;
+}
+/*-----------------------------------------------------------*/
+
+static uint32_t cycles_to_ns(uint64_t cycles) {
+    return (uint32_t)((cycles * 1000) / CYCLES_PER_US);
+}
+
+/**
+ * @brief Every pattern on every allocator, one CSV line each.
+ */
+void alloc_benchmark(void) {
+    pool_init();
+
+    printf("Allocation: %u allocations per pattern, at most %u live blocks\n", ALLOC_OPS, ALLOC_SLOTS);
+    printf("ALLOC,pattern,allocator,allocs,alloc_avg_ns,alloc_max_ns,free_avg_ns,free_max_ns,"
+           "frag_max_permille,fallbacks,failures\n");
+    for (alloc_pattern_t p = 0; p < NUM_PATTERNS; p++) {
+        for (uint32_t i = 0; i < NUM_ALLOCATORS; i++) {
+            const allocator_t *a = &allocators[i];
+            alloc_result_t r = {0};
+            uint32_t fallbacks = pool_fallbacks();
+
+            requested_bytes = 0;
+            block_bytes = 0;
+            run_pattern(p, a, &r);
+            fallbacks = a->is_pool ? pool_fallbacks() - fallbacks : 0;
+
+            printf("ALLOC,%s,%s,%u,%u,%u,%u,%u,%u,%u,%u\n", pattern_names[p], a->name, r.allocs,
+                   cycles_to_ns(r.alloc_total / r.allocs), cycles_to_ns(r.alloc_max),
+                   cycles_to_ns((r.frees > 0) ? r.free_total / r.frees : 0), cycles_to_ns(r.free_max),
+                   r.frag_max_permille, fallbacks, r.failures);
+        }
+    }
+    pool_print();
+    printf("ALLOC,done (heap_4 free %u bytes)\n", (unsigned)xPortGetFreeHeapSize());
+}
+/*-----------------------------------------------------------*/
@@ -0,0 +1,116 @@
+/**
+ * @file bench_main.c
+ * @brief FreeRTOS benchmark target: runs the enabled suites from a
+ *        controller task with the FreeRTOS_Intro kernel configuration.
+ */
+#include <stdio.h>
+#include "FreeRTOS.h"
+#include "task.h"
+#include "bsp.h"
+#include "hardware/structs/m33.h"
+#include "crash_log.h"
+#include "benchmarks.h"
+
+/*************************************************************/
+
+/* Benchmark suites to run (1 = enabled) */
+#define RUN_ITC_BENCH   1
+#define RUN_ALLOC_BENCH 1
+#define RUN_SWITCH_BENCH 1
+
+/**
+ * @brief Cycle counter of the calling core.
+ */
+uint32_t bench_cycles(void) {
+    return m33_hw->dwt_cyccnt;
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Enable the cycle counter of the calling core.
+ */
+void bench_cycle_counter_enable(void) {
+    m33_hw->demcr |= M33_DEMCR_TRCENA_BITS;
+    m33_hw->dwt_ctrl |= M33_DWT_CTRL_CYCCNTENA_BITS;
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Create a task pinned to a core (any core in the single-core build).
+ */
+TaskHandle_t bench_create_on_core(TaskFunction_t fn, const char* name, UBaseType_t priority, uint8_t core) {
+    TaskHandle_t handle;
+#if configNUMBER_OF_CORES > 1
+    xTaskCreateAffinitySet(fn, name, BENCH_STACK_WORDS, NULL, priority, (1 << core), &handle);
+#else
+    (void)core;
+    xTaskCreate(fn, name, BENCH_STACK_WORDS, NULL, priority, &handle);
+#endif
+    return handle;
+}
+/*-----------------------------------------------------------*/
+
+#if configCHECK_FOR_STACK_OVERFLOW
+/**
+ * @brief Software stack check of the kernel (PSPLIM normally faults first)
+ */
+void vApplicationStackOverflowHook(TaskHandle_t xTask, char *pcTaskName) {
+    crash_log_record(CRASH_STACK_OVERFLOW_SW, pcTaskName);
+}
+/*-----------------------------------------------------------*/
+#endif
+
+static const char *current_task_name(void) {
+    return pcTaskGetName(NULL);
+}
+/*-----------------------------------------------------------*/
+
+static void controller_task(void *arg) {
+    bench_cycle_counter_enable();
+
+#if RUN_SWITCH_BENCH
+    switch_benchmark();
+#endif
+
+#if RUN_ALLOC_BENCH
+    alloc_benchmark();
+#endif
+#if RUN_ITC_BENCH
+    itc_benchmark();
+#endif
+
+    printf("Benchmarks done\n");
+    while (true) {
+        vTaskDelay(pdMS_TO_TICKS(1000));
+    }
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Main function.
+ *
+ * @return int
+ */
+int main()
+{
+    BSP_Init();  /* Initialize all components on the lab-kit. */
+
+    printf("\n========================================\n");
+    printf("FreeRTOS Benchmarks Started (%u core(s))\n", configNUMBER_OF_CORES);
+    printf("========================================\n");
+
+    crash_log_init(current_task_name, true);
+    crash_log_print();
+
+    bench_create_on_core(controller_task, "Bench_Ctrl", BENCH_CONTROL_PRIORITY, 0);
+
+    vTaskStartScheduler();
+
+    /* Should never reach here */
+    while (true) {
+        sleep_ms(1000);
+    }
+
+    return 0;
+}
+/*-----------------------------------------------------------*/
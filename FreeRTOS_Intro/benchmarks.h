@@ -0,0 +1,22 @@
+#ifndef BENCHMARKS_H
+#define BENCHMARKS_H
+
+#include <stdint.h>
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* Benchmark suites of the FreeRTOS_Bench target; each runs in the
+ * controller task and prints CSV lines with its own prefix */
+
+#define BENCH_CONTROL_PRIORITY (configMAX_PRIORITIES - 2)  /* Above the measured tasks, below the timer task */
+#define BENCH_STACK_WORDS 1024
+
+uint32_t bench_cycles(void);
+void bench_cycle_counter_enable(void);
+TaskHandle_t bench_create_on_core(TaskFunction_t fn, const char* name, UBaseType_t priority, uint8_t core);
+
+void itc_benchmark(void);
+void alloc_benchmark(void);
+void switch_benchmark(void);
+
+#endif /* BENCHMARKS_H */
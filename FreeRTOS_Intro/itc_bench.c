@@ -0,0 +1,369 @@
+/**
+ * @file itc_bench.c
+ * @brief Inter-task communication benchmark: FreeRTOS queues, stream
+ *        buffers, message buffers, direct-to-task notifications and a
+ *        lock-free single-producer single-consumer ring, at several payload
+ *        sizes between tasks of different priorities and, in the SMP build,
+ *        across cores.
+ *
+ * Part of the FreeRTOS_Bench target. For every primitive, payload and scenario it measures
+ *  - latency: half the round trip of a ping-pong over two channels, timed
+ *    with the cycle counter of the pinging task's core,
+ *  - throughput: a burst of messages until the receiver has them all,
+ *  - worst-case blocking: the longest send call of the burst, which
+ *    includes waiting for space and the switches to the receiver.
+ * Results are printed as CSV lines starting with "ITC,".
+ */
+#include <stdio.h>
+#include <string.h>
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "semphr.h"
+#include "stream_buffer.h"
+#include "message_buffer.h"
+#include "bsp.h"
+#include "hardware/sync.h"
+#include "workload.h"
+#include "benchmarks.h"
+
+#define ITC_MAX_PAYLOAD 256        /* Largest payload in bytes */
+#define ITC_DEPTH 8                /* Messages a channel holds */
+#define ITC_PING_PONGS 200         /* Round trips per latency measurement */
+#define ITC_BURST 1000             /* Messages per throughput measurement */
+
+typedef enum {
+    ITC_QUEUE,
+    ITC_STREAM_BUFFER,
+    ITC_MESSAGE_BUFFER,
+    ITC_NOTIFY,
+    ITC_SPSC_RING,
+    ITC_NUM_PRIMITIVES
+} itc_primitive_t;
+
+static const char* primitive_names[ITC_NUM_PRIMITIVES] = {
+    "queue", "stream_buffer", "message_buffer", "notify", "spsc_ring"
+};
+
+static const uint32_t payload_sizes[] = { 4, 16, 64, ITC_MAX_PAYLOAD };
+#define NUM_PAYLOAD_SIZES (sizeof(payload_sizes) / sizeof(payload_sizes[0]))
+
+/* Sender and receiver placement */
+typedef struct {
+    const char* name;
+    UBaseType_t tx_priority;
+    UBaseType_t rx_priority;
+    uint8_t tx_core;
+    uint8_t rx_core;
+} itc_scenario_t;
+
+static const itc_scenario_t scenarios[] = {
+    { "low_to_high", 2, 3, 0, 0 },  /* The receiver preempts the sender on each message */
+    { "high_to_low", 3, 2, 0, 0 },  /* The receiver runs once the sender blocks */
+#if configNUMBER_OF_CORES > 1
+    { "cross_core",  2, 2, 0, 1 },
+#endif
+};
+#define NUM_SCENARIOS (sizeof(scenarios) / sizeof(scenarios[0]))
+
+/* Lock-free single-producer single-consumer ring: the producer only writes
+ * head, the consumer only writes tail. An empty ring puts the consumer to
+ * sleep on its task notification, a full one the producer on its own. */
+typedef struct {
+    uint8_t slots[ITC_DEPTH][ITC_MAX_PAYLOAD];
+    volatile uint32_t head;
+    volatile uint32_t tail;
+    volatile bool producer_waiting;
+} spsc_ring_t;
+
+/* One direction of communication */
+typedef struct {
+    itc_primitive_t kind;
+    uint32_t size;
+    QueueHandle_t queue;
+    StreamBufferHandle_t stream;      /* Stream and message buffers */
+    SemaphoreHandle_t slot_free;      /* Notifications: the mailbox can be written */
+    uint8_t slot[ITC_MAX_PAYLOAD];    /* Notifications: payloads above 4 bytes */
+    spsc_ring_t ring;
+    TaskHandle_t producer;
+    TaskHandle_t consumer;
+} channel_t;
+
+/* Results of one configuration, in cycles */
+typedef struct {
+    uint32_t rtt_min;
+    uint32_t rtt_max;
+    uint64_t rtt_total;
+    uint32_t burst;
+    uint32_t send_max;
+} itc_result_t;
+
+static channel_t forward;   /* Sender to receiver */
+static channel_t backward;  /* Receiver to sender, ping-pong replies */
+static itc_result_t result;
+static SemaphoreHandle_t rx_done;  /* The receiver has the whole burst */
+static SemaphoreHandle_t tx_done;  /* The configuration is measured */
+
+static void channel_create(channel_t *ch, itc_primitive_t kind, uint32_t size) {
+    memset(ch, 0, sizeof(*ch));
+    ch->kind = kind;
+    ch->size = size;
+
+    switch (kind) {
+    case ITC_QUEUE:
+        ch->queue = xQueueCreate(ITC_DEPTH, size);
+        break;
+    case ITC_STREAM_BUFFER:
+        /* Trigger level of one message: the receiver wakes on whole payloads */
+        ch->stream = xStreamBufferCreate(ITC_DEPTH * size, size);
+        break;
+    case ITC_MESSAGE_BUFFER:
+        ch->stream = xMessageBufferCreate(ITC_DEPTH * (size + sizeof(size_t)));
+        break;
+    case ITC_NOTIFY:
+        ch->slot_free = xSemaphoreCreateBinary();
+        xSemaphoreGive(ch->slot_free);
+        break;
+    default:
+        break;
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void channel_delete(channel_t *ch) {
+    switch (ch->kind) {
+    case ITC_QUEUE:
+        vQueueDelete(ch->queue);
+        break;
+    case ITC_STREAM_BUFFER:
+        vStreamBufferDelete(ch->stream);
+        break;
+    case ITC_MESSAGE_BUFFER:
+        vMessageBufferDelete(ch->stream);
+        break;
+    case ITC_NOTIFY:
+        vSemaphoreDelete(ch->slot_free);
+        break;
+    default:
+        break;
+    }
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Send one payload, blocking while the channel is full.
+ */
+static void channel_send(channel_t *ch, const uint8_t *data) {
+    switch (ch->kind) {
+    case ITC_QUEUE:
+        xQueueSend(ch->queue, data, portMAX_DELAY);
+        break;
+    case ITC_STREAM_BUFFER:
+        xStreamBufferSend(ch->stream, data, ch->size, portMAX_DELAY);
+        break;
+    case ITC_MESSAGE_BUFFER:
+        xMessageBufferSend(ch->stream, data, ch->size, portMAX_DELAY);
+        break;
+    case ITC_NOTIFY: {
+        /* Up to 4 bytes travel in the notification value, larger payloads
+         * through the mailbox it signals */
+        uint32_t value = 0;
+        xSemaphoreTake(ch->slot_free, portMAX_DELAY);
+        if (ch->size <= sizeof(value)) {
+            memcpy(&value, data, ch->size);
+        } else {
+            memcpy(ch->slot, data, ch->size);
+        }
+        xTaskNotify(ch->consumer, value, eSetValueWithOverwrite);
+        break;
+    }
+    case ITC_SPSC_RING: {
+        spsc_ring_t *ring = &ch->ring;
+        while (ring->head - ring->tail == ITC_DEPTH) {
+            ring->producer_waiting = true;
+            __dmb();
+            if (ring->head - ring->tail == ITC_DEPTH) {
+                ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+            }
+        }
+        memcpy(ring->slots[ring->head % ITC_DEPTH], data, ch->size);
+        __dmb();
+        ring->head++;
+        xTaskNotifyGive(ch->consumer);
+        break;
+    }
+    default:
+        break;
+    }
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Receive one payload, blocking while the channel is empty.
+ */
+static void channel_receive(channel_t *ch, uint8_t *data) {
+    switch (ch->kind) {
+    case ITC_QUEUE:
+        xQueueReceive(ch->queue, data, portMAX_DELAY);
+        break;
+    case ITC_STREAM_BUFFER:
+        /* A stream may return part of a payload */
+        for (size_t got = 0; got < ch->size;) {
+            got += xStreamBufferReceive(ch->stream, data + got, ch->size - got, portMAX_DELAY);
+        }
+        break;
+    case ITC_MESSAGE_BUFFER:
+        xMessageBufferReceive(ch->stream, data, ch->size, portMAX_DELAY);
+        break;
+    case ITC_NOTIFY: {
+        uint32_t value;
+        xTaskNotifyWait(0, UINT32_MAX, &value, portMAX_DELAY);
+        if (ch->size <= sizeof(value)) {
+            memcpy(data, &value, ch->size);
+        } else {
+            memcpy(data, ch->slot, ch->size);
+        }
+        xSemaphoreGive(ch->slot_free);
+        break;
+    }
+    case ITC_SPSC_RING: {
+        spsc_ring_t *ring = &ch->ring;
+        while (ring->head == ring->tail) {
+            ulTaskNotifyTake(pdTRUE, portMAX_DELAY);  /* Stale counts only cost a loop */
+        }
+        __dmb();
+        memcpy(data, ring->slots[ring->tail % ITC_DEPTH], ch->size);
+        __dmb();
+        ring->tail++;
+        __dmb();
+        if (ring->producer_waiting) {
+            ring->producer_waiting = false;
+            xTaskNotifyGive(ch->producer);
+        }
+        break;
+    }
+    default:
+        break;
+    }
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Sender: ping-pong for the latency, then a burst for the
+ *        throughput and the blocking time.
+ */
+static void tx_task(void *arg) {
+    uint8_t msg[ITC_MAX_PAYLOAD] = {0};
+
+    bench_cycle_counter_enable();
+    result.rtt_min = UINT32_MAX;
+
+    for (uint32_t i = 0; i < ITC_PING_PONGS; i++) {
+        msg[0] = (uint8_t)i;
+        uint32_t start = bench_cycles();
+        channel_send(&forward, msg);
+        channel_receive(&backward, msg);
+        uint32_t rtt = bench_cycles() - start;
+
+        result.rtt_total += rtt;
+        if (rtt < result.rtt_min) {
+            result.rtt_min = rtt;
+        }
+        if (rtt > result.rtt_max) {
+            result.rtt_max = rtt;
+        }
+    }
+
+    uint32_t burst_start = bench_cycles();
+    for (uint32_t i = 0; i < ITC_BURST; i++) {
+        uint32_t call = bench_cycles();
+        channel_send(&forward, msg);
+        call = bench_cycles() - call;
+        if (call > result.send_max) {
+            result.send_max = call;
+        }
+    }
+    xSemaphoreTake(rx_done, portMAX_DELAY);
+    result.burst = bench_cycles() - burst_start;
+
+    xSemaphoreGive(tx_done);
+    vTaskSuspend(NULL);  /* Deleted by the controller */
+}
+/*-----------------------------------------------------------*/
+
+static void rx_task(void *arg) {
+    uint8_t msg[ITC_MAX_PAYLOAD];
+
+    for (uint32_t i = 0; i < ITC_PING_PONGS; i++) {
+        channel_receive(&forward, msg);
+        channel_send(&backward, msg);
+    }
+    for (uint32_t i = 0; i < ITC_BURST; i++) {
+        channel_receive(&forward, msg);
+    }
+    xSemaphoreGive(rx_done);
+    vTaskSuspend(NULL);
+}
+/*-----------------------------------------------------------*/
+
+static uint64_t cycles_to_ns(uint64_t cycles) {
+    return (cycles * 1000) / CYCLES_PER_US;
+}
+
+/**
+ * @brief Measure one primitive, payload and scenario and print its CSV line.
+ */
+static void run_configuration(itc_primitive_t kind, uint32_t size, const itc_scenario_t *scenario) {
+    memset(&result, 0, sizeof(result));
+    channel_create(&forward, kind, size);
+    channel_create(&backward, kind, size);
+
+    /* The tasks start once the controller blocks (the receiver on core 1
+     * at once, and waits on its channel) */
+    TaskHandle_t rx = bench_create_on_core(rx_task, "ITC_RX", scenario->rx_priority, scenario->rx_core);
+    forward.consumer = rx;
+    backward.producer = rx;
+    TaskHandle_t tx = bench_create_on_core(tx_task, "ITC_TX", scenario->tx_priority, scenario->tx_core);
+    forward.producer = tx;
+    backward.consumer = tx;
+
+    xSemaphoreTake(tx_done, portMAX_DELAY);
+    vTaskDelete(tx);
+    vTaskDelete(rx);
+    channel_delete(&forward);
+    channel_delete(&backward);
+    vTaskDelay(1);  /* The idle task frees the deleted tasks */
+
+    uint64_t bytes = (uint64_t)ITC_BURST * size;
+    printf("ITC,%s,%u,%s,%llu,%llu,%llu,%llu,%llu\n", primitive_names[kind], size, scenario->name,
+           cycles_to_ns(result.rtt_min / 2), cycles_to_ns(result.rtt_total / (2 * ITC_PING_PONGS)),
+           cycles_to_ns(result.rtt_max / 2),
+           (result.burst > 0) ? (bytes * CYCLES_PER_US * 1000) / result.burst : 0,
+           cycles_to_ns(result.send_max));
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Every primitive, payload and scenario, one CSV line each.
+ */
+void itc_benchmark(void) {
+    rx_done = xSemaphoreCreateBinary();
+    tx_done = xSemaphoreCreateBinary();
+
+    printf("Inter-task communication: depth %u messages, %u round trips, bursts of %u\n",
+           ITC_DEPTH, ITC_PING_PONGS, ITC_BURST);
+    printf("ITC,primitive,payload_bytes,scenario,latency_min_ns,latency_avg_ns,latency_max_ns,"
+           "throughput_kBps,send_block_max_ns\n");
+    for (uint32_t s = 0; s < NUM_SCENARIOS; s++) {
+        for (itc_primitive_t kind = 0; kind < ITC_NUM_PRIMITIVES; kind++) {
+            for (uint32_t p = 0; p < NUM_PAYLOAD_SIZES; p++) {
+                run_configuration(kind, payload_sizes[p], &scenarios[s]);
+            }
+        }
+    }
+    printf("ITC,done\n");
+
+    vSemaphoreDelete(rx_done);
+    vSemaphoreDelete(tx_done);
+}
+/*-----------------------------------------------------------*/
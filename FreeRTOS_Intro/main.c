@@ -6,12 +6,84 @@
 #include "semphr.h"
 #include "bsp.h"
 #include "workload.h"
+#include "let.h"
+#include "dag.h"
+#include "forkjoin.h"
+#include "rta.h"
+#include "fuzz.h"
+#include "fault.h"
+#include "pwcet_budgets.h"
+#include "isr_load.h"
+#include "deadline_alarm.h"
+#include "crash_log.h"
+#include "fpu_context.h"
+#include "overload.h"
+#include "trace_budget.h"
 
 /*************************************************************/
 
 /* Hyperperiod in milliseconds: LCM(5, 10, 20, 25, 50) = 100ms */
 #define HYPERPERIOD_MS 100
 #define MAX_LOGS_PER_HYPERPERIOD 50  /* Buffer size for logs */
+#define ENABLE_FORK_JOIN 0           /* 1: split Task_E between Task_E and a worker on core 1 */
+#define ENABLE_SEMI_PARTITIONING 0   /* 1: dual-core build partitions the tasks and splits Task_C */
+#define SPLIT_PORTION_PRIORITY 7     /* First portion of a split task: above all periodic tasks */
+#define USE_PWCET_BUDGETS 0          /* 1: response-time analysis uses pwcet_budgets.h */
+#define ENABLE_SELF_CHECK 1          /* 1: check run-time invariants and report violations */
+#define FUZZ_INPUTS 0                /* 1: Task_C follows a generated input sequence */
+#define FUZZ_SEED 1                  /* Reproduces the generated inputs */
+#define ENABLE_FAULT_INJECTION 0     /* 1: inject the faults of the plan below */
+#define FAULT_PLAN_RANDOM 0          /* 1: random plan from FAULT_SEED instead of the script */
+#define FAULT_SEED 1
+#define FAULT_HORIZON_MS 30000       /* Random plan: faults spread over this time */
+#define ENABLE_HIERARCHICAL 0        /* 1: cyclic executive runs B and A, C-F run in its slack */
+#define HIER_FRAME_MS 5              /* Executive frame: the partition's resource period */
+#define EXECUTIVE_PRIORITY 8         /* Cyclic executive: above every partition task */
+#define EXECUTIVE_MARGIN_US 100      /* Dispatch and logging of the executive per frame */
+#define ENABLE_TIME_PARTITIONS 0     /* 1: task groups only run in their windows of the major frame */
+#define PARTITION_SCHEDULER_PRIORITY 9  /* Window switches preempt every task */
+#define PARTITION_SWITCH_TOLERANCE_US 200  /* Later window start: the outgoing partition overran */
+#define ENABLE_ISR_LOAD 1            /* 1: account time in interrupt handlers and add it to the RTA */
+#define ENABLE_DEADLINE_ALARM 1      /* 1: detect misses at the deadline with a timer alarm, also for
+                                        jobs that never run or never complete */
+#define DEADLINE_RECOVERY recovery_signal  /* Run by the alarm for a late job, NULL for none */
+#define ENABLE_CRASH_LOG 1           /* 1: stack overflows (PSPLIM) and faults are recorded for the next
+                                        boot, then the watchdog resets */
+#define FPU_CONTEXT_RELEASE 1        /* 1: tasks not declared uses_fpu drop any FP context after each
+                                        job, so their context switches skip the FP registers */
+#define ENABLE_OVERLOAD_WARNING 1    /* 1: predict misses each hyperperiod from a sliding window of
+                                        measured execution times and warn before they happen */
+#define OVERLOAD_WINDOW_JOBS 16      /* Jobs per task in the window */
+#define OVERLOAD_HEADROOM_US 500     /* Warn when the predicted slack of a task drops below this */
+#define ENABLE_TRACE_BUDGET 1        /* 1: limit the time the monitor spends in reports; full reports
+                                        are sampled and summaries fill the gaps */
+#define TRACE_BUDGET_US 5000         /* Report time per hyperperiod */
+
+#if ENABLE_SEMI_PARTITIONING && configNUMBER_OF_CORES > 1
+#define SEMI_PARTITIONED 1
+#else
+#define SEMI_PARTITIONED 0
+#endif
+
+/* The hierarchical build owns a single core's timeline */
+#if ENABLE_HIERARCHICAL && configNUMBER_OF_CORES == 1
+#define HIERARCHICAL 1
+#else
+#define HIERARCHICAL 0
+#endif
+
+/* Time partitions are windows on a single core; the hierarchical build takes precedence */
+#if ENABLE_TIME_PARTITIONS && configNUMBER_OF_CORES == 1 && !HIERARCHICAL
+#define TIME_PARTITIONED 1
+#else
+#define TIME_PARTITIONED 0
+#endif
+
+/* Semi-partitioning assigns the cores itself; Task_E then runs sequentially */
+#define FORK_JOIN_E (ENABLE_FORK_JOIN && !SEMI_PARTITIONED && !HIERARCHICAL && !TIME_PARTITIONED)
+
+/* The overload prediction uses the single-core fixed-priority model */
+#define OVERLOAD_PREDICTION (ENABLE_OVERLOAD_WARNING && !SEMI_PARTITIONED && !HIERARCHICAL && !TIME_PARTITIONED)
 
 /* Log entry for task execution */
 typedef struct {
@@ -23,18 +95,42 @@ typedef struct {
     uint64_t deadline;       /* Absolute deadline */
     bool deadline_missed;    /* Whether deadline was missed */
     bool skipped;            /* Whether task was skipped */
+    bool alarmed;            /* Miss already counted by the deadline alarm */
 } log_entry_t;
 
+/* Task indices used by the precedence edges and chains */
+enum { TASK_B, TASK_A, TASK_F, TASK_C, TASK_D, TASK_E, NUM_TASKS };
+
 /* Task parameters structure */
 typedef struct {
     const char* name;                  /* Task name */
+    uint8_t index;                     /* Index in the task set */
     void (*job_func)(jobReturn_t*);   /* Workload function */
     uint32_t period_ms;                /* Period in milliseconds */
     uint32_t deadline_ms;              /* Deadline in milliseconds (implicit: D=T) */
     UBaseType_t priority;              /* Task priority */
     uint32_t job_count;                /* Job counter for release time calculation */
+    let_channel_t *input;              /* LET channel sampled at release (NULL if none) */
+    let_channel_t *output;             /* LET channel published at deadline (NULL if none) */
+    uint64_t last_data_age;            /* Age of the data used by the last job (us) */
+    uint64_t max_data_age;             /* Maximum data age observed (us) */
+    TaskHandle_t handle;               /* Handle, notified when a predecessor completes */
+    uint8_t core;                      /* Home core (semi-partitioned build) */
+    uint8_t split_core;                /* Core running the remainder of a split job */
+    uint32_t split_budget_us;          /* Budget before migrating, 0 = not split */
+    volatile uint32_t completed_jobs;  /* Jobs completed or skipped (precedence) */
+    bool in_executive;                 /* Run by the cyclic executive (hierarchical build) */
+    uint32_t max_response_us;          /* Finish - release, worst observed */
+    bool uses_fpu;                     /* Keeps floating-point state between jobs */
+    uint32_t fpu_releases;             /* Jobs that left an FP context (FPU_CONTEXT_RELEASE) */
 } task_params_t;
 
+/* Critical jobs the cyclic executive runs at the start of one frame */
+typedef struct {
+    uint8_t num_jobs;
+    uint8_t tasks[2];
+} executive_frame_t;
+
 /* Task handles */
 TaskHandle_t task_A_handle;
 TaskHandle_t task_B_handle;
@@ -48,8 +144,125 @@ log_entry_t log_buffer[MAX_LOGS_PER_HYPERPERIOD];
 volatile uint32_t log_count = 0;
 SemaphoreHandle_t log_mutex;
 
+/* Run-time invariant violations (ENABLE_SELF_CHECK), updated under log_mutex */
+static invariants_t invariants;
+static uint32_t misses_counted = 0;  /* Misses this hyperperiod, counted apart from the log; also
+                                        by the deadline alarm, so only in critical sections */
+
+/* Fault plan (ENABLE_FAULT_INJECTION), times relative to the scheduler start.
+ * The fault state is shared by all tasks and accessed under log_mutex. */
+static fault_event_t fault_plan[FAULT_MAX_EVENTS] = {
+    { .at_ms = 1000, .kind = FAULT_OVERRUN,       .task = TASK_A,         .param = 3000 },
+    { .at_ms = 2000, .kind = FAULT_LATE_TIMER,    .task = FAULT_ANY_TASK, .param = 2000 },
+    { .at_ms = 3000, .kind = FAULT_LOST_TICK,     .task = FAULT_ANY_TASK },
+    { .at_ms = 4000, .kind = FAULT_SWITCH_STUCK,  .task = FAULT_ANY_TASK, .param = 255, .duration_ms = 100 },
+    { .at_ms = 5000, .kind = FAULT_SWITCH_BOUNCE, .task = FAULT_ANY_TASK, .param = 0x0F, .duration_ms = 100 },
+};
+#define FAULT_PLAN_SCRIPTED_EVENTS 5
+
+/* LET dataflow: Task_B (sensor) -> Task_A (filter) -> Task_F (actuator).
+ * Lock-free (see let.c), so periodic_task needs no mutex to exchange data. */
+static let_token_t sensor_storage[LET_NUM_BUFFERS];
+static let_token_t filter_storage[LET_NUM_BUFFERS];
+static let_channel_t sensor_channel;
+static let_channel_t filter_channel;
+
+/* Tasks consuming LET data, reported by the monitor */
+#define NUM_LET_CONSUMERS 2
+static task_params_t *let_consumers[NUM_LET_CONSUMERS];
+
+/* Task set, filled in main() */
+static task_params_t *task_set[NUM_TASKS];
+
+/* Precedence: the sensor (B) feeds the filter (A) which feeds the actuator (F).
+ * A job waits for the predecessor job with the latest release <= its own. */
+#define NUM_EDGES 2
+static const dag_edge_t precedence[NUM_EDGES] = {
+    { .pred = TASK_B, .succ = TASK_A },
+    { .pred = TASK_A, .succ = TASK_F },
+};
+
+/* Cause-effect chains: analytical bounds and measured data age */
+#define NUM_CHAINS 1
+static const dag_chain_t chains[NUM_CHAINS] = {
+    { .name = "B->A->F", .length = 3, .tasks = {TASK_B, TASK_A, TASK_F} },
+};
+static dag_chain_bound_t chain_bounds[NUM_CHAINS];
+static uint64_t chain_age_last = 0;  /* Actuator output - sensor release (us) */
+static uint64_t chain_age_max = 0;
+
+/* Fork-join execution of Task_E. In the dual-core build the worker is pinned
+ * to core 1 and the periodic tasks to core 0; on one core it runs the
+ * segments back to back. */
+static fj_job_t task_E_fj = { .func = job_E_segment, .num_segments = FJ_MAX_SEGMENTS };
+static fj_stats_t task_E_fj_stats;
+static uint64_t task_E_fj_span_max = 0;
+static TaskHandle_t fj_worker_handle;
+static SemaphoreHandle_t fj_join_sem;
+
+/* Cost of migrating a split job at its budget point */
+static uint64_t migration_cost_last = 0;
+static uint64_t migration_cost_max = 0;
+static uint32_t migration_count = 0;
+
+/* Hierarchical scheduling: the executive repeats this table every two frames
+ * (Task_B every frame, Task_A every other frame); the partition (C, D, E, F
+ * under fixed priorities) gets the rest of each frame and is preempted at
+ * the next frame boundary, which enforces its budget. */
+#define EXECUTIVE_TABLE_FRAMES 2
+static const executive_frame_t executive_table[EXECUTIVE_TABLE_FRAMES] = {
+    { .num_jobs = 2, .tasks = {TASK_B, TASK_A} },
+    { .num_jobs = 1, .tasks = {TASK_B} },
+};
+static TaskHandle_t executive_handle;
+static uint32_t executive_reservation_us[EXECUTIVE_TABLE_FRAMES]; /* WCETs plus margin */
+static uint32_t partition_budget_us = 0;       /* Guaranteed supply per frame */
+static uint32_t partition_bound_us[NUM_TASKS]; /* Compositional response-time bounds */
+static volatile uint64_t executive_busy_us = 0; /* Since start, sampled around partition jobs */
+static uint64_t partition_supply_us = 0;        /* This hyperperiod, under log_mutex */
+static uint64_t partition_busy_us = 0;
+static uint32_t partition_cuts = 0;             /* Frames ending with partition work pending */
+static uint32_t executive_overruns = 0;         /* Frames whose critical jobs exceeded their WCET */
+
+/* Time partitioning: the major frame is divided into windows, each owned by
+ * one group of tasks. Outside its windows a group is suspended, so only the
+ * owning group's tasks are eligible to run; the monitor belongs to no group. */
+typedef struct {
+    uint8_t partition;
+    uint32_t duration_ms;
+} partition_window_t;
+
+#define NUM_PARTITIONS 3
+#define NUM_WINDOWS 3
+static const partition_window_t major_frame[NUM_WINDOWS] = {
+    { .partition = 0, .duration_ms = 2 },  /* Task_B, Task_A */
+    { .partition = 1, .duration_ms = 2 },  /* Task_F, Task_C */
+    { .partition = 2, .duration_ms = 1 },  /* Task_D, Task_E */
+};
+static const uint8_t task_partition[NUM_TASKS] = {
+    [TASK_B] = 0, [TASK_A] = 0, [TASK_F] = 1, [TASK_C] = 1, [TASK_D] = 2, [TASK_E] = 2,
+};
+static uint64_t partition_switch_last_us = 0;   /* Suspend and resume of one window switch */
+static uint64_t partition_switch_max_us = 0;
+static uint64_t partition_switch_total_us = 0;
+static uint32_t partition_switch_count = 0;
+static uint64_t window_lateness_max_us = 0;     /* Window start after its planned boundary */
+static uint32_t window_overruns = 0;            /* Starts later than PARTITION_SWITCH_TOLERANCE_US */
+static uint32_t partition_misses[NUM_PARTITIONS];  /* Since start, under log_mutex */
+
+/* Interrupt load of the last hyperperiod (ENABLE_ISR_LOAD) */
+static isr_load_t isr_load;
+
+/* Demand estimates and early warning (ENABLE_OVERLOAD_WARNING), under log_mutex */
+static overload_t overload;
+static uint8_t overload_tightest = 0;  /* Task with the least headroom at the last warning */
+
+/* Report time budget of the monitor (ENABLE_TRACE_BUDGET) */
+static trace_budget_t trace_budget;
+
 /* Global scheduler start time (shared by all tasks) */
 static uint64_t scheduler_start_time_us = 0;
+static TickType_t scheduler_start_tick = 0;
 
 /**
  * @brief Periodic task template
@@ -61,6 +274,25 @@ static uint64_t scheduler_start_time_us = 0;
  */
 void periodic_task(void *args);
 
+/**
+ * @brief Cyclic executive of the hierarchical build
+ *
+ * Runs the critical jobs of executive_table at each frame start at the
+ * highest priority and leaves the rest of the frame to the partition.
+ *
+ * @param args Unused
+ */
+void executive_task(void *args);
+
+/**
+ * @brief Partition scheduler of the time-partitioned build
+ *
+ * Switches the active group at each window boundary of major_frame.
+ *
+ * @param args Unused
+ */
+void partition_scheduler_task(void *args);
+
 /**
  * @brief Monitor task that prints statistics every hyperperiod
  *
@@ -68,6 +300,93 @@ void periodic_task(void *args);
  */
 void monitor_task(void *args);
 
+/**
+ * @brief Fork-join worker executing the forked segments of Task_E
+ *
+ * @param args Pointer to the fj_job_t to serve
+ */
+void fj_worker_task(void *args);
+
+/**
+ * @brief Partition the task set over both cores and split Task_C
+ *
+ * Only used in the semi-partitioned dual-core build.
+ */
+static void semi_partition_setup(void);
+
+/**
+ * @brief Run a job of a split task: budget on the home core, rest after migrating
+ *
+ * @param params Task parameters with the split assignment
+ * @param result Start of the first and stop of the last portion
+ */
+static void run_split_job(task_params_t *params, jobReturn_t *result);
+
+/**
+ * @brief Size the partition's budget and check it compositionally
+ *
+ * Only used in the hierarchical build.
+ */
+static void hierarchical_setup(void);
+
+/**
+ * @brief Print the response-time bounds with and without the measured
+ *        interrupt interference
+ *
+ * Single-core fixed-priority model; not used by the partitioned builds.
+ */
+static void print_isr_interference(const isr_load_t *load);
+
+/**
+ * @brief Predict the response times from the demand estimates and update
+ *        the early warning
+ *
+ * Same model as print_isr_interference() with each WCET replaced by the
+ * task's estimate. Called at every job completion and Task_C skip with
+ * log_mutex held: the monitor has the lowest priority and starves under
+ * the overload it would have to warn about.
+ */
+static void predict_overload(const isr_load_t *load);
+
+/**
+ * @brief Full report of a hyperperiod: the job log and the statistics
+ *
+ * Called by the monitor with log_mutex held.
+ *
+ * @param alarm_log Misses detected at their deadline, alarm_count entries
+ * @param overload_event An overload warning was raised since the last report
+ */
+static void print_hyperperiod_report(uint32_t hyperperiod, uint32_t deadline_misses, uint32_t skipped_count,
+                                     const deadline_miss_t *alarm_log, uint32_t alarm_count,
+                                     bool overload_event);
+
+/**
+ * @brief Deadline alarm handler: a job is still pending at its deadline
+ *
+ * Runs in the alarm interrupt, at the highest priority allowed to use the
+ * FromISR API. Counts the miss, whose record the alarm posted for the
+ * monitor, and starts the configured recovery, which may wake a task. The
+ * job's own log entry, if it completes, does not count it again.
+ */
+static void deadline_missed(uint8_t task, uint64_t deadline_us, uint64_t now_us);
+
+/**
+ * @brief Recovery action: signal the miss on the red LED
+ */
+static void recovery_signal(uint8_t task, uint64_t deadline_us, uint64_t now_us);
+
+/**
+ * @brief Count a deadline miss detected by a task
+ */
+static void count_miss(void);
+
+/**
+ * @brief Name of the running task, for the crash record
+ *
+ * Only called for faults on a task stack, so the scheduler is running.
+ */
+static const char *current_task_name(void);
+
 /*************************************************************/
 
 /**
@@ -93,30 +412,68 @@ int main()
     printf("Hyperperiod: %d ms\n", HYPERPERIOD_MS);
     printf("========================================\n\n");
 
+    if (ENABLE_CRASH_LOG) {
+        crash_log_init(current_task_name, true);
+        crash_log_print();
+    }
+
+#if FUZZ_INPUTS
+    /* Task_C follows the generated sequence instead of the switches */
+    fuzz_init(FUZZ_SEED);
+    workload_set_switch_source(fuzz_switch_source);
+    printf("Task_C inputs generated from seed %u\n\n", FUZZ_SEED);
+#endif
+
+#if ENABLE_FAULT_INJECTION
+    /* Switch faults are applied on top of the input selected above */
+    static const char *task_names[NUM_TASKS] = {
+        [TASK_A] = "Task_A", [TASK_B] = "Task_B", [TASK_C] = "Task_C",
+        [TASK_D] = "Task_D", [TASK_E] = "Task_E", [TASK_F] = "Task_F"
+    };
+    uint32_t num_fault_events = FAULT_PLAN_SCRIPTED_EVENTS;
+    if (FAULT_PLAN_RANDOM) {
+        num_fault_events = FAULT_MAX_EVENTS;
+        fault_random_plan(fault_plan, num_fault_events, NUM_TASKS, FAULT_HORIZON_MS, FAULT_SEED);
+    }
+    fault_init(fault_plan, num_fault_events, task_names,
+               FUZZ_INPUTS ? fuzz_switch_source : workload_read_switches);
+    workload_set_switch_source(fault_switch_source);
+#endif
+
     /* Create mutex for log buffer protection */
     log_mutex = xSemaphoreCreateMutex();
 
+    /* LET channels for the sensor -> filter -> actuator chain */
+    let_init(&sensor_channel, sensor_storage, sizeof(let_token_t));
+    let_init(&filter_channel, filter_storage, sizeof(let_token_t));
+
     /* Define task parameters (static allocation for persistence) */
     static task_params_t params_A = {
         .name = "Task_A",
+        .index = TASK_A,
         .job_func = job_A,
         .period_ms = 10,
         .deadline_ms = 10,
         .priority = 5,
-        .job_count = 0
+        .job_count = 0,
+        .input = &sensor_channel,
+        .output = &filter_channel
     };
 
     static task_params_t params_B = {
         .name = "Task_B",
+        .index = TASK_B,
         .job_func = job_B,
         .period_ms = 5,
         .deadline_ms = 5,
         .priority = 6,  /* Highest priority (shortest period) */
-        .job_count = 0
+        .job_count = 0,
+        .output = &sensor_channel
     };
 
     static task_params_t params_C = {
         .name = "Task_C",
+        .index = TASK_C,
         .job_func = job_C,
         .period_ms = 25,
         .deadline_ms = 25,
@@ -126,6 +483,7 @@ int main()
 
     static task_params_t params_D = {
         .name = "Task_D",
+        .index = TASK_D,
         .job_func = job_D,
         .period_ms = 50,
         .deadline_ms = 50,
@@ -135,6 +493,7 @@ int main()
 
     static task_params_t params_E = {
         .name = "Task_E",
+        .index = TASK_E,
         .job_func = job_E,
         .period_ms = 50,
         .deadline_ms = 50,
@@ -144,20 +503,110 @@ int main()
 
     static task_params_t params_F = {
         .name = "Task_F",
+        .index = TASK_F,
         .job_func = job_F,
         .period_ms = 20,
         .deadline_ms = 20,
         .priority = 4,
-        .job_count = 0
+        .job_count = 0,
+        .input = &filter_channel
     };
 
-    /* Create all periodic tasks */
+    let_consumers[0] = &params_A;
+    let_consumers[1] = &params_F;
+
+    task_set[TASK_A] = &params_A;
+    task_set[TASK_B] = &params_B;
+    task_set[TASK_C] = &params_C;
+    task_set[TASK_D] = &params_D;
+    task_set[TASK_E] = &params_E;
+    task_set[TASK_F] = &params_F;
+
+    /* End-to-end bounds of the cause-effect chains */
+    configASSERT(dag_is_acyclic(NUM_TASKS, precedence, NUM_EDGES));
+    uint32_t chain_periods[NUM_TASKS];
+    uint32_t chain_deadlines[NUM_TASKS];
+    for (int i = 0; i < NUM_TASKS; i++) {
+        chain_periods[i] = task_set[i]->period_ms;
+        chain_deadlines[i] = task_set[i]->deadline_ms;
+    }
+    for (int i = 0; i < NUM_CHAINS; i++) {
+        dag_analyze_let_chain(&chains[i], chain_periods, chain_deadlines, &chain_bounds[i]);
+        printf("Chain %s: worst-case latency %llu us, data age %llu us\n\n",
+               chains[i].name, chain_bounds[i].max_latency_us, chain_bounds[i].max_age_us);
+    }
+
+    /* Create all periodic tasks; in the hierarchical build the cyclic
+     * executive runs Task_A and Task_B instead */
+#if HIERARCHICAL
+    xTaskCreate(executive_task, "Executive", 512, NULL, EXECUTIVE_PRIORITY, &executive_handle);
+    params_A.in_executive = true;
+    params_A.handle = executive_handle;
+    params_B.in_executive = true;
+    params_B.handle = executive_handle;
+#else
     xTaskCreate(periodic_task, "Task_A", 512, &params_A, params_A.priority, &task_A_handle);
+    params_A.handle = task_A_handle;
     xTaskCreate(periodic_task, "Task_B", 512, &params_B, params_B.priority, &task_B_handle);
+    params_B.handle = task_B_handle;
+#endif
     xTaskCreate(periodic_task, "Task_C", 512, &params_C, params_C.priority, &task_C_handle);
+    params_C.handle = task_C_handle;
     xTaskCreate(periodic_task, "Task_D", 512, &params_D, params_D.priority, &task_D_handle);
+    params_D.handle = task_D_handle;
     xTaskCreate(periodic_task, "Task_E", 512, &params_E, params_E.priority, &task_E_handle);
+    params_E.handle = task_E_handle;
     xTaskCreate(periodic_task, "Task_F", 512, &params_F, params_F.priority, &task_F_handle);
+    params_F.handle = task_F_handle;
+
+#if FORK_JOIN_E
+    fj_join_sem = xSemaphoreCreateBinary();
+#if configNUMBER_OF_CORES > 1
+    /* Periodic tasks stay on core 0 so fixed-priority analysis still applies */
+    for (int i = 0; i < NUM_TASKS; i++) {
+        vTaskCoreAffinitySet(task_set[i]->handle, (1 << 0));
+    }
+    xTaskCreateAffinitySet(fj_worker_task, "FJ_Worker", 512, &task_E_fj, params_E.priority,
+                           (1 << 1), &fj_worker_handle);
+#else
+    xTaskCreate(fj_worker_task, "FJ_Worker", 512, &task_E_fj, params_E.priority, &fj_worker_handle);
+#endif
+#endif
+
+#if SEMI_PARTITIONED
+    semi_partition_setup();
+#endif
+
+#if HIERARCHICAL
+    hierarchical_setup();
+#endif
+
+#if TIME_PARTITIONED
+    /* Runs first and suspends every group outside the first window */
+    xTaskCreate(partition_scheduler_task, "Partitions", 512, NULL, PARTITION_SCHEDULER_PRIORITY, NULL);
+    printf("Time partitions, major frame:");
+    for (int w = 0; w < NUM_WINDOWS; w++) {
+        printf(" [P%u %u ms]", major_frame[w].partition, major_frame[w].duration_ms);
+    }
+    printf("\n  P0: Task_B, Task_A  P1: Task_F, Task_C  P2: Task_D, Task_E\n\n");
+#endif
+
+    /* Highest priority allowed to call the FromISR API */
+    if (ENABLE_DEADLINE_ALARM) {
+        deadline_alarm_init(deadline_missed, configMAX_SYSCALL_INTERRUPT_PRIORITY);
+    }
+
+    if (ENABLE_OVERLOAD_WARNING) {
+        overload_init(&overload, NUM_TASKS, OVERLOAD_WINDOW_JOBS, OVERLOAD_HEADROOM_US);
+        printf("Overload warning: task slack below %d us, estimates from the last %d jobs\n\n",
+               OVERLOAD_HEADROOM_US, OVERLOAD_WINDOW_JOBS);
+    }
+
+    if (ENABLE_TRACE_BUDGET) {
+        trace_budget_init(&trace_budget, TRACE_BUDGET_US);
+        printf("Report budget: %u us per hyperperiod; full reports sampled down to 1/%u, "
+               "then summaries\n\n", TRACE_BUDGET_US, TRACE_MAX_SAMPLE_EVERY);
+    }
 
     /* Create monitor task with lowest priority (0) */
     xTaskCreate(monitor_task, "Monitor", 512, NULL, 0, NULL);
@@ -175,125 +624,662 @@ int main()
 /*-----------------------------------------------------------*/
 
 /**
- * @brief Periodic task template implementation
+ * @brief Record the invariants of one job and report a stall to the fault
+ *        log; called with log_mutex held
  *
- * This function implements the periodic task pattern:
- * 1. Initialize timing variables
- * 2. Infinite loop:
- *    - Calculate release time
- *    - Execute the job function
- *    - Log execution information
- *    - Wait until next period using vTaskDelayUntil
+ * @param result Execution of the job, NULL if it was skipped
+ */
+static void self_check_job(const task_params_t *params, uint64_t lateness_us,
+                           const jobReturn_t *result, uint64_t release_time_us)
+{
+    bool stalled = (lateness_us >= (uint64_t)params->period_ms * 1000);
+
+    if (ENABLE_FAULT_INJECTION && stalled) {
+        fault_detected(FAULT_DETECT_STALL, time_us_64());
+    }
+    if (!ENABLE_SELF_CHECK) {
+        return;
+    }
+    if (lateness_us > invariants.max_lateness_us) {
+        invariants.max_lateness_us = lateness_us;
+    }
+    if (stalled) {
+        invariants.stalls++;
+    }
+    if (result != NULL && result->start < release_time_us) {
+        invariants.early_starts++;
+    }
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Take a due fault at an injection point (ENABLE_FAULT_INJECTION)
  *
- * @param args Pointer to task_params_t structure
+ * @param param Filled with the fault parameter
+ * @return true if the caller has to inject the fault now
  */
-void periodic_task(void *args)
+static bool fault_take(fault_kind_t kind, uint8_t task, uint32_t *param)
 {
-    task_params_t *params = (task_params_t *)args;
-    jobReturn_t result;
-    TickType_t xLastWakeTime;
-    const TickType_t xPeriod = pdMS_TO_TICKS(params->period_ms);
+    bool due = false;
 
-    /* Initialize the xLastWakeTime variable with the current time */
-    xLastWakeTime = xTaskGetTickCount();
+    if (!ENABLE_FAULT_INJECTION) {
+        return false;
+    }
+    if (xSemaphoreTake(log_mutex, portMAX_DELAY) == pdTRUE) {
+        due = fault_pending(kind, task, time_us_64(), param);
+        xSemaphoreGive(log_mutex);
+    }
+    return due;
+}
+/*-----------------------------------------------------------*/
+
+static const char *current_task_name(void)
+{
+    return pcTaskGetName(NULL);
+}
+/*-----------------------------------------------------------*/
+
+#if configCHECK_FOR_STACK_OVERFLOW
+/**
+ * @brief Software stack check of the kernel (PSPLIM normally faults first)
+ */
+void vApplicationStackOverflowHook(TaskHandle_t xTask, char *pcTaskName)
+{
+    crash_log_record(CRASH_STACK_OVERFLOW_SW, pcTaskName);
+}
+/*-----------------------------------------------------------*/
+#endif
+
+static void recovery_signal(uint8_t task, uint64_t deadline_us, uint64_t now_us)
+{
+    BSP_ToggleLED(LED_RED);
+}
+/*-----------------------------------------------------------*/
+
+static const deadline_handler_t deadline_recovery = DEADLINE_RECOVERY;
+
+/**
+ * @brief Deadline alarm handler implementation
+ */
+static void deadline_missed(uint8_t task, uint64_t deadline_us, uint64_t now_us)
+{
+    UBaseType_t save = taskENTER_CRITICAL_FROM_ISR();
+    misses_counted++;
+    taskEXIT_CRITICAL_FROM_ISR(save);
 
-    /* Initialize global scheduler start time on first task activation (using atomic operation) */
+    if (deadline_recovery != NULL) {
+        deadline_recovery(task, deadline_us, now_us);
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void count_miss(void)
+{
+    taskENTER_CRITICAL();
+    misses_counted++;
+    taskEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Initialize the global scheduler start time on the first task activation
+ */
+static void scheduler_start(void)
+{
     static bool scheduler_initialized = false;
     if (!scheduler_initialized) {
         scheduler_start_time_us = time_us_64();
+        scheduler_start_tick = xTaskGetTickCount();
         scheduler_initialized = true;
+        if (ENABLE_FAULT_INJECTION) {
+            fault_start(scheduler_start_time_us);
+        }
+        /* The kernel's SysTick and the enabled IRQs are installed by now */
+        if (ENABLE_ISR_LOAD) {
+            isr_load_init();
+        }
     }
+}
+/*-----------------------------------------------------------*/
 
-    /* Periodic task loop */
-    for (;;) {
-        /* Calculate theoretical release time and deadline for this job (absolute time) */
-        uint64_t release_time_us = scheduler_start_time_us + ((uint64_t)params->job_count * params->period_ms * 1000);
-        uint64_t deadline_us = release_time_us + (params->deadline_ms * 1000);
-        bool skip_execution = false;
-
-        /* Special handling for Task_C: check if there's enough time before executing */
-        if (params->job_func == job_C) {
-            /* Read GPIO switches to get actual execution time for Task_C */
-            bool bit7 = BSP_GetInput(SW_10);
-            bool bit6 = BSP_GetInput(SW_11);
-            bool bit5 = BSP_GetInput(SW_12);
-            bool bit4 = BSP_GetInput(SW_13);
-            bool bit3 = BSP_GetInput(SW_14);
-            bool bit2 = BSP_GetInput(SW_15);
-            bool bit1 = BSP_GetInput(SW_16);
-            bool bit0 = BSP_GetInput(SW_17);
-
-            uint8_t switch_value = (bit7 << 7) | (bit6 << 6) | (bit5 << 5) | (bit4 << 4) |
-                                   (bit3 << 3) | (bit2 << 2) | (bit1 << 1) | bit0;
-
-            /* Calculate Task_C's actual execution time from GPIO */
-            uint32_t task_c_wcet_us = ((switch_value * 8000) / 256);
-
-            /* Check if there's enough time to complete Task_C before deadline */
-            uint64_t current_time = time_us_64();
-            int64_t time_remaining = (int64_t)deadline_us - (int64_t)current_time;
-
-            if (time_remaining < (int64_t)task_c_wcet_us) {
-                /* Not enough time - skip Task_C */
-                skip_execution = true;
-
-                /* LED indication */
-                BSP_ToggleLED(LED_RED);
+/**
+ * @brief Run the current job of a periodic task
+ *
+ * Calculates the release time, waits for its predecessors, executes the job
+ * function, logs the execution and releases its successors. Called by the
+ * task itself or, for critical tasks of the hierarchical build, by the
+ * cyclic executive.
+ *
+ * @param params Task parameters
+ */
+static void periodic_job(task_params_t *params)
+{
+    jobReturn_t result;
+    uint32_t fault_param;
 
-                /* Log skipped task */
-                if (xSemaphoreTake(log_mutex, portMAX_DELAY) == pdTRUE) {
-                    if (log_count < MAX_LOGS_PER_HYPERPERIOD) {
-                        log_buffer[log_count].task_name = params->name;
-                        log_buffer[log_count].release_time = release_time_us;
-                        log_buffer[log_count].start_time = 0;
-                        log_buffer[log_count].finish_time = 0;
-                        log_buffer[log_count].exec_time = 0;
-                        log_buffer[log_count].deadline = deadline_us;
-                        log_buffer[log_count].deadline_missed = true;
-                        log_buffer[log_count].skipped = true;
-                        log_count++;
-                    }
-                    xSemaphoreGive(log_mutex);
-                }
+    /* Calculate theoretical release time and deadline for this job (absolute time) */
+    uint64_t release_time_us = scheduler_start_time_us + ((uint64_t)params->job_count * params->period_ms * 1000);
+    uint64_t deadline_us = release_time_us + (params->deadline_ms * 1000);
+    bool skip_execution = false;
+
+    /* Later jobs are armed by the completion of their predecessor */
+    if (ENABLE_DEADLINE_ALARM && params->job_count == 0) {
+        deadline_alarm_arm(params->index, deadline_us);
+    }
+
+    /* Injected timer faults. A late timer delays this dispatch; a lost tick
+     * masks interrupts for two tick periods, so one SysTick is never counted. */
+    if (fault_take(FAULT_LATE_TIMER, FAULT_ANY_TASK, &fault_param)) {
+        BSP_WaitClkCycles(fault_param * CYCLES_PER_US);
+    }
+    if (fault_take(FAULT_LOST_TICK, FAULT_ANY_TASK, &fault_param)) {
+        taskENTER_CRITICAL();
+        BSP_WaitClkCycles(2 * portTICK_PERIOD_MS * CYCLES_PER_MS);
+        taskEXIT_CRITICAL();
+    }
+
+    /* Dispatch delay of the release: a full period means the task stalled */
+    uint64_t dispatch_time_us = time_us_64();
+    uint64_t lateness_us = (dispatch_time_us > release_time_us) ? dispatch_time_us - release_time_us : 0;
+
+    /* Sample LET input at the logical release, before the precedence wait: the
+     * buffer visible at the release may be rotated out while this job blocks */
+    const let_token_t *input = let_token_sample(params->input, release_time_us);
+
+    /* Precedence: wait until the predecessor jobs this release depends on are done */
+    for (uint8_t e = 0; e < NUM_EDGES; e++) {
+        if (precedence[e].succ == params->index) {
+            task_params_t *pred = task_set[precedence[e].pred];
+            uint32_t needed = dag_pred_job(pred->period_ms,
+                                           (uint64_t)params->job_count * params->period_ms * 1000);
+            while (pred->completed_jobs <= needed) {
+                ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
             }
         }
+    }
 
-        /* Execute the job if not skipped */
-        if (!skip_execution) {
-            params->job_func(&result);
+    if (input != NULL && input->origin_us != 0) {
+        params->last_data_age = release_time_us - input->origin_us;
+        if (params->last_data_age > params->max_data_age) {
+            params->max_data_age = params->last_data_age;
+        }
+    }
+
+    /* Special handling for Task_C: check if there's enough time before executing */
+    if (params->job_func == job_C) {
+        /* Generated input for this job */
+        if (FUZZ_INPUTS) {
+            fuzz_next_switch();
+        }
+
+        /* Read the switches to get actual execution time for Task_C.
+         * Injected switch faults update the shared fault state. */
+        uint8_t switch_value;
+        if (ENABLE_FAULT_INJECTION && xSemaphoreTake(log_mutex, portMAX_DELAY) == pdTRUE) {
+            switch_value = workload_switch_value();
+            xSemaphoreGive(log_mutex);
+        } else {
+            switch_value = workload_switch_value();
+        }
 
-            /* Check for deadline miss */
-            bool missed = (result.stop > deadline_us);
-            if (missed) {
+        /* Calculate Task_C's actual execution time from the switch value */
+        uint32_t task_c_wcet_us = job_C_exec_us(switch_value);
+
+        /* Check if there's enough time to complete Task_C before deadline */
+        uint64_t current_time = time_us_64();
+        int64_t time_remaining = (int64_t)deadline_us - (int64_t)current_time;
+
+        if (time_remaining < (int64_t)task_c_wcet_us) {
+            /* Not enough time - skip Task_C */
+            skip_execution = true;
+
+            /* LED indication (unless the alarm already gave it) */
+            bool alarmed = ENABLE_DEADLINE_ALARM && deadline_alarm_disarm(params->index, NULL);
+            if (!alarmed) {
                 BSP_ToggleLED(LED_RED);
             }
 
-            /* Log execution information */
+            /* Log skipped task */
             if (xSemaphoreTake(log_mutex, portMAX_DELAY) == pdTRUE) {
                 if (log_count < MAX_LOGS_PER_HYPERPERIOD) {
                     log_buffer[log_count].task_name = params->name;
                     log_buffer[log_count].release_time = release_time_us;
-                    log_buffer[log_count].start_time = result.start;
-                    log_buffer[log_count].finish_time = result.stop;
-                    log_buffer[log_count].exec_time = result.stop - result.start;
+                    log_buffer[log_count].start_time = 0;
+                    log_buffer[log_count].finish_time = 0;
+                    log_buffer[log_count].exec_time = 0;
                     log_buffer[log_count].deadline = deadline_us;
-                    log_buffer[log_count].deadline_missed = missed;
-                    log_buffer[log_count].skipped = false;
+                    log_buffer[log_count].deadline_missed = true;
+                    log_buffer[log_count].skipped = true;
+                    log_buffer[log_count].alarmed = alarmed;
                     log_count++;
+                } else {
+                    invariants.dropped_logs++;
+                }
+                if (!alarmed) {
+                    count_miss();
+                }
+                if (TIME_PARTITIONED) {
+                    partition_misses[task_partition[params->index]]++;
+                }
+                if (OVERLOAD_PREDICTION) {
+                    predict_overload(&isr_load);
+                }
+                self_check_job(params, lateness_us, NULL, 0);
+                if (ENABLE_FAULT_INJECTION) {
+                    fault_detected(FAULT_DETECT_SKIP, current_time);
                 }
                 xSemaphoreGive(log_mutex);
             }
         }
+    }
+
+    /* Execute the job if not skipped */
+    if (!skip_execution) {
+        uint64_t executive_busy_before = executive_busy_us;
+
+        if (FORK_JOIN_E && params->job_func == job_E) {
+            /* Fork: hand segment 1 to the worker, run segment 0, then join */
+            task_E_fj.fork_time = time_us_64();
+            xTaskNotifyGive(fj_worker_handle);
+            fj_run_segment(&task_E_fj, 0);
+            xSemaphoreTake(fj_join_sem, portMAX_DELAY);
+            task_E_fj.join_time = time_us_64();
+
+            result.start = task_E_fj.fork_time;
+            result.stop = task_E_fj.join_time;
+            fj_stats(&task_E_fj, &task_E_fj_stats);
+            if (task_E_fj_stats.span_us > task_E_fj_span_max) {
+                task_E_fj_span_max = task_E_fj_stats.span_us;
+            }
+        } else if (SEMI_PARTITIONED && params->split_budget_us != 0) {
+            run_split_job(params, &result);
+        } else {
+            params->job_func(&result);
+        }
+
+        /* Injected overrun: the job runs longer than its workload */
+        if (fault_take(FAULT_OVERRUN, params->index, &fault_param)) {
+            BSP_WaitClkCycles(fault_param * CYCLES_PER_US);
+            result.stop = time_us_64();
+        }
+
+        /* Net execution of a partition job: time taken by the executive
+         * while the job was preempted does not count */
+        uint64_t preempted_us = executive_busy_us - executive_busy_before;
+        uint64_t net_us = result.stop - result.start;
+        net_us = (net_us > preempted_us) ? net_us - preempted_us : 0;
+
+        /* Publish LET output, visible from the logical deadline */
+        let_token_publish(params->output, input, params->job_count, release_time_us, deadline_us);
+        if (params->output == NULL && input != NULL && input->origin_us != 0) {
+            chain_age_last = deadline_us - input->origin_us;
+            if (chain_age_last > chain_age_max) {
+                chain_age_max = chain_age_last;
+            }
+        }
+
+        /* Check for deadline miss. A job that returns after its alarm fired
+         * missed, even if its own stop time raced the alarm. */
+        uint64_t detected_at = result.stop;
+        bool alarmed = ENABLE_DEADLINE_ALARM && deadline_alarm_disarm(params->index, &detected_at);
+        bool missed = alarmed || (result.stop > deadline_us);
+        if (missed && !alarmed) {
+            BSP_ToggleLED(LED_RED);
+        }
+
+        /* Log execution information */
+        if (xSemaphoreTake(log_mutex, portMAX_DELAY) == pdTRUE) {
+            if (log_count < MAX_LOGS_PER_HYPERPERIOD) {
+                log_buffer[log_count].task_name = params->name;
+                log_buffer[log_count].release_time = release_time_us;
+                log_buffer[log_count].start_time = result.start;
+                log_buffer[log_count].finish_time = result.stop;
+                log_buffer[log_count].exec_time = result.stop - result.start;
+                log_buffer[log_count].deadline = deadline_us;
+                log_buffer[log_count].deadline_missed = missed;
+                log_buffer[log_count].skipped = false;
+                log_buffer[log_count].alarmed = alarmed;
+                log_count++;
+            } else {
+                invariants.dropped_logs++;
+            }
+            if (missed && !alarmed) {
+                count_miss();
+            }
+            if (result.stop - release_time_us > params->max_response_us) {
+                params->max_response_us = (uint32_t)(result.stop - release_time_us);
+            }
+            if (HIERARCHICAL && !params->in_executive) {
+                partition_busy_us += net_us;
+            }
+            if (TIME_PARTITIONED && missed) {
+                partition_misses[task_partition[params->index]]++;
+            }
+            if (ENABLE_OVERLOAD_WARNING) {
+                overload_record(&overload, params->index, (uint32_t)net_us);
+            }
+            if (OVERLOAD_PREDICTION) {
+                predict_overload(&isr_load);
+            }
+            self_check_job(params, lateness_us, &result, release_time_us);
+            if (ENABLE_FAULT_INJECTION && missed) {
+                fault_detected(FAULT_DETECT_MISS, detected_at);
+            }
+            xSemaphoreGive(log_mutex);
+        }
+    }
+
+    /* Increment job counter */
+    params->job_count++;
+
+    /* Arm the next job: its alarm fires even if it never gets to run */
+    if (ENABLE_DEADLINE_ALARM) {
+        uint64_t next_release_us = scheduler_start_time_us +
+                                   ((uint64_t)params->job_count * params->period_ms * 1000);
+        deadline_alarm_arm(params->index, next_release_us + (params->deadline_ms * 1000));
+    }
+
+    /* Release successors waiting for this job (skipped jobs count as done) */
+    params->completed_jobs++;
+    for (uint8_t e = 0; e < NUM_EDGES; e++) {
+        if (precedence[e].pred == params->index) {
+            xTaskNotifyGive(task_set[precedence[e].succ]->handle);
+        }
+    }
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Periodic task template implementation
+ *
+ * This function implements the periodic task pattern:
+ * 1. Initialize timing variables
+ * 2. Infinite loop:
+ *    - Run the current job (periodic_job)
+ *    - Wait until next period using vTaskDelayUntil
+ *
+ * @param args Pointer to task_params_t structure
+ */
+void periodic_task(void *args)
+{
+    task_params_t *params = (task_params_t *)args;
+    TickType_t xLastWakeTime;
+    const TickType_t xPeriod = pdMS_TO_TICKS(params->period_ms);
+
+    /* Periods count from the common start, also for tasks whose partition
+     * window opens later */
+    scheduler_start();
+    xLastWakeTime = scheduler_start_tick;
+
+    /* Periodic task loop */
+    for (;;) {
+        periodic_job(params);
 
-        /* Increment job counter */
-        params->job_count++;
+        /* Integer-only task: an FP instruction in the job (compiler or
+         * library) must not make every later switch save the FP registers */
+        if (FPU_CONTEXT_RELEASE && !params->uses_fpu && fpu_context_release()) {
+            params->fpu_releases++;
+        }
 
-        /* Wait for the next period */
+        /* Wait for the next period. Resuming a suspended partition also ends
+         * the delay of its waiting tasks, so wait again if that was early. */
         vTaskDelayUntil(&xLastWakeTime, xPeriod);
+        while ((int32_t)(xLastWakeTime - xTaskGetTickCount()) > 0) {
+            vTaskDelay(xLastWakeTime - xTaskGetTickCount());
+        }
+    }
+}
+/*-----------------------------------------------------------*/
+
+void executive_task(void *args)
+{
+    (void)args;
+    TickType_t xLastWakeTime;
+    const TickType_t xFrame = pdMS_TO_TICKS(HIER_FRAME_MS);
+    uint32_t frame = 0;
+
+    xLastWakeTime = xTaskGetTickCount();
+    scheduler_start();
+
+    for (;;) {
+        const executive_frame_t *table_frame = &executive_table[frame % EXECUTIVE_TABLE_FRAMES];
+        uint64_t frame_start = time_us_64();
+
+        /* Frame boundary: partition work still ready here ran out of budget */
+        bool cut = false;
+        for (int i = 0; i < NUM_TASKS; i++) {
+            if (!task_set[i]->in_executive && eTaskGetState(task_set[i]->handle) == eReady) {
+                cut = true;
+            }
+        }
+
+        for (uint8_t j = 0; j < table_frame->num_jobs; j++) {
+            periodic_job(task_set[table_frame->tasks[j]]);
+        }
+
+        /* The partition gets the rest of the frame */
+        uint64_t busy_us = time_us_64() - frame_start;
+        executive_busy_us += busy_us;
+        if (xSemaphoreTake(log_mutex, portMAX_DELAY) == pdTRUE) {
+            partition_supply_us += (busy_us < HIER_FRAME_MS * 1000) ? HIER_FRAME_MS * 1000 - busy_us : 0;
+            partition_cuts += cut;
+            executive_overruns += (busy_us > executive_reservation_us[frame % EXECUTIVE_TABLE_FRAMES]);
+            xSemaphoreGive(log_mutex);
+        }
+
+        frame++;
+        vTaskDelayUntil(&xLastWakeTime, xFrame);
     }
 }
 /*-----------------------------------------------------------*/
 
+/**
+ * @brief Suspend the outgoing task group and resume the incoming one
+ *
+ * An outgoing task inside the log critical section first finishes it at
+ * this task's priority (inheritance), so no suspended task holds log_mutex.
+ *
+ * @param from Outgoing partition, NUM_PARTITIONS for none
+ */
+static void partition_switch(uint8_t from, uint8_t to)
+{
+    bool flush = false;
+    TaskHandle_t holder = xSemaphoreGetMutexHolder(log_mutex);
+
+    for (int i = 0; i < NUM_TASKS; i++) {
+        if (task_partition[i] == from && task_set[i]->handle == holder) {
+            flush = true;
+        }
+    }
+    if (flush) {
+        xSemaphoreTake(log_mutex, portMAX_DELAY);
+    }
+
+    for (int i = 0; i < NUM_TASKS; i++) {
+        if (task_partition[i] != to) {
+            vTaskSuspend(task_set[i]->handle);
+        }
+    }
+    for (int i = 0; i < NUM_TASKS; i++) {
+        if (task_partition[i] == to) {
+            vTaskResume(task_set[i]->handle);
+        }
+    }
+
+    if (flush) {
+        xSemaphoreGive(log_mutex);
+    }
+}
+/*-----------------------------------------------------------*/
+
+void partition_scheduler_task(void *args)
+{
+    (void)args;
+    TickType_t xLastWakeTime;
+    uint8_t active = NUM_PARTITIONS;
+    uint64_t boundary_ms = 0;
+
+    scheduler_start();
+    xLastWakeTime = scheduler_start_tick;
+
+    for (uint32_t w = 0;; w = (w + 1) % NUM_WINDOWS) {
+        const partition_window_t *window = &major_frame[w];
+        uint64_t switch_start = time_us_64();
+        uint64_t planned_us = scheduler_start_time_us + boundary_ms * 1000;
+
+        partition_switch(active, window->partition);
+        active = window->partition;
+
+        /* Overhead of the switch and lateness of the window start; a long
+         * non-preemptive section of the outgoing partition delays the start */
+        uint64_t lateness_us = (switch_start > planned_us) ? switch_start - planned_us : 0;
+        partition_switch_last_us = time_us_64() - switch_start;
+        partition_switch_total_us += partition_switch_last_us;
+        partition_switch_count++;
+        if (partition_switch_last_us > partition_switch_max_us) {
+            partition_switch_max_us = partition_switch_last_us;
+        }
+        if (lateness_us > window_lateness_max_us) {
+            window_lateness_max_us = lateness_us;
+        }
+        if (lateness_us > PARTITION_SWITCH_TOLERANCE_US) {
+            window_overruns++;
+        }
+
+        boundary_ms += window->duration_ms;
+        vTaskDelayUntil(&xLastWakeTime, pdMS_TO_TICKS(window->duration_ms));
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void print_hyperperiod_report(uint32_t hyperperiod, uint32_t deadline_misses, uint32_t skipped_count,
+                                     const deadline_miss_t *alarm_log, uint32_t alarm_count,
+                                     bool overload_event)
+{
+    printf("\n========== Hyperperiod %u ==========\n", hyperperiod);
+
+    /* Print header */
+    printf("Task   | Release    | Start      | Finish     | Deadline   | Exec Time | Status\n");
+    printf("-------+------------+------------+------------+------------+-----------+---------\n");
+
+    /* Print all logged executions */
+    for (uint32_t i = 0; i < log_count; i++) {
+        const char* status;
+        if (log_buffer[i].skipped) {
+            status = "SKIPPED";
+        } else if (log_buffer[i].deadline_missed) {
+            status = "  MISS ";
+        } else {
+            status = "   OK  ";
+        }
+
+        printf("%-6s | %10llu | %10llu | %10llu | %10llu | %6llu us | %s\n",
+               log_buffer[i].task_name,
+               log_buffer[i].release_time,
+               log_buffer[i].start_time,
+               log_buffer[i].finish_time,
+               log_buffer[i].deadline,
+               log_buffer[i].exec_time,
+               status);
+    }
+    printf("========================================================================\n");
+    printf("Total logs: %u\n", log_count);
+    printf("Deadline misses: %u\n", deadline_misses);
+    printf("Tasks skipped: %u\n", skipped_count);
+    if (ENABLE_DEADLINE_ALARM) {
+        deadline_alarm_print();
+        for (uint32_t i = 0; i < alarm_count; i++) {
+            printf("  Missed at deadline: %s, deadline %llu us, detected %u us late\n",
+                   task_set[alarm_log[i].job]->name, alarm_log[i].deadline_us,
+                   alarm_log[i].latency_us);
+        }
+    }
+    if (FPU_CONTEXT_RELEASE) {
+        printf("FP contexts dropped after jobs (integer-only tasks):");
+        for (int i = 0; i < NUM_TASKS; i++) {
+            printf(" %s %u", task_set[i]->name, task_set[i]->fpu_releases);
+        }
+        printf("\n");
+    }
+    for (uint32_t i = 0; i < NUM_LET_CONSUMERS; i++) {
+        printf("LET data age %s: last %llu us, max %llu us\n",
+               let_consumers[i]->name, let_consumers[i]->last_data_age,
+               let_consumers[i]->max_data_age);
+    }
+    printf("Chain %s: data age last %llu us, max %llu us (bound %llu us), latency bound %llu us\n",
+           chains[0].name, chain_age_last, chain_age_max,
+           chain_bounds[0].max_age_us, chain_bounds[0].max_latency_us);
+    if (SEMI_PARTITIONED && migration_count > 0) {
+        printf("Migrations: %u, cost last %llu us, max %llu us\n",
+               migration_count, migration_cost_last, migration_cost_max);
+    }
+    if (HIERARCHICAL) {
+        uint64_t util_x100 = (partition_supply_us > 0) ? (partition_busy_us * 10000) / partition_supply_us : 0;
+        printf("Partition: budget %u us / %u ms, supplied %llu us, used %llu us (%llu.%02llu%%), "
+               "cut at frame end %u, executive overruns %u\n",
+               partition_budget_us, HIER_FRAME_MS, partition_supply_us, partition_busy_us,
+               util_x100 / 100, util_x100 % 100, partition_cuts, executive_overruns);
+        for (int i = 0; i < NUM_TASKS; i++) {
+            if (task_set[i]->in_executive) {
+                continue;
+            }
+            printf("  %s: response max %u us", task_set[i]->name, task_set[i]->max_response_us);
+            if (partition_bound_us[i] != RTA_UNSCHEDULABLE) {
+                printf(" (bound %u us)\n", partition_bound_us[i]);
+            } else {
+                printf(" (no bound)\n");
+            }
+        }
+    }
+    if (TIME_PARTITIONED && partition_switch_count > 0) {
+        printf("Partition switches: %u, overhead last %llu us, max %llu us, mean %llu us\n",
+               partition_switch_count, partition_switch_last_us, partition_switch_max_us,
+               partition_switch_total_us / partition_switch_count);
+        printf("Isolation: window start lateness max %llu us, overruns %u; misses since start",
+               window_lateness_max_us, window_overruns);
+        for (int p = 0; p < NUM_PARTITIONS; p++) {
+            printf(" P%u %u", p, partition_misses[p]);
+        }
+        printf("\n");
+    }
+    if (FORK_JOIN_E && task_E_fj.join_time != 0) {
+        uint64_t speedup_x100 = (task_E_fj_stats.work_us * 100) / task_E_fj_stats.span_us;
+        printf("Fork-join Task_E: span %llu us (max %llu us), work %llu us, speedup %llu.%02llu, "
+               "fork %llu us, join %llu us\n",
+               task_E_fj_stats.span_us, task_E_fj_span_max, task_E_fj_stats.work_us,
+               speedup_x100 / 100, speedup_x100 % 100,
+               task_E_fj_stats.fork_us, task_E_fj_stats.join_us);
+    }
+    if (ENABLE_ISR_LOAD) {
+        isr_load_print(&isr_load);
+        if (!SEMI_PARTITIONED && !HIERARCHICAL && !TIME_PARTITIONED) {
+            print_isr_interference(&isr_load);
+        }
+    }
+    if (OVERLOAD_PREDICTION) {
+        overload_print(&overload);
+    }
+    if (ENABLE_SELF_CHECK) {
+        fuzz_print_invariants(&invariants);
+    }
+    if (ENABLE_FAULT_INJECTION) {
+        fault_print_log(time_us_64());
+    }
+    if (ENABLE_TRACE_BUDGET) {
+        trace_budget_print(&trace_budget);
+    }
+    if (overload_event) {
+        printf("\n*** EARLY WARNING: overload predicted at %llu us, %s headroom %ld us ***\n",
+               overload.warning_us, task_set[overload_tightest]->name, (long)overload.warning_headroom_us);
+    }
+    if (deadline_misses > 0 || alarm_count > 0) {
+        printf("\n*** WARNING: Deadline violations detected! ***\n");
+        printf("Response Strategy: SKIP TASK_C IF INSUFFICIENT TIME BEFORE EXECUTION\n");
+    }
+    printf("====================================\n\n");
+}
+/*-----------------------------------------------------------*/
+
 /**
  * @brief Monitor task implementation
  *
@@ -316,49 +1302,83 @@ void monitor_task(void *args)
     for (;;) {
         hyperperiod_count++;
 
-        printf("\n========== Hyperperiod %u ==========\n", hyperperiod_count);
-
         /* Get exclusive access to log buffer */
         if (xSemaphoreTake(log_mutex, portMAX_DELAY) == pdTRUE) {
             uint32_t deadline_misses = 0;
             uint32_t skipped_count = 0;
+            uint32_t logged_misses = 0;  /* Not counted by the alarm */
 
-            /* Print header */
-            printf("Task   | Release    | Start      | Finish     | Deadline   | Exec Time | Status\n");
-            printf("-------+------------+------------+------------+------------+-----------+---------\n");
+            /* Close the miss count and take the alarm's records together, so
+             * a miss detected meanwhile goes to the next hyperperiod in both */
+            static deadline_miss_t alarm_log[DEADLINE_ALARM_QUEUE_LEN];
+            uint32_t alarm_count = 0;
+            deadline_alarm_stats_t alarm_stats = {0};
+            taskENTER_CRITICAL();
+            uint32_t misses = misses_counted;
+            misses_counted = 0;
+            while (ENABLE_DEADLINE_ALARM && alarm_count < DEADLINE_ALARM_QUEUE_LEN &&
+                   deadline_alarm_take_miss(&alarm_log[alarm_count])) {
+                alarm_count++;
+            }
+            taskEXIT_CRITICAL();
 
-            /* Print all logged executions */
             for (uint32_t i = 0; i < log_count; i++) {
-                const char* status;
                 if (log_buffer[i].skipped) {
-                    status = "SKIPPED";
                     skipped_count++;
+                }
+                if (log_buffer[i].deadline_missed || log_buffer[i].skipped) {
                     deadline_misses++;
-                } else if (log_buffer[i].deadline_missed) {
-                    status = "  MISS ";
-                    deadline_misses++;
-                } else {
-                    status = "   OK  ";
                 }
+                if (log_buffer[i].deadline_missed && !log_buffer[i].alarmed) {
+                    logged_misses++;
+                }
+            }
+            if (ENABLE_DEADLINE_ALARM) {
+                deadline_alarm_get_stats(&alarm_stats);
+            }
+            if (ENABLE_ISR_LOAD) {
+                isr_load_sample(&isr_load);
+            }
+            /* Warnings raised by the jobs since the last report */
+            static uint32_t overload_warnings_reported = 0;
+            bool overload_event = (overload.warnings != overload_warnings_reported);
+            overload_warnings_reported = overload.warnings;
+            if (ENABLE_SELF_CHECK) {
+                /* The log-derived count plus the alarm's records must match
+                 * the count kept by the tasks and the alarm */
+                static uint32_t alarm_lost_seen = 0;
+                if (log_count < MAX_LOGS_PER_HYPERPERIOD && alarm_stats.lost == alarm_lost_seen &&
+                    logged_misses + alarm_count != misses) {
+                    invariants.miss_mismatches++;
+                }
+                alarm_lost_seen = alarm_stats.lost;
+            }
+
+            /* Misses, alarms and overload warnings always get a full report */
+            bool detail = true;
+            uint64_t report_start = time_us_64();
+            if (ENABLE_TRACE_BUDGET) {
+                detail = trace_budget_detail(&trace_budget, deadline_misses > 0 || alarm_count > 0 ||
+                                                            overload_event);
+            }
 
-                printf("%-6s | %10llu | %10llu | %10llu | %10llu | %6llu us | %s\n",
-                       log_buffer[i].task_name,
-                       log_buffer[i].release_time,
-                       log_buffer[i].start_time,
-                       log_buffer[i].finish_time,
-                       log_buffer[i].deadline,
-                       log_buffer[i].exec_time,
-                       status);
+            if (detail) {
+                print_hyperperiod_report(hyperperiod_count, deadline_misses, skipped_count,
+                                         alarm_log, alarm_count, overload_event);
+            } else {
+                /* Same header as a full report, so the analyzer counts it */
+                printf("\n========== Hyperperiod %u Summary: %u logs, %u miss(es), %u skipped; "
+                       "trace last %u us, credit %lld us, detail dropped %u\n",
+                       hyperperiod_count, log_count, deadline_misses, skipped_count,
+                       trace_budget.last_cost_us, trace_budget.credit_us, trace_budget.detail_dropped);
             }
-            printf("========================================================================\n");
-            printf("Total logs: %u\n", log_count);
-            printf("Deadline misses: %u\n", deadline_misses);
-            printf("Tasks skipped: %u\n", skipped_count);
-            if (deadline_misses > 0) {
-                printf("\n*** WARNING: Deadline violations detected! ***\n");
-                printf("Response Strategy: SKIP TASK_C IF INSUFFICIENT TIME BEFORE EXECUTION\n");
+            if (ENABLE_TRACE_BUDGET) {
+                trace_budget_charge(&trace_budget, detail, (uint32_t)(time_us_64() - report_start));
+            }
+            if (HIERARCHICAL) {
+                partition_supply_us = 0;
+                partition_busy_us = 0;
             }
-            printf("====================================\n\n");
 
             /* Reset log buffer for next hyperperiod */
             log_count = 0;
@@ -371,3 +1391,273 @@ void monitor_task(void *args)
     }
 }
 /*-----------------------------------------------------------*/
+
+/**
+ * @brief Fork-join worker implementation
+ *
+ * Waits for Task_E to fork, runs the remaining segments and signals the join.
+ */
+void fj_worker_task(void *args)
+{
+    fj_job_t *job = (fj_job_t *)args;
+
+    for (;;) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+        for (uint8_t s = 1; s < job->num_segments; s++) {
+            fj_run_segment(job, s);
+        }
+
+        xSemaphoreGive(fj_join_sem);
+    }
+}
+/*-----------------------------------------------------------*/
+
+#if SEMI_PARTITIONED || HIERARCHICAL || ENABLE_ISR_LOAD || ENABLE_OVERLOAD_WARNING
+/**
+ * @brief Fill the response-time analysis model of a task
+ */
+static void rta_task_of(uint8_t task, rta_task_t *rta_task)
+{
+#if USE_PWCET_BUDGETS
+    /* Measured pWCET estimates */
+    static const uint32_t wcet_cycles[NUM_TASKS] = {
+        [TASK_A] = PWCET_BUDGET_US_TASK_A * CYCLES_PER_US, [TASK_B] = PWCET_BUDGET_US_TASK_B * CYCLES_PER_US,
+        [TASK_C] = PWCET_BUDGET_US_TASK_C * CYCLES_PER_US, [TASK_D] = PWCET_BUDGET_US_TASK_D * CYCLES_PER_US,
+        [TASK_E] = PWCET_BUDGET_US_TASK_E * CYCLES_PER_US, [TASK_F] = PWCET_BUDGET_US_TASK_F * CYCLES_PER_US,
+    };
+#else
+    static const uint32_t wcet_cycles[NUM_TASKS] = {
+        [TASK_A] = EXECUTION_TIME_A, [TASK_B] = EXECUTION_TIME_B, [TASK_C] = EXECUTION_TIME_C_MAX,
+        [TASK_D] = EXECUTION_TIME_D, [TASK_E] = EXECUTION_TIME_E, [TASK_F] = EXECUTION_TIME_F,
+    };
+#endif
+
+    rta_task->period_us = task_set[task]->period_ms * 1000;
+    rta_task->deadline_us = task_set[task]->deadline_ms * 1000;
+    rta_task->wcet_us = wcet_cycles[task] / CYCLES_PER_US;
+    rta_task->jitter_us = 0;
+    rta_task->priority = (uint8_t)task_set[task]->priority;
+}
+/*-----------------------------------------------------------*/
+#endif
+
+static void semi_partition_setup(void)
+{
+#if SEMI_PARTITIONED
+    rta_task_t rta_tasks[NUM_TASKS];
+    rta_assignment_t assignment[NUM_TASKS];
+    bool selected[NUM_TASKS] = {false};
+
+    for (int i = 0; i < NUM_TASKS; i++) {
+        rta_task_of(i, &rta_tasks[i]);
+    }
+    selected[TASK_C] = true;  /* Large variable WCET: split across the cores */
+
+    if (!rta_partition(rta_tasks, NUM_TASKS, selected, true, assignment)) {
+        printf("Semi-partitioning failed, tasks stay unpinned\n");
+        return;
+    }
+
+    printf("Semi-partitioned assignment:\n");
+    for (int i = 0; i < NUM_TASKS; i++) {
+        task_set[i]->core = assignment[i].core;
+        task_set[i]->split_core = assignment[i].split_core;
+        task_set[i]->split_budget_us = assignment[i].budget_us;
+        vTaskCoreAffinitySet(task_set[i]->handle, (1 << assignment[i].core));
+
+        if (assignment[i].budget_us != 0) {
+            printf("  %s: core %u for %u us, then core %u\n", task_set[i]->name,
+                   assignment[i].core, assignment[i].budget_us, assignment[i].split_core);
+        } else {
+            printf("  %s: core %u\n", task_set[i]->name, assignment[i].core);
+        }
+    }
+
+    /* Acceptance ratio of random task sets: same sets for both methods */
+    printf("Acceptance ratio (100 task sets each):\n");
+    printf("  Util | Partitioned | Semi-partitioned\n");
+    for (uint32_t util = 100; util <= 200; util += 10) {
+        uint32_t seed_partitioned = util * 2654435761u + 1;
+        uint32_t seed_semi = seed_partitioned;
+        printf("  %3u%% | %10u%% | %15u%%\n", util,
+               rta_acceptance_ratio(util, 100, false, &seed_partitioned),
+               rta_acceptance_ratio(util, 100, true, &seed_semi));
+    }
+    printf("\n");
+#endif
+}
+/*-----------------------------------------------------------*/
+
+static void run_split_job(task_params_t *params, jobReturn_t *result)
+{
+#if SEMI_PARTITIONED
+    /* Only Task_C is split; its length is known from the switches at release */
+    uint32_t cycles = job_C_cycles();
+    uint32_t budget = params->split_budget_us * CYCLES_PER_US;
+    jobReturn_t portion;
+
+    /* First portion runs at the highest priority on the home core */
+    vTaskPrioritySet(NULL, SPLIT_PORTION_PRIORITY);
+    job_run_cycles(&portion, (cycles < budget) ? cycles : budget);
+    result->start = portion.start;
+
+    if (cycles > budget) {
+        /* Budget point: migrate and continue at the task's own priority */
+        uint64_t migrate_start = time_us_64();
+        vTaskCoreAffinitySet(NULL, (1 << params->split_core));
+        vTaskPrioritySet(NULL, params->priority);
+        migration_cost_last = time_us_64() - migrate_start;
+        if (migration_cost_last > migration_cost_max) {
+            migration_cost_max = migration_cost_last;
+        }
+        migration_count++;
+
+        job_run_cycles(&portion, cycles - budget);
+
+        /* The next job starts on the home core again */
+        vTaskCoreAffinitySet(NULL, (1 << params->core));
+    } else {
+        vTaskPrioritySet(NULL, params->priority);
+    }
+    result->stop = portion.stop;
+#else
+    (void)params;
+    (void)result;
+#endif
+}
+/*-----------------------------------------------------------*/
+
+static void hierarchical_setup(void)
+{
+#if HIERARCHICAL
+    rta_task_t critical;
+    rta_task_t inner[NUM_TASKS];
+    uint8_t inner_task[NUM_TASKS];
+    uint8_t num_inner = 0;
+    uint32_t frame_us = HIER_FRAME_MS * 1000;
+    uint32_t reservation_max = 0;
+
+    /* Executive: WCETs of each frame's critical jobs plus the dispatch margin */
+    for (int f = 0; f < EXECUTIVE_TABLE_FRAMES; f++) {
+        executive_reservation_us[f] = EXECUTIVE_MARGIN_US;
+        for (uint8_t j = 0; j < executive_table[f].num_jobs; j++) {
+            rta_task_of(executive_table[f].tasks[j], &critical);
+            executive_reservation_us[f] += critical.wcet_us;
+        }
+        if (executive_reservation_us[f] > reservation_max) {
+            reservation_max = executive_reservation_us[f];
+        }
+    }
+
+    /* The partition is guaranteed what the worst frame leaves: a periodic
+     * resource of that budget every frame */
+    partition_budget_us = (reservation_max < frame_us) ? frame_us - reservation_max : 0;
+
+    for (int i = 0; i < NUM_TASKS; i++) {
+        partition_bound_us[i] = RTA_UNSCHEDULABLE;
+        if (!task_set[i]->in_executive) {
+            inner_task[num_inner] = i;
+            rta_task_of(i, &inner[num_inner++]);
+        }
+    }
+
+    printf("Hierarchical schedule: executive runs Task_B, Task_A in %u ms frames\n", HIER_FRAME_MS);
+    printf("Partition resource: %u us every %u us (bandwidth %u%%)\n",
+           partition_budget_us, frame_us, (partition_budget_us * 100) / frame_us);
+    for (uint8_t k = 0; k < num_inner; k++) {
+        uint32_t bound = rta_response_time_supply(inner, num_inner, k, frame_us, partition_budget_us);
+        partition_bound_us[inner_task[k]] = bound;
+        if (bound != RTA_UNSCHEDULABLE) {
+            printf("  %s: response bound %u us (deadline %u us)\n", task_set[inner_task[k]]->name,
+                   bound, inner[k].deadline_us);
+        } else {
+            printf("  %s: not schedulable in the partition\n", task_set[inner_task[k]]->name);
+        }
+    }
+    uint32_t min_budget = rta_min_supply_budget(inner, num_inner, frame_us);
+    if (min_budget != RTA_UNSCHEDULABLE) {
+        printf("Minimum partition budget: %u us per frame\n\n", min_budget);
+    } else {
+        printf("Minimum partition budget: none, the partition needs more than the full frame\n\n");
+    }
+#endif
+}
+/*-----------------------------------------------------------*/
+
+static void print_isr_interference(const isr_load_t *load)
+{
+#if ENABLE_ISR_LOAD
+    rta_task_t rta_tasks[NUM_TASKS];
+    rta_irq_t irqs[ISR_LOAD_MAX_SOURCES];
+    uint8_t num_irqs = isr_load_model(load, irqs, ISR_LOAD_MAX_SOURCES);
+
+    for (int i = 0; i < NUM_TASKS; i++) {
+        rta_task_of(i, &rta_tasks[i]);
+    }
+
+    printf("Response bounds without/with interrupts:");
+    for (int i = 0; i < NUM_TASKS; i++) {
+        uint32_t plain = rta_response_time(rta_tasks, NUM_TASKS, i);
+        uint32_t with_irq = rta_response_time_irq(rta_tasks, NUM_TASKS, i, irqs, num_irqs);
+
+        printf(" %s ", task_set[i]->name);
+        if (plain != RTA_UNSCHEDULABLE) {
+            printf("%u", plain);
+        } else {
+            printf("-");
+        }
+        if (with_irq != RTA_UNSCHEDULABLE) {
+            printf("/%u us", with_irq);
+        } else {
+            printf("/- us");
+        }
+    }
+    printf("\n");
+#else
+    (void)load;
+#endif
+}
+/*-----------------------------------------------------------*/
+
+static void predict_overload(const isr_load_t *load)
+{
+#if ENABLE_OVERLOAD_WARNING
+    rta_task_t rta_tasks[NUM_TASKS];
+    rta_irq_t irqs[ISR_LOAD_MAX_SOURCES];
+    uint8_t num_irqs = ENABLE_ISR_LOAD ? isr_load_model(load, irqs, ISR_LOAD_MAX_SOURCES) : 0;
+    int32_t headroom = INT32_MAX;
+    uint8_t tightest = 0;
+
+    /* Task_C at the current switch setting */
+    overload_forecast(&overload, TASK_C, job_C_exec_us(workload_switch_value()));
+
+    /* Measured times include preemptions, so the estimates err high. The
+     * analysis runs up to two periods past the release to size a miss. */
+    for (int i = 0; i < NUM_TASKS; i++) {
+        rta_task_of(i, &rta_tasks[i]);
+        rta_tasks[i].wcet_us = overload_demand_us(&overload, i);
+        rta_tasks[i].deadline_us = 2 * rta_tasks[i].period_us;
+    }
+    for (int i = 0; i < NUM_TASKS; i++) {
+        uint32_t response = rta_response_time_irq(rta_tasks, NUM_TASKS, i, irqs, num_irqs);
+        uint32_t deadline_us = task_set[i]->deadline_ms * 1000;
+        if (response == RTA_UNSCHEDULABLE) {
+            response = rta_tasks[i].deadline_us;
+        }
+        int32_t slack = (int32_t)deadline_us - (int32_t)response;
+        if (slack < headroom) {
+            headroom = slack;
+            tightest = i;
+        }
+    }
+
+    /* Printed by the monitor's next report */
+    if (overload_predict(&overload, headroom, time_us_64())) {
+        overload_tightest = tightest;
+    }
+#else
+    (void)load;
+#endif
+}
+/*-----------------------------------------------------------*/
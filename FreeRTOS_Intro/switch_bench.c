@@ -0,0 +1,121 @@
+/**
+ * @file switch_bench.c
+ * @brief Context switch benchmark: two tasks of equal priority yield to
+ *        each other, and each switch is timed from the yield in one task
+ *        to the return from the yield in the other.
+ *
+ * Build it with configCHECK_FOR_STACK_OVERFLOW 0 (stack limit in hardware
+ * only, the default) and with 2 (the kernel's software check on every
+ * switch, cmake -DFREERTOS_STACK_CHECK=2) to compare the cost of the two.
+ * Each build runs integer-only tasks, tasks with an FP context (the port
+ * saves and restores the FP registers) and tasks that use the FPU but drop
+ * the context before yielding. Results are printed as CSV lines starting
+ * with "SWITCH,".
+ */
+#include <stdio.h>
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+#include "workload.h"
+#include "fpu_context.h"
+#include "benchmarks.h"
+
+#define SWITCH_COUNT 10000       /* Timed switches */
+#define SWITCH_PRIORITY 2
+
+typedef enum {
+    SWITCH_INTEGER,       /* No FP instruction: no FP context */
+    SWITCH_FPU,           /* FP instruction before each yield */
+    SWITCH_FPU_RELEASED,  /* Same, with the context dropped before the yield */
+    NUM_SWITCH_MODES
+} switch_mode_t;
+
+static const char* mode_names[NUM_SWITCH_MODES] = { "integer", "fpu", "fpu_released" };
+
+/* In cycles */
+typedef struct {
+    uint32_t count;
+    uint32_t min;
+    uint32_t max;
+    uint64_t total;
+} switch_result_t;
+
+static volatile uint32_t yield_cycles;  /* Cycle count just before the last yield */
+static volatile bool measuring;
+static switch_result_t result;
+static SemaphoreHandle_t switch_done;
+static switch_mode_t mode;
+static volatile float fp_sink;
+
+static void switch_task(void *arg) {
+    while (measuring) {
+        if (mode != SWITCH_INTEGER) {
+            fp_sink = fp_sink + 1.0f;
+        }
+        if (mode == SWITCH_FPU_RELEASED) {
+            fpu_context_release();
+        }
+        yield_cycles = bench_cycles();
+        taskYIELD();
+        uint32_t cycles = bench_cycles() - yield_cycles;
+
+        if (result.count < SWITCH_COUNT) {
+            result.total += cycles;
+            if (cycles < result.min) {
+                result.min = cycles;
+            }
+            if (cycles > result.max) {
+                result.max = cycles;
+            }
+            result.count++;
+        } else {
+            measuring = false;
+        }
+    }
+    xSemaphoreGive(switch_done);
+    vTaskSuspend(NULL);  /* Deleted by the controller */
+}
+/*-----------------------------------------------------------*/
+
+static uint32_t cycles_to_ns(uint64_t cycles) {
+    return (uint32_t)((cycles * 1000) / CYCLES_PER_US);
+}
+
+/**
+ * @brief Time SWITCH_COUNT switches between two tasks on core 0 in the
+ *        current mode.
+ */
+static void run_mode(const char *stack_check) {
+    result = (switch_result_t){ .min = UINT32_MAX };
+    measuring = true;
+
+    /* Both start once the controller blocks; a tick may land in a switch
+     * and shows in the maximum */
+    TaskHandle_t ping = bench_create_on_core(switch_task, "SW_Ping", SWITCH_PRIORITY, 0);
+    TaskHandle_t pong = bench_create_on_core(switch_task, "SW_Pong", SWITCH_PRIORITY, 0);
+    xSemaphoreTake(switch_done, portMAX_DELAY);
+    xSemaphoreTake(switch_done, portMAX_DELAY);
+    vTaskDelete(ping);
+    vTaskDelete(pong);
+    vTaskDelay(1);  /* The idle task frees the deleted tasks */
+
+    printf("SWITCH,%s,%s,%u,%u,%u,%u\n", stack_check, mode_names[mode], result.count,
+           cycles_to_ns(result.min), cycles_to_ns(result.total / result.count), cycles_to_ns(result.max));
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Context switch cost in every FPU mode.
+ */
+void switch_benchmark(void) {
+    const char *stack_check = (configCHECK_FOR_STACK_OVERFLOW == 0) ? "psplim" :
+                              (configCHECK_FOR_STACK_OVERFLOW == 1) ? "psplim+sw1" : "psplim+sw2";
+
+    switch_done = xSemaphoreCreateCounting(2, 0);
+    printf("SWITCH,stack_check,fpu,switches,min_ns,avg_ns,max_ns\n");
+    for (mode = 0; mode < NUM_SWITCH_MODES; mode++) {
+        run_mode(stack_check);
+    }
+    vSemaphoreDelete(switch_done);
+}
+/*-----------------------------------------------------------*/
@@ -0,0 +1,170 @@
+/**
+ * @file fuzz_dispatch.c
+ * @brief Host fuzz target for the run-time dispatch of CyclicSched.
+ *
+ * CyclicSched/main.c is compiled in as it is, on the simulated platform of
+ * host/host.c: its start-up runs until the main loop idles, then the input
+ * drives the frame timer. Per frame one byte sets the switches read by
+ * Task_C's job_C_cycles() and one byte may fire the timer late. The jobs
+ * wait on the simulated clock, so overruns, resync drops, deadline alarms
+ * and the logs behave as on the target, and the scheduler's own self-check
+ * collects the invariants. Stalls and misses are legitimate under overload;
+ * early starts, miss or job count mismatches and dropped logs are not.
+ *
+ * The FreeRTOS periodic tasks need the kernel and stay covered by the
+ * on-target run (FUZZ_INPUTS in FreeRTOS_Intro/main.c).
+ */
+#include <setjmp.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "host.h"
+
+#define main cyclic_main
+#include "main.c"
+#undef main
+
+#define MAX_DISPATCH_FRAMES (3 * NUM_FRAMES)  /* Frames run per input */
+#define LATE_TIMER_STEP_US 250                /* Lateness per step of a late-timer byte */
+
+/* Input bytes, consumed front to back; zeros once they run out */
+typedef struct {
+    const uint8_t *data;
+    size_t size;
+} input_t;
+
+static uint8_t next_byte(input_t *in) {
+    if (in->size == 0) {
+        return 0;
+    }
+    in->size--;
+    return *in->data++;
+}
+/*-----------------------------------------------------------*/
+
+static jmp_buf started;
+static uint8_t switch_value = 0;
+
+static void start_up_done(void) {
+    longjmp(started, 1);
+}
+/*-----------------------------------------------------------*/
+
+static uint8_t input_switch_source(void) {
+    return switch_value;
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Return the scheduler to its state at boot. The simulated clock and
+ *        the deadline alarms keep running: their pending records are taken
+ *        here, so they do not leak into the next run.
+ */
+static void dispatch_reset(void) {
+    deadline_miss_t miss;
+    deadline_alarm_stats_t alarm_stats;
+
+    for (uint8_t t = 0; t < NUM_TASKS; t++) {
+        deadline_alarm_disarm(t, NULL);
+    }
+    while (deadline_alarm_take_miss(&miss)) {
+    }
+    deadline_alarm_get_stats(&alarm_stats);
+    alarm_lost_seen = alarm_stats.lost;
+
+    current_frame = 0;
+    num_frames = NUM_FRAMES;
+    hyperperiod_us = (uint64_t)HYPERPERIOD_MS * 1000;
+    job_count = 0;
+    hyperperiod_count = 0;
+    scheduler_start_time = 0;
+    frame_timer_target = 0;
+    hyperperiod_start = 0;
+    deadline_misses_current = 0;
+    deadline_misses_total = 0;
+    alarm_count = 0;
+    invariants = (invariants_t){0};
+    frames_dropped = 0;
+    frames_dropped_reported = 0;
+    frame_budget_max_us = 0;
+    memset(start_stats, 0, sizeof(start_stats));
+    edf_queue_len = 0;
+    memset(edf_released, 0, sizeof(edf_released));
+    memset(edf_completed, 0, sizeof(edf_completed));
+    edf_overflows = 0;
+    for (uint32_t i = 0; i < NUM_LET_BINDINGS; i++) {
+        let_bindings[i].seq = 0;
+        let_bindings[i].last_age = 0;
+        let_bindings[i].max_age = 0;
+    }
+    chain_age_last = 0;
+    chain_age_max = 0;
+    task_E_fj_span_max = 0;
+    tt_next = 0;
+    tt_dispatch_error = 0;
+    tt_dispatch_error_last = 0;
+    tt_dispatch_error_max = 0;
+    report_pending = false;
+    reports_dropped = 0;
+    overload_warnings_reported = 0;
+    overload_event = false;
+    overload_num_irqs = 0;
+    host_reset_timer();
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Fuzzer entry point.
+ *
+ * Layout: per frame the switch setting of that frame's Task_C job and a
+ * timer byte; values from 0xe0 fire the frame timer (byte - 0xe0) *
+ * LATE_TIMER_STEP_US late, smaller ones on time.
+ */
+int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size) {
+    static bool quiet = false;
+    input_t in = { data, size };
+
+    /* The scheduler's reports go nowhere; failures are written to stderr */
+    if (!quiet) {
+        quiet = (freopen("/dev/null", "w", stdout) != NULL);
+    }
+
+    dispatch_reset();
+    host_set_idle_hook(start_up_done);
+    if (setjmp(started) == 0) {
+        cyclic_main();
+    }
+    host_set_idle_hook(NULL);
+
+    repeating_timer_t *timer = host_repeating_timer();
+    if (timer == NULL) {
+        fprintf(stderr, "Dispatch fuzz: start-up failed\n");
+        abort();
+    }
+    workload_set_switch_source(input_switch_source);
+
+    uint32_t frames = (uint32_t)((size + 1) / 2);
+    if (frames > MAX_DISPATCH_FRAMES) {
+        frames = MAX_DISPATCH_FRAMES;
+    }
+    uint64_t fire_us = time_us_64() + (uint64_t)(-timer->delay_us);
+    for (uint32_t f = 0; f < frames; f++) {
+        switch_value = next_byte(&in);
+        uint8_t late = next_byte(&in);
+
+        host_wait_until(fire_us + ((late >= 0xe0) ? (uint64_t)(late - 0xe0) * LATE_TIMER_STEP_US : 0));
+        timer->callback(timer);
+        fire_us += (uint64_t)(-timer->delay_us);
+    }
+
+    if (invariants.early_starts != 0 || invariants.dropped_logs != 0 ||
+        invariants.miss_mismatches != 0 || invariants.job_count_mismatches != 0) {
+        fprintf(stderr, "Dispatch fuzz: %u frames, %u hyperperiods: early starts %u, dropped logs %u, "
+                "miss mismatches %u, job count mismatches %u\n", frames, hyperperiod_count,
+                invariants.early_starts, invariants.dropped_logs, invariants.miss_mismatches,
+                invariants.job_count_mismatches);
+        abort();
+    }
+    workload_set_switch_source(NULL);
+    return 0;
+}
+/*-----------------------------------------------------------*/
@@ -0,0 +1,71 @@
+/**
+ * @file fuzz_main.c
+ * @brief Stand-alone driver for compilers without libFuzzer.
+ *
+ * Replays the inputs given as files (a crash reproducer or a corpus), or
+ * without files runs random inputs drawn from a seed.
+ *
+ * Usage: fuzz_schedule [-n runs] [-s seed] [input...]
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include "fuzz.h"
+
+#define MAX_INPUT 256
+
+int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size);
+
+static int replay(const char *path) {
+    static uint8_t data[MAX_INPUT];
+    FILE *f = fopen(path, "rb");
+
+    if (f == NULL) {
+        perror(path);
+        return EXIT_FAILURE;
+    }
+    size_t size = fread(data, 1, sizeof(data), f);
+    fclose(f);
+    LLVMFuzzerTestOneInput(data, size);
+    return EXIT_SUCCESS;
+}
+/*-----------------------------------------------------------*/
+
+int main(int argc, char **argv) {
+    uint32_t runs = 10000;
+    uint32_t seed = 1;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "n:s:")) != -1) {
+        switch (opt) {
+        case 'n': runs = (uint32_t)strtoul(optarg, NULL, 0); break;
+        case 's': seed = (uint32_t)strtoul(optarg, NULL, 0); break;
+        default:
+            fprintf(stderr, "Usage: %s [-n runs] [-s seed] [input...]\n", argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    if (optind < argc) {
+        int status = EXIT_SUCCESS;
+        for (int i = optind; i < argc; i++) {
+            if (replay(argv[i]) != EXIT_SUCCESS) {
+                status = EXIT_FAILURE;
+            }
+        }
+        return status;
+    }
+
+    uint32_t state = (seed != 0) ? seed : 1;
+    uint8_t data[MAX_INPUT];
+    for (uint32_t r = 0; r < runs; r++) {
+        size_t size = fuzz_rand(&state) % sizeof(data);
+        for (size_t i = 0; i < size; i++) {
+            data[i] = (uint8_t)fuzz_rand(&state);
+        }
+        LLVMFuzzerTestOneInput(data, size);
+    }
+    printf("Schedule fuzz: %u random inputs from seed %u passed\n", runs, seed);
+    return EXIT_SUCCESS;
+}
+/*-----------------------------------------------------------*/
@@ -0,0 +1,179 @@
+/**
+ * @file fuzz_schedule.c
+ * @brief Host fuzz target for the schedule synthesis and checking of
+ *        CyclicSched.
+ *
+ * The input bytes are decoded into a task set and a sequence of switch
+ * settings. Task 0 stands for Task_C: at each switch setting its WCET
+ * follows the switches as on the target, and the set is synthesized into a
+ * frame table, checked and turned into a time-triggered table. Any broken
+ * property aborts, so the fuzzer (or the sanitizers) report the input.
+ *
+ * The dispatch of the resulting tables at run time is fuzzed by
+ * fuzz_dispatch.c.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "schedule.h"
+#include "fuzz.h"
+
+#define MAX_TASKS 6      /* Tasks per set, as in schedule_fuzz() */
+#define MAX_SWITCHES 16  /* Switch settings tried per input */
+
+/* Input bytes, consumed front to back; zeros once they run out */
+typedef struct {
+    const uint8_t *data;
+    size_t size;
+} input_t;
+
+static uint8_t next_byte(input_t *in) {
+    if (in->size == 0) {
+        return 0;
+    }
+    in->size--;
+    return *in->data++;
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Print the offending task set and stop.
+ */
+static void fail(const task_set_t *set, uint8_t sw, const char *property) {
+    printf("Schedule fuzz: switches %u: %s\n", sw, property);
+    for (uint8_t t = 0; t < set->num_tasks; t++) {
+        printf("  %s: T=%u ms, D=%u ms, C=%u us\n", set->tasks[t].name,
+               set->tasks[t].period_ms, set->tasks[t].deadline_ms, set->tasks[t].wcet_us);
+    }
+    for (uint8_t e = 0; e < set->num_edges; e++) {
+        printf("  %s -> %s\n", set->tasks[set->edges[e].pred].name, set->tasks[set->edges[e].succ].name);
+    }
+    fflush(stdout);
+    abort();
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Replay a time-triggered table and collect the invariants a
+ *        scheduler dispatching it would observe.
+ *
+ * A job starting before its release or before the previous job and its gap
+ * are done counts as an early start, one finishing after its deadline as a
+ * miss the table should not have, and a table with a different number of
+ * jobs than the hyperperiod holds as a job count mismatch. These are the
+ * rules schedule_timetable() places the jobs by, checked independently on
+ * its result.
+ */
+static void timetable_invariants(const task_set_t *set, const timetable_entry_t *table,
+                                 uint32_t count, invariants_t *inv) {
+    uint32_t jobs = 0;
+    uint64_t free_us = 0;
+
+    *inv = (invariants_t){0};
+    for (uint8_t t = 0; t < set->num_tasks; t++) {
+        jobs += HYPERPERIOD_MS / set->tasks[t].period_ms;
+    }
+    if (count != jobs) {
+        inv->job_count_mismatches++;
+    }
+
+    for (uint32_t i = 0; i < count; i++) {
+        const task_desc_t *task = &set->tasks[table[i].task];
+        uint64_t release = (uint64_t)table[i].job * task->period_ms * 1000;
+        uint64_t finish = table[i].start_us + task->wcet_us;
+
+        if (table[i].start_us < release || table[i].start_us < free_us) {
+            inv->early_starts++;
+        }
+        if (finish > release + (uint64_t)task->deadline_ms * 1000) {
+            inv->miss_mismatches++;
+        }
+        if (table[i].start_us >= release + (uint64_t)task->period_ms * 1000) {
+            inv->stalls++;
+        }
+        if (table[i].start_us > release && table[i].start_us - release > inv->max_lateness_us) {
+            inv->max_lateness_us = table[i].start_us - release;
+        }
+        free_us = finish + TIMETABLE_GAP_US;
+    }
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Fuzzer entry point.
+ *
+ * Layout: number of tasks; per task a period index, deadline in frames,
+ * two WCET bytes and a mask of its predecessors among the earlier tasks;
+ * then one switch setting per byte.
+ */
+int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size) {
+    static const uint32_t periods_ms[] = { 5, 10, 20, 25, 50, 100 };
+    static const task_func_t funcs[MAX_TASKS] = { job_C, job_A, job_B, job_D, job_E, job_F };
+    static const char* names[MAX_TASKS] = { "Task_C", "T1", "T2", "T3", "T4", "T5" };
+    static frame_schedule_t table[NUM_FRAMES];
+    static timetable_entry_t timetable[MAX_TIMETABLE_ENTRIES];
+    task_desc_t tasks[MAX_TASKS];
+    dag_edge_t edges[MAX_TASKS * (MAX_TASKS - 1) / 2];
+    task_set_t set = { .tasks = tasks, .edges = edges };
+    input_t in = { data, size };
+    invariants_t inv;
+
+    set.num_tasks = (uint8_t)(2 + next_byte(&in) % (MAX_TASKS - 1));
+    set.num_edges = 0;
+    for (uint8_t t = 0; t < set.num_tasks; t++) {
+        uint32_t period = periods_ms[next_byte(&in) % 6];
+        uint32_t frames = period / MINOR_FRAME_MS;
+        tasks[t].task = funcs[t];
+        tasks[t].name = names[t];
+        tasks[t].period_ms = period;
+        tasks[t].deadline_ms = MINOR_FRAME_MS * (1 + next_byte(&in) % frames);
+        tasks[t].wcet_us = 1 + ((uint32_t)next_byte(&in) << 8 | next_byte(&in)) % (MINOR_FRAME_MS * 1000);
+
+        uint8_t preds = next_byte(&in);
+        for (uint8_t p = 0; p < t; p++) {
+            if (preds & (1u << p)) {
+                edges[set.num_edges].pred = p;
+                edges[set.num_edges].succ = t;
+                set.num_edges++;
+            }
+        }
+    }
+
+    uint32_t switches = (in.size < MAX_SWITCHES) ? (uint32_t)in.size : MAX_SWITCHES;
+    for (uint32_t s = 0; s <= switches; s++) {
+        /* The decoded WCET first, then one run per switch setting */
+        uint8_t sw = 0;
+        if (s > 0) {
+            sw = next_byte(&in);
+            tasks[0].wcet_us = 1 + job_C_exec_us(sw);
+        }
+
+        uint64_t demand_us = 0;
+        for (uint8_t t = 0; t < set.num_tasks; t++) {
+            demand_us += (uint64_t)tasks[t].wcet_us * (HYPERPERIOD_MS / tasks[t].period_ms);
+        }
+
+        if (schedule_synthesize(&set, table)) {
+            if (demand_us > (uint64_t)HYPERPERIOD_MS * 1000) {
+                fail(&set, sw, "overloaded set synthesized");
+            }
+            if (schedule_check(&set, table, false) != 0) {
+                fail(&set, sw, "synthesized table fails the check");
+            }
+        }
+        if (schedule_synthesize_frames(&set, table) && schedule_check(&set, table, false) != 0) {
+            fail(&set, sw, "non-uniform table fails the check");
+        }
+
+        uint32_t count = schedule_timetable(&set, timetable, MAX_TIMETABLE_ENTRIES);
+        if (count > 0) {
+            timetable_invariants(&set, timetable, count, &inv);
+            if (!fuzz_invariants_hold(&inv)) {
+                fuzz_print_invariants(&inv);
+                fail(&set, sw, "time-triggered table breaks an invariant");
+            }
+        }
+    }
+    return 0;
+}
+/*-----------------------------------------------------------*/
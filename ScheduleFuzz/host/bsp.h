@@ -0,0 +1,22 @@
+/**
+ * @file bsp.h
+ * @brief Host stand-in for the lab-kit BSP: the switches are fed by the
+ *        fuzz input and waiting advances the simulated clock.
+ */
+#ifndef BSP_H
+#define BSP_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "pico/stdlib.h"
+
+typedef enum { SW_10, SW_11, SW_12, SW_13, SW_14, SW_15, SW_16, SW_17 } sw_t;
+typedef enum { LED_RED, LED_GREEN, LED_YELLOW } led_t;
+
+void BSP_Init(void);
+void BSP_WaitClkCycles(uint32_t cycles);
+bool BSP_GetInput(sw_t sw);
+void BSP_ToggleLED(led_t led);
+void BSP_SetLED(led_t led, bool on);
+
+#endif /* BSP_H */
@@ -0,0 +1,14 @@
+/**
+ * @file irq.h
+ * @brief Host stand-in for the interrupt priorities.
+ */
+#ifndef HARDWARE_IRQ_H
+#define HARDWARE_IRQ_H
+
+#include <stdint.h>
+
+#define PICO_HIGHEST_IRQ_PRIORITY 0x00
+
+static inline void irq_set_priority(unsigned int num, uint8_t priority) { (void)num; (void)priority; }
+
+#endif /* HARDWARE_IRQ_H */
@@ -0,0 +1,11 @@
+/**
+ * @file addressmap.h
+ * @brief Host stand-in: the XIP aliases map onto the host buffer itself.
+ */
+#ifndef HARDWARE_REGS_ADDRESSMAP_H
+#define HARDWARE_REGS_ADDRESSMAP_H
+
+#define XIP_BASE 0
+#define XIP_NOCACHE_NOALLOC_BASE 0
+
+#endif /* HARDWARE_REGS_ADDRESSMAP_H */
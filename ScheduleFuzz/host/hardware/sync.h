@@ -0,0 +1,27 @@
+/**
+ * @file sync.h
+ * @brief Host stand-in: one core, and the alarms only fire while a job
+ *        waits on the clock, never inside these sections. Barriers,
+ *        interrupt masking and spin locks have nothing to order.
+ */
+#ifndef HARDWARE_SYNC_H
+#define HARDWARE_SYNC_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+static inline void __dmb(void) {}
+static inline uint32_t save_and_disable_interrupts(void) { return 0; }
+static inline void restore_interrupts(uint32_t status) { (void)status; }
+
+typedef volatile uint32_t spin_lock_t;
+
+static inline int spin_lock_claim_unused(bool required) { (void)required; return 0; }
+static inline spin_lock_t *spin_lock_instance(uint32_t num) {
+    static spin_lock_t locks[32];
+    return &locks[num % 32];
+}
+static inline uint32_t spin_lock_blocking(spin_lock_t *lock) { (void)lock; return 0; }
+static inline void spin_unlock(spin_lock_t *lock, uint32_t saved) { (void)lock; (void)saved; }
+
+#endif /* HARDWARE_SYNC_H */
@@ -0,0 +1,29 @@
+/**
+ * @file timer.h
+ * @brief Host stand-in for the hardware alarms, fired by the simulated
+ *        clock (see host.c).
+ */
+#ifndef HARDWARE_TIMER_H
+#define HARDWARE_TIMER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "pico/stdlib.h"
+
+typedef void (*hardware_alarm_callback_t)(unsigned int alarm_num);
+
+/* Register block read by the peripheral memory stress kernel */
+typedef struct {
+    volatile uint32_t timerawl;
+    volatile uint32_t timerawh;
+} timer_hw_t;
+
+extern timer_hw_t *timer_hw;
+
+int hardware_alarm_claim_unused(bool required);
+void hardware_alarm_set_callback(unsigned int alarm_num, hardware_alarm_callback_t callback);
+bool hardware_alarm_set_target(unsigned int alarm_num, absolute_time_t target);
+void hardware_alarm_cancel(unsigned int alarm_num);
+unsigned int hardware_alarm_get_irq_num(unsigned int alarm_num);
+
+#endif /* HARDWARE_TIMER_H */
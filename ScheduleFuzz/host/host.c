@@ -0,0 +1,240 @@
+/**
+ * @file host.c
+ * @brief Simulated RP2350 for the host fuzz targets: clock, hardware
+ *        alarms, repeating timer and BSP, plus host versions of the modules
+ *        that need the hardware (interrupt accounting, fork-join).
+ *
+ * The interrupt accounting reads the vector table and the fork-join runs on
+ * core 1; on the host no interrupt is accounted and the segments of a
+ * fork-join job run one after the other.
+ */
+#include <stdio.h>
+#include <string.h>
+#include "bsp.h"
+#include "hardware/timer.h"
+#include "isr_load.h"
+#include "forkjoin.h"
+#include "host.h"
+
+#define HOST_NUM_ALARMS 4  /* Hardware alarms of the timer */
+
+typedef struct {
+    hardware_alarm_callback_t callback;
+    uint64_t target_us;
+    bool armed;
+} host_alarm_t;
+
+static uint64_t now_us = 0;
+static timer_hw_t host_timer_hw;
+timer_hw_t *timer_hw = &host_timer_hw;
+static host_alarm_t alarms[HOST_NUM_ALARMS];
+static uint32_t alarms_claimed = 0;
+static repeating_timer_t *timer = NULL;
+static host_idle_hook_t idle_hook = NULL;
+
+/**
+ * @brief Advance the clock, running the alarms that fall due on the way in
+ *        target order. A callback may wait itself; the clock never goes back.
+ */
+void host_wait_until(uint64_t t_us) {
+    for (;;) {
+        int due = -1;
+        for (int a = 0; a < HOST_NUM_ALARMS; a++) {
+            if (alarms[a].armed && alarms[a].target_us <= t_us &&
+                (due < 0 || alarms[a].target_us < alarms[due].target_us)) {
+                due = a;
+            }
+        }
+        if (due < 0) {
+            break;
+        }
+        alarms[due].armed = false;
+        if (alarms[due].target_us > now_us) {
+            now_us = alarms[due].target_us;
+        }
+        if (alarms[due].callback != NULL) {
+            alarms[due].callback((unsigned int)due);
+        }
+    }
+    if (t_us > now_us) {
+        now_us = t_us;
+    }
+}
+/*-----------------------------------------------------------*/
+
+repeating_timer_t *host_repeating_timer(void) {
+    return timer;
+}
+/*-----------------------------------------------------------*/
+
+void host_reset_timer(void) {
+    timer = NULL;
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Called from tight_loop_contents(): where the firmware idles, the
+ *        target takes over (e.g. once the start-up is done)
+ */
+void host_set_idle_hook(host_idle_hook_t hook) {
+    idle_hook = hook;
+}
+/*-----------------------------------------------------------*/
+
+uint64_t time_us_64(void) {
+    return now_us;
+}
+/*-----------------------------------------------------------*/
+
+uint32_t time_us_32(void) {
+    return (uint32_t)now_us;
+}
+/*-----------------------------------------------------------*/
+
+absolute_time_t from_us_since_boot(uint64_t us) {
+    return us;
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Register the repeating timer; the target fires it itself
+ */
+bool add_repeating_timer_us(int64_t delay_us, repeating_timer_callback_t callback, void *user_data,
+                            repeating_timer_t *out) {
+    out->delay_us = delay_us;
+    out->callback = callback;
+    out->user_data = user_data;
+    timer = out;
+    return true;
+}
+/*-----------------------------------------------------------*/
+
+void tight_loop_contents(void) {
+    if (idle_hook != NULL) {
+        idle_hook();
+    }
+}
+/*-----------------------------------------------------------*/
+
+int hardware_alarm_claim_unused(bool required) {
+    (void)required;
+    return (int)(alarms_claimed++ % HOST_NUM_ALARMS);
+}
+/*-----------------------------------------------------------*/
+
+void hardware_alarm_set_callback(unsigned int alarm_num, hardware_alarm_callback_t callback) {
+    alarms[alarm_num].callback = callback;
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @return true if the target already passed (the alarm is not set), as on
+ *         the hardware
+ */
+bool hardware_alarm_set_target(unsigned int alarm_num, absolute_time_t target) {
+    if (target <= now_us) {
+        return true;
+    }
+    alarms[alarm_num].target_us = target;
+    alarms[alarm_num].armed = true;
+    return false;
+}
+/*-----------------------------------------------------------*/
+
+void hardware_alarm_cancel(unsigned int alarm_num) {
+    alarms[alarm_num].armed = false;
+}
+/*-----------------------------------------------------------*/
+
+unsigned int hardware_alarm_get_irq_num(unsigned int alarm_num) {
+    return alarm_num;
+}
+/*-----------------------------------------------------------*/
+
+void BSP_Init(void) {
+}
+/*-----------------------------------------------------------*/
+
+void BSP_WaitClkCycles(uint32_t cycles) {
+    host_wait_until(now_us + cycles / CYCLES_PER_US);
+}
+/*-----------------------------------------------------------*/
+
+bool BSP_GetInput(sw_t sw) {
+    (void)sw;
+    return false;
+}
+/*-----------------------------------------------------------*/
+
+void BSP_ToggleLED(led_t led) {
+    (void)led;
+}
+/*-----------------------------------------------------------*/
+
+void BSP_SetLED(led_t led, bool on) {
+    (void)led;
+    (void)on;
+}
+/*-----------------------------------------------------------*/
+
+uint8_t isr_load_init(void) {
+    return 0;
+}
+/*-----------------------------------------------------------*/
+
+void isr_load_pause(void) {
+}
+/*-----------------------------------------------------------*/
+
+void isr_load_resume(void) {
+}
+/*-----------------------------------------------------------*/
+
+void isr_load_sample(isr_load_t *load) {
+    memset(load, 0, sizeof(*load));
+}
+/*-----------------------------------------------------------*/
+
+void isr_load_print(const isr_load_t *load) {
+    (void)load;
+}
+/*-----------------------------------------------------------*/
+
+uint8_t isr_load_model(const isr_load_t *load, rta_irq_t *irqs, uint8_t max_irqs) {
+    (void)load;
+    (void)irqs;
+    (void)max_irqs;
+    return 0;
+}
+/*-----------------------------------------------------------*/
+
+void fj_core1_init(void) {
+}
+/*-----------------------------------------------------------*/
+
+void fj_run_segment(fj_job_t *job, uint8_t segment) {
+    job->func(&job->segments[segment], segment, job->num_segments);
+}
+/*-----------------------------------------------------------*/
+
+void fj_run(fj_job_t *job, jobReturn_t *retval) {
+    job->fork_time = time_us_64();
+    retval->start = job->fork_time;
+    for (uint8_t s = 0; s < job->num_segments; s++) {
+        fj_run_segment(job, s);
+    }
+    job->join_time = time_us_64();
+    retval->stop = job->join_time;
+}
+/*-----------------------------------------------------------*/
+
+void fj_stats(const fj_job_t *job, fj_stats_t *stats) {
+    stats->span_us = job->join_time - job->fork_time;
+    stats->work_us = 0;
+    for (uint8_t s = 0; s < job->num_segments; s++) {
+        stats->work_us += job->segments[s].stop - job->segments[s].start;
+    }
+    stats->fork_us = 0;
+    stats->join_us = 0;
+}
+/*-----------------------------------------------------------*/
@@ -0,0 +1,19 @@
+#ifndef HOST_H
+#define HOST_H
+
+#include <stdint.h>
+#include "pico/stdlib.h"
+
+/* Simulated platform for the host fuzz targets. Time only advances when the
+ * code waits (BSP_WaitClkCycles) or the target moves it; hardware alarms
+ * due on the way run their callbacks at their target time, as the alarm
+ * interrupt would. */
+
+typedef void (*host_idle_hook_t)(void);
+
+void host_wait_until(uint64_t t_us);
+repeating_timer_t *host_repeating_timer(void);
+void host_set_idle_hook(host_idle_hook_t hook);
+void host_reset_timer(void);
+
+#endif /* HOST_H */
@@ -0,0 +1,34 @@
+/**
+ * @file stdlib.h
+ * @brief Host stand-in for the Pico SDK: a simulated microsecond clock and
+ *        a repeating timer the fuzz target fires itself.
+ */
+#ifndef PICO_STDLIB_H
+#define PICO_STDLIB_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "hardware/sync.h"
+
+#define __scratch_x(group)
+#define __not_in_flash_func(func) func
+
+typedef uint64_t absolute_time_t;
+
+typedef struct repeating_timer repeating_timer_t;
+typedef bool (*repeating_timer_callback_t)(repeating_timer_t *rt);
+struct repeating_timer {
+    int64_t delay_us;
+    repeating_timer_callback_t callback;
+    void *user_data;
+};
+
+uint64_t time_us_64(void);
+uint32_t time_us_32(void);
+absolute_time_t from_us_since_boot(uint64_t us);
+bool add_repeating_timer_us(int64_t delay_us, repeating_timer_callback_t callback, void *user_data,
+                            repeating_timer_t *out);
+void tight_loop_contents(void);
+
+#endif /* PICO_STDLIB_H */
@@ -0,0 +1,28 @@
+#ifndef ANALYZER_H
+#define ANALYZER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "trace.h"
+
+/* Allowed deviation of a capture from a golden capture */
+typedef struct {
+    uint32_t time_us;    /* Release offsets, start latency and response time */
+    uint32_t exec_pct;   /* Execution time, relative to the golden value */
+    uint32_t exec_us;    /* Execution time floor, for short jobs */
+} compare_tolerance_t;
+
+#define PWCET_MAX_PROBS 8
+
+/* Probabilistic WCET estimation */
+typedef struct {
+    uint32_t block;                 /* Jobs per block for the block maxima */
+    double probs[PWCET_MAX_PROBS];  /* Per-job exceedance probabilities */
+    uint32_t num_probs;
+    const char* export_path;        /* Budget header, NULL if not exported */
+} pwcet_options_t;
+
+bool compare_captures(const char* golden_path, const char* path, const compare_tolerance_t* tol);
+bool pwcet_estimate(char* const* paths, int num_paths, const pwcet_options_t* opts);
+
+#endif /* ANALYZER_H */
@@ -0,0 +1,223 @@
+/**
+ * @file compare.c
+ * @brief Regression check of a capture against a golden capture: the job
+ *        timelines must match job by job within tolerances, and the miss
+ *        counts must be equal.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "analyzer.h"
+
+/* One job of a timeline, with its own copy of the task name */
+typedef struct {
+    char task[TRACE_NAME_LEN + 1];
+    uint32_t hyperperiod;
+    uint64_t release_us;
+    uint64_t start_us;
+    uint64_t finish_us;
+    uint64_t exec_us;
+    trace_status_t status;
+} job_t;
+
+typedef struct {
+    job_t* jobs;
+    size_t count;
+    size_t cap;
+    bool in_report;    /* A hyperperiod header has been seen */
+} timeline_t;
+
+static void timeline_hyperperiod(void* ctx, uint32_t hyperperiod) {
+    (void)hyperperiod;
+    ((timeline_t*)ctx)->in_report = true;
+}
+
+static void timeline_job(void* ctx, const job_row_t* row) {
+    timeline_t* tl = ctx;
+
+    if (!tl->in_report) {
+        return;  /* Partial report before the first header */
+    }
+    if (tl->count == tl->cap) {
+        tl->cap = tl->cap ? tl->cap * 2 : 1024;
+        tl->jobs = realloc(tl->jobs, tl->cap * sizeof(job_t));
+        if (tl->jobs == NULL) {
+            perror("realloc");
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    job_t* job = &tl->jobs[tl->count++];
+    size_t len = row->task_len < TRACE_NAME_LEN ? row->task_len : TRACE_NAME_LEN;
+    memcpy(job->task, row->task, len);
+    job->task[len] = '\0';
+    job->hyperperiod = row->hyperperiod;
+    job->release_us = row->release_us;
+    job->start_us = row->start_us;
+    job->finish_us = row->finish_us;
+    job->exec_us = row->exec_us;
+    job->status = row->status;
+}
+
+static bool load_timeline(const char* path, timeline_t* tl) {
+    trace_capture_t cap;
+    const trace_sink_t sink = { timeline_hyperperiod, timeline_job, tl };
+
+    memset(tl, 0, sizeof(*tl));
+    if (!trace_open(path, &cap)) {
+        return false;
+    }
+    trace_scan(cap.body, cap.body_size, cap.binary, &sink);
+    trace_close(&cap);
+    return true;
+}
+/*-----------------------------------------------------------*/
+
+static uint64_t abs_diff(uint64_t a, uint64_t b) {
+    return a > b ? a - b : b - a;
+}
+
+/**
+ * @brief Describe how a job deviates from its golden counterpart.
+ *
+ * Times are compared relative to the first compared release of each
+ * capture, since the absolute timestamps depend on the boot time.
+ *
+ * @return NULL if the job is within the tolerances
+ */
+static const char* job_divergence(const job_t* golden, uint64_t golden_base,
+                                  const job_t* job, uint64_t base, const compare_tolerance_t* tol) {
+    if (strcmp(golden->task, job->task) != 0) {
+        return "task";
+    }
+    if (golden->status != job->status) {
+        return "status";
+    }
+    if (abs_diff(golden->release_us - golden_base, job->release_us - base) > tol->time_us) {
+        return "release offset";
+    }
+    if (golden->status == TRACE_STATUS_SKIPPED) {
+        return NULL;  /* Never ran: no start, finish or execution time */
+    }
+    if (abs_diff(golden->start_us - golden->release_us, job->start_us - job->release_us) > tol->time_us) {
+        return "start latency";
+    }
+
+    uint64_t exec_tol = (golden->exec_us * tol->exec_pct) / 100;
+    if (exec_tol < tol->exec_us) {
+        exec_tol = tol->exec_us;
+    }
+    if (abs_diff(golden->exec_us, job->exec_us) > exec_tol) {
+        return "execution time";
+    }
+    if (abs_diff(golden->finish_us - golden->release_us, job->finish_us - job->release_us) > tol->time_us) {
+        return "response time";
+    }
+    return NULL;
+}
+
+static void print_job(const char* label, const job_t* job, uint64_t base) {
+    static const char* status_names[] = { "OK", "MISS", "SKIPPED" };
+
+    printf("  %-7s HP %-6u %-8s release +%llu us, start +%llu us, finish +%llu us, exec %llu us, %s\n",
+           label, job->hyperperiod, job->task, (unsigned long long)(job->release_us - base),
+           (unsigned long long)(job->start_us - job->release_us),
+           (unsigned long long)(job->finish_us - job->release_us),
+           (unsigned long long)job->exec_us, status_names[job->status]);
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Compare a capture against a golden capture and print the result.
+ *
+ * Both timelines are aligned on the first hyperperiod they have in common.
+ * The first divergent job is printed with its golden counterpart. Either
+ * trace may stop within its last hyperperiod (a capture cut off mid-report),
+ * but a hyperperiod missing from one of them is a divergence.
+ *
+ * @return true if the capture matches the golden one
+ */
+bool compare_captures(const char* golden_path, const char* path, const compare_tolerance_t* tol) {
+    timeline_t golden;
+    timeline_t capture;
+
+    if (!load_timeline(golden_path, &golden)) {
+        return false;
+    }
+    if (!load_timeline(path, &capture)) {
+        free(golden.jobs);
+        return false;
+    }
+
+    printf("\n========== %s vs golden %s ==========\n", path, golden_path);
+
+    size_t g = 0;
+    size_t c = 0;
+    if (golden.count > 0 && capture.count > 0) {
+        uint32_t first = golden.jobs[0].hyperperiod > capture.jobs[0].hyperperiod ?
+                         golden.jobs[0].hyperperiod : capture.jobs[0].hyperperiod;
+        while (g < golden.count && golden.jobs[g].hyperperiod < first) {
+            g++;
+        }
+        while (c < capture.count && capture.jobs[c].hyperperiod < first) {
+            c++;
+        }
+    }
+
+    size_t compared = 0;
+    size_t divergent = 0;
+    uint64_t golden_misses = 0;
+    uint64_t misses = 0;
+    uint64_t golden_base = (g < golden.count) ? golden.jobs[g].release_us : 0;
+    uint64_t base = (c < capture.count) ? capture.jobs[c].release_us : 0;
+
+    for (; g < golden.count && c < capture.count; g++, c++, compared++) {
+        const job_t* gj = &golden.jobs[g];
+        const job_t* cj = &capture.jobs[c];
+
+        golden_misses += (gj->status != TRACE_STATUS_OK);
+        misses += (cj->status != TRACE_STATUS_OK);
+
+        const char* what = job_divergence(gj, golden_base, cj, base, tol);
+        if (what != NULL) {
+            if (divergent == 0) {
+                printf("First divergent job: #%zu, %s\n", compared, what);
+                print_job("golden", gj, golden_base);
+                print_job("capture", cj, base);
+            }
+            divergent++;
+        }
+    }
+
+    size_t golden_left = golden.count - g;
+    size_t capture_left = capture.count - c;
+
+    printf("Jobs compared: %zu, divergent: %zu (tolerance %u us, exec %u%% / %u us)\n",
+           compared, divergent, tol->time_us, tol->exec_pct, tol->exec_us);
+    printf("Deadline misses: %llu, golden %llu\n",
+           (unsigned long long)misses, (unsigned long long)golden_misses);
+    if (golden_left > 0 || capture_left > 0) {
+        printf("Unmatched jobs: %zu in capture, %zu in golden\n", capture_left, golden_left);
+    }
+
+    /* A capture cut off within its last hyperperiod still matches; any
+     * hyperperiod one of the traces lacks entirely does not */
+    bool truncated = false;
+    if (compared > 0) {
+        uint32_t last = golden.jobs[g - 1].hyperperiod;
+        truncated = (g < golden.count && golden.jobs[golden.count - 1].hyperperiod != last) ||
+                    (c < capture.count && capture.jobs[capture.count - 1].hyperperiod != last);
+        if (truncated) {
+            printf("Hyperperiods differ: capture ends at %u, golden at %u\n",
+                   capture.jobs[capture.count - 1].hyperperiod, golden.jobs[golden.count - 1].hyperperiod);
+        }
+    }
+
+    bool match = (compared > 0 && divergent == 0 && misses == golden_misses && !truncated);
+    printf("Result: %s\n", match ? "MATCH" : "DIVERGED");
+
+    free(golden.jobs);
+    free(capture.jobs);
+    return match;
+}
+/*-----------------------------------------------------------*/
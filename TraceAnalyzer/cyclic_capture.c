@@ -0,0 +1,117 @@
+/**
+ * @file cyclic_capture.c
+ * @brief Records a capture of CyclicSched running on the simulated platform
+ *        of ScheduleFuzz/host, for the golden regression suite.
+ *
+ * CyclicSched/main.c is compiled in as it is. Its start-up runs until the
+ * main loop idles, then the scenario drives the frame timer: per frame the
+ * switch setting Task_C reads and how late the timer fires. The jobs wait on
+ * the simulated clock, so the capture (stdout) holds the scheduler's own
+ * reports with deterministic times.
+ *
+ * Usage: cyclic_capture scenario [frames]
+ *   switch_settings  switches 0, 32, ..., 255, one setting per hyperperiod
+ *   overload         switches at 255, every 7th frame timer 3 ms late
+ *   mode_change      switches alternating between light and heavy modes
+ *                    every two hyperperiods
+ * frames cuts the run short (default: the scenario's length).
+ */
+#include <setjmp.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "host.h"
+
+#define main cyclic_main
+#include "../CyclicSched/main.c"  /* Not the analyzer's main.c beside this file */
+#undef main
+
+typedef struct {
+    const char* name;
+    uint32_t hyperperiods;
+    uint8_t (*switches)(uint32_t hyperperiod);
+    uint32_t (*late_us)(uint32_t frame);
+} scenario_t;
+
+static uint8_t sweep_switches(uint32_t hyperperiod) {
+    return (hyperperiod * 32 > 255) ? 255 : (uint8_t)(hyperperiod * 32);
+}
+
+static uint8_t overload_switches(uint32_t hyperperiod) {
+    (void)hyperperiod;
+    return 255;
+}
+
+static uint8_t mode_switches(uint32_t hyperperiod) {
+    static const uint8_t modes[] = { 16, 240, 64, 255, 0 };
+    return modes[(hyperperiod / 2) % 5];
+}
+
+static uint32_t on_time(uint32_t frame) {
+    (void)frame;
+    return 0;
+}
+
+static uint32_t late_every_7th(uint32_t frame) {
+    return (frame % 7 == 6) ? 3000 : 0;
+}
+
+static const scenario_t scenarios[] = {
+    { "switch_settings", 9,  sweep_switches,    on_time },
+    { "overload",        6,  overload_switches, late_every_7th },
+    { "mode_change",     10, mode_switches,     on_time },
+};
+/*-----------------------------------------------------------*/
+
+static jmp_buf started;
+static uint8_t switch_value = 0;
+
+static void start_up_done(void) {
+    longjmp(started, 1);
+}
+
+static uint8_t scenario_switch_source(void) {
+    return switch_value;
+}
+/*-----------------------------------------------------------*/
+
+int main(int argc, char* argv[]) {
+    const scenario_t* scenario = NULL;
+
+    for (size_t i = 0; argc > 1 && i < sizeof(scenarios) / sizeof(scenarios[0]); i++) {
+        if (strcmp(argv[1], scenarios[i].name) == 0) {
+            scenario = &scenarios[i];
+        }
+    }
+    if (scenario == NULL) {
+        fprintf(stderr, "Usage: %s switch_settings|overload|mode_change [frames]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+    uint32_t frames = scenario->hyperperiods * NUM_FRAMES;
+    if (argc > 2) {
+        frames = (uint32_t)strtoul(argv[2], NULL, 0);
+    }
+
+    host_set_idle_hook(start_up_done);
+    if (setjmp(started) == 0) {
+        cyclic_main();
+    }
+    host_set_idle_hook(NULL);
+
+    repeating_timer_t* timer = host_repeating_timer();
+    if (timer == NULL) {
+        fprintf(stderr, "%s: start-up failed\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+    workload_set_switch_source(scenario_switch_source);
+
+    uint64_t fire_us = time_us_64() + (uint64_t)(-timer->delay_us);
+    for (uint32_t f = 0; f < frames; f++) {
+        switch_value = scenario->switches(f / NUM_FRAMES);
+        host_wait_until(fire_us + scenario->late_us(f));
+        timer->callback(timer);
+        fire_us += (uint64_t)(-timer->delay_us);
+    }
+    return EXIT_SUCCESS;
+}
+/*-----------------------------------------------------------*/
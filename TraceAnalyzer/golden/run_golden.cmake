@@ -0,0 +1,33 @@
+# Records a capture of a scenario with cyclic_capture and compares it with a
+# golden capture. EXPECT=MATCH requires exit status 0 and "Result: MATCH",
+# EXPECT=DIVERGED exit status 1 and "Result: DIVERGED".
+#
+# cmake -DANALYZER=... -DHOST=... -DCAPTURE=<dir> -DGOLDEN=... -DSCENARIO=...
+#       -DEXPECT=MATCH|DIVERGED [-DFRAMES=n] -P run_golden.cmake
+#
+# Recording a golden capture: cyclic_capture <scenario> > golden/<scenario>.txt
+
+set(capture ${CAPTURE}/${SCENARIO}${FRAMES}.txt)
+execute_process(COMMAND ${HOST} ${SCENARIO} ${FRAMES}
+                RESULT_VARIABLE status
+                OUTPUT_FILE ${capture})
+if(NOT status EQUAL 0)
+    message(FATAL_ERROR "${HOST} ${SCENARIO} ${FRAMES} failed with status ${status}")
+endif()
+
+execute_process(COMMAND ${ANALYZER} -g ${GOLDEN} ${capture}
+                RESULT_VARIABLE status
+                OUTPUT_VARIABLE output)
+message("${output}")
+
+if(EXPECT STREQUAL "MATCH")
+    set(expected_status 0)
+else()
+    set(expected_status 1)
+endif()
+if(NOT status EQUAL expected_status)
+    message(FATAL_ERROR "Expected exit status ${expected_status}, got ${status}")
+endif()
+if(NOT output MATCHES "Result: ${EXPECT}")
+    message(FATAL_ERROR "Expected the comparison to report ${EXPECT}")
+endif()
@@ -0,0 +1,452 @@
+/**
+ * @file main.c
+ * @brief Host analyzer for serial trace captures of the schedulers.
+ *
+ * The capture is memory-mapped and split into chunks at hyperperiod
+ * boundaries (text) or record boundaries (binary). Chunks are parsed in
+ * parallel and the per-chunk results are merged in capture order, so the
+ * output does not depend on the number of threads.
+ *
+ * With -g, each capture is instead compared against a golden capture (see
+ * compare.c) and the exit status tells whether all of them match.
+ *
+ * With -W, the execution times of all captures are pooled per task and the
+ * pWCET at each -q exceedance probability is estimated (see pwcet.c); -o
+ * exports the estimates as firmware budgets.
+ *
+ * Usage: trace_analyzer [-j threads] [-w bin_us] [-b bins] [-m misses] capture...
+ *        trace_analyzer -g golden [-t time_us] [-p exec_pct] [-e exec_us] capture...
+ *        trace_analyzer -W [-B block] [-q prob]... [-o budgets.h] capture...
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+#include "analyzer.h"
+
+#define MAX_TASKS   16
+#define MAX_THREADS 64
+#define MAX_BINS    256
+
+/* Analyzer options */
+typedef struct {
+    uint32_t threads;
+    uint32_t bin_us;       /* Histogram bin width */
+    uint32_t bins;         /* Last bin collects everything above */
+    uint32_t max_misses;   /* Misses listed in the report */
+} options_t;
+
+typedef struct {
+    char name[TRACE_NAME_LEN + 1];
+    uint64_t jobs;
+    uint64_t misses;            /* Including skipped jobs */
+    uint64_t skipped;
+    uint64_t exec_sum_us;       /* Over executed jobs */
+    uint64_t exec_min_us;
+    uint64_t exec_max_us;
+    uint64_t response_max_us;
+    uint64_t hist[MAX_BINS];
+} task_stats_t;
+
+typedef struct {
+    uint32_t hyperperiod;
+    uint8_t task;               /* Index into the analysis' tasks */
+    trace_status_t status;
+    uint64_t release_us;
+    uint64_t finish_us;
+    uint64_t deadline_us;
+} miss_t;
+
+/* Result of one chunk, later merged */
+typedef struct {
+    task_stats_t tasks[MAX_TASKS];
+    uint32_t num_tasks;
+    miss_t* misses;
+    size_t num_misses;
+    size_t cap_misses;
+    uint64_t rows;
+    uint64_t hyperperiods;
+    uint32_t first_hyperperiod; /* Numbers of the first and last hyperperiod seen */
+    uint32_t last_hyperperiod;
+    uint64_t dropped;           /* Rows of tasks beyond MAX_TASKS */
+} analysis_t;
+
+typedef struct {
+    const char* data;
+    size_t size;
+    bool binary;
+    const options_t* opts;
+    analysis_t result;
+} chunk_t;
+
+static options_t options = { .threads = 0, .bin_us = 100, .bins = 40, .max_misses = 50 };
+static compare_tolerance_t tolerance = { .time_us = 50, .exec_pct = 5, .exec_us = 20 };
+static pwcet_options_t pwcet_options = { .block = 50 };
+
+/*-----------------------------------------------------------*/
+
+static uint32_t task_index(analysis_t* a, const char* name, size_t len) {
+    if (len > TRACE_NAME_LEN) {
+        len = TRACE_NAME_LEN;
+    }
+    for (uint32_t i = 0; i < a->num_tasks; i++) {
+        if (strlen(a->tasks[i].name) == len && memcmp(a->tasks[i].name, name, len) == 0) {
+            return i;
+        }
+    }
+    if (a->num_tasks == MAX_TASKS) {
+        return MAX_TASKS;
+    }
+
+    task_stats_t* t = &a->tasks[a->num_tasks];
+    memset(t, 0, sizeof(*t));
+    memcpy(t->name, name, len);
+    t->name[len] = '\0';
+    t->exec_min_us = UINT64_MAX;
+    return a->num_tasks++;
+}
+
+static void add_miss(analysis_t* a, const miss_t* miss) {
+    if (a->num_misses == a->cap_misses) {
+        a->cap_misses = a->cap_misses ? a->cap_misses * 2 : 64;
+        a->misses = realloc(a->misses, a->cap_misses * sizeof(miss_t));
+        if (a->misses == NULL) {
+            perror("realloc");
+            exit(EXIT_FAILURE);
+        }
+    }
+    a->misses[a->num_misses++] = *miss;
+}
+
+static void enter_hyperperiod(analysis_t* a, uint32_t hyperperiod) {
+    if (a->hyperperiods == 0) {
+        a->first_hyperperiod = hyperperiod;
+    }
+    a->last_hyperperiod = hyperperiod;
+    a->hyperperiods++;
+}
+
+static void account_job(analysis_t* a, const job_row_t* row, const options_t* opts) {
+    uint32_t idx = task_index(a, row->task, row->task_len);
+    if (idx == MAX_TASKS) {
+        a->dropped++;
+        return;
+    }
+
+    task_stats_t* t = &a->tasks[idx];
+    t->jobs++;
+    a->rows++;
+
+    if (row->status != TRACE_STATUS_OK) {
+        miss_t miss = { row->hyperperiod, (uint8_t)idx, row->status,
+                        row->release_us, row->finish_us, row->deadline_us };
+        t->misses++;
+        add_miss(a, &miss);
+    }
+    if (row->status == TRACE_STATUS_SKIPPED) {
+        t->skipped++;
+        return;
+    }
+
+    t->exec_sum_us += row->exec_us;
+    if (row->exec_us < t->exec_min_us) {
+        t->exec_min_us = row->exec_us;
+    }
+    if (row->exec_us > t->exec_max_us) {
+        t->exec_max_us = row->exec_us;
+    }
+    if (row->finish_us > row->release_us && row->finish_us - row->release_us > t->response_max_us) {
+        t->response_max_us = row->finish_us - row->release_us;
+    }
+
+    uint64_t bin = row->exec_us / opts->bin_us;
+    t->hist[bin < opts->bins ? bin : opts->bins - 1]++;
+}
+/*-----------------------------------------------------------*/
+
+static void chunk_hyperperiod(void* ctx, uint32_t hyperperiod) {
+    enter_hyperperiod(&((chunk_t*)ctx)->result, hyperperiod);
+}
+
+static void chunk_job(void* ctx, const job_row_t* row) {
+    chunk_t* chunk = ctx;
+    account_job(&chunk->result, row, chunk->opts);
+}
+
+static void* chunk_worker(void* arg) {
+    chunk_t* chunk = arg;
+    const trace_sink_t sink = { chunk_hyperperiod, chunk_job, chunk };
+
+    trace_scan(chunk->data, chunk->size, chunk->binary, &sink);
+    return NULL;
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Fold a chunk result into the total, keeping capture order.
+ */
+static void merge(analysis_t* total, analysis_t* part, const options_t* opts) {
+    uint8_t remap[MAX_TASKS];
+
+    for (uint32_t i = 0; i < part->num_tasks; i++) {
+        const task_stats_t* src = &part->tasks[i];
+        uint32_t idx = task_index(total, src->name, strlen(src->name));
+        if (idx == MAX_TASKS) {
+            total->dropped += src->jobs;
+            remap[i] = MAX_TASKS;
+            continue;
+        }
+
+        task_stats_t* dst = &total->tasks[idx];
+        remap[i] = (uint8_t)idx;
+        dst->jobs += src->jobs;
+        dst->misses += src->misses;
+        dst->skipped += src->skipped;
+        dst->exec_sum_us += src->exec_sum_us;
+        if (src->exec_min_us < dst->exec_min_us) {
+            dst->exec_min_us = src->exec_min_us;
+        }
+        if (src->exec_max_us > dst->exec_max_us) {
+            dst->exec_max_us = src->exec_max_us;
+        }
+        if (src->response_max_us > dst->response_max_us) {
+            dst->response_max_us = src->response_max_us;
+        }
+        for (uint32_t b = 0; b < opts->bins; b++) {
+            dst->hist[b] += src->hist[b];
+        }
+    }
+
+    for (size_t m = 0; m < part->num_misses; m++) {
+        miss_t miss = part->misses[m];
+        if (remap[miss.task] != MAX_TASKS) {
+            miss.task = remap[miss.task];
+            add_miss(total, &miss);
+        }
+    }
+    total->rows += part->rows;
+    if (part->hyperperiods > 0) {
+        /* A binary split can cut a hyperperiod in two: count it once */
+        uint64_t shared = (total->hyperperiods > 0 &&
+                           part->first_hyperperiod == total->last_hyperperiod) ? 1 : 0;
+        if (total->hyperperiods == 0) {
+            total->first_hyperperiod = part->first_hyperperiod;
+        }
+        total->hyperperiods += part->hyperperiods - shared;
+        total->last_hyperperiod = part->last_hyperperiod;
+    }
+    total->dropped += part->dropped;
+    free(part->misses);
+}
+/*-----------------------------------------------------------*/
+
+static void print_report(const char* path, const analysis_t* a, const options_t* opts,
+                         size_t size, double seconds) {
+    static const char* status_names[] = { "OK", "MISS", "SKIPPED" };
+
+    printf("\n========== %s ==========\n", path);
+    printf("Hyperperiods: %llu, jobs: %llu, misses: %zu",
+           (unsigned long long)a->hyperperiods, (unsigned long long)a->rows, a->num_misses);
+    if (a->dropped > 0) {
+        printf(", dropped rows: %llu", (unsigned long long)a->dropped);
+    }
+    printf("\nParsed %.1f MB in %.2f s (%.1f MB/s, %u threads)\n\n",
+           size / 1e6, seconds, seconds > 0 ? size / 1e6 / seconds : 0.0, opts->threads);
+
+    printf("Task     | Jobs       | Misses   | Skipped  | Exec min | Exec avg | Exec max | Resp max\n");
+    printf("---------+------------+----------+----------+----------+----------+----------+---------\n");
+    for (uint32_t i = 0; i < a->num_tasks; i++) {
+        const task_stats_t* t = &a->tasks[i];
+        uint64_t executed = t->jobs - t->skipped;
+        printf("%-8s | %10llu | %8llu | %8llu | %8llu | %8llu | %8llu | %8llu\n", t->name,
+               (unsigned long long)t->jobs, (unsigned long long)t->misses,
+               (unsigned long long)t->skipped,
+               (unsigned long long)(executed ? t->exec_min_us : 0),
+               (unsigned long long)(executed ? t->exec_sum_us / executed : 0),
+               (unsigned long long)t->exec_max_us, (unsigned long long)t->response_max_us);
+    }
+
+    if (a->num_misses > 0) {
+        size_t shown = a->num_misses < opts->max_misses ? a->num_misses : opts->max_misses;
+        printf("\nDeadline misses (first %zu of %zu):\n", shown, a->num_misses);
+        printf("Hyperperiod | Task     | Release    | Finish     | Deadline   | Status\n");
+        for (size_t m = 0; m < shown; m++) {
+            const miss_t* miss = &a->misses[m];
+            printf("%11u | %-8s | %10llu | %10llu | %10llu | %s\n", miss->hyperperiod,
+                   a->tasks[miss->task].name, (unsigned long long)miss->release_us,
+                   (unsigned long long)miss->finish_us, (unsigned long long)miss->deadline_us,
+                   status_names[miss->status]);
+        }
+    }
+
+    printf("\nExecution time histograms (%u us bins):\n", opts->bin_us);
+    for (uint32_t i = 0; i < a->num_tasks; i++) {
+        const task_stats_t* t = &a->tasks[i];
+        uint64_t peak = 0;
+        for (uint32_t b = 0; b < opts->bins; b++) {
+            if (t->hist[b] > peak) {
+                peak = t->hist[b];
+            }
+        }
+
+        printf("%s:\n", t->name);
+        for (uint32_t b = 0; b < opts->bins; b++) {
+            if (t->hist[b] == 0) {
+                continue;
+            }
+            if (b == opts->bins - 1) {
+                printf("  >= %6u us   %10llu ", b * opts->bin_us, (unsigned long long)t->hist[b]);
+            } else {
+                printf("  %6u-%-6u us %10llu ", b * opts->bin_us, (b + 1) * opts->bin_us,
+                       (unsigned long long)t->hist[b]);
+            }
+            for (uint64_t bar = 0; bar < (t->hist[b] * 40 + peak - 1) / peak; bar++) {
+                putchar('#');
+            }
+            putchar('\n');
+        }
+    }
+}
+/*-----------------------------------------------------------*/
+
+static bool analyze_file(const char* path, const options_t* opts) {
+    trace_capture_t cap;
+    if (!trace_open(path, &cap)) {
+        return false;
+    }
+
+    struct timespec t0, t1;
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+
+    /* Split into about equal chunks, aligned to hyperperiods or records */
+    static chunk_t chunks[MAX_THREADS];
+    static pthread_t threads[MAX_THREADS];
+    uint32_t num_chunks = 0;
+    size_t pos = 0;
+
+    for (uint32_t c = 0; c < opts->threads && pos < cap.body_size; c++) {
+        size_t split = cap.body_size;
+        if (c < opts->threads - 1) {
+            split = trace_align_split(&cap, (size_t)(((unsigned __int128)cap.body_size * (c + 1)) / opts->threads));
+        }
+        if (split <= pos) {
+            continue;
+        }
+
+        chunk_t* chunk = &chunks[num_chunks];
+        memset(chunk, 0, sizeof(*chunk));
+        chunk->data = cap.body + pos;
+        chunk->size = split - pos;
+        chunk->binary = cap.binary;
+        chunk->opts = opts;
+        if (pthread_create(&threads[num_chunks], NULL, chunk_worker, chunk) != 0) {
+            chunk_worker(chunk);  /* Out of threads: parse inline */
+            threads[num_chunks] = 0;
+        }
+        num_chunks++;
+        pos = split;
+    }
+
+    static analysis_t total;
+    memset(&total, 0, sizeof(total));
+    for (uint32_t c = 0; c < num_chunks; c++) {
+        if (threads[c] != 0) {
+            pthread_join(threads[c], NULL);
+        }
+        merge(&total, &chunks[c].result, opts);
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    double seconds = (double)(t1.tv_sec - t0.tv_sec) + (t1.tv_nsec - t0.tv_nsec) / 1e9;
+
+    print_report(path, &total, opts, cap.size, seconds);
+    free(total.misses);
+    trace_close(&cap);
+    return true;
+}
+/*-----------------------------------------------------------*/
+
+static void usage(const char* prog) {
+    fprintf(stderr, "Usage: %s [-j threads] [-w bin_us] [-b bins] [-m misses] capture...\n", prog);
+    fprintf(stderr, "       %s -g golden [-t time_us] [-p exec_pct] [-e exec_us] capture...\n", prog);
+    fprintf(stderr, "       %s -W [-B block] [-q prob]... [-o budgets.h] capture...\n", prog);
+}
+
+/**
+ * @brief Main function.
+ *
+ * @return int
+ */
+int main(int argc, char* argv[]) {
+    const char* golden = NULL;
+    bool pwcet = false;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "j:w:b:m:g:t:p:e:WB:q:o:h")) != -1) {
+        switch (opt) {
+        case 'j': options.threads = (uint32_t)strtoul(optarg, NULL, 10); break;
+        case 'w': options.bin_us = (uint32_t)strtoul(optarg, NULL, 10); break;
+        case 'b': options.bins = (uint32_t)strtoul(optarg, NULL, 10); break;
+        case 'm': options.max_misses = (uint32_t)strtoul(optarg, NULL, 10); break;
+        case 'g': golden = optarg; break;
+        case 't': tolerance.time_us = (uint32_t)strtoul(optarg, NULL, 10); break;
+        case 'p': tolerance.exec_pct = (uint32_t)strtoul(optarg, NULL, 10); break;
+        case 'e': tolerance.exec_us = (uint32_t)strtoul(optarg, NULL, 10); break;
+        case 'W': pwcet = true; break;
+        case 'B': pwcet_options.block = (uint32_t)strtoul(optarg, NULL, 10); break;
+        case 'q':
+            if (pwcet_options.num_probs == PWCET_MAX_PROBS) {
+                usage(argv[0]);
+                return EXIT_FAILURE;
+            }
+            pwcet_options.probs[pwcet_options.num_probs++] = strtod(optarg, NULL);
+            break;
+        case 'o': pwcet_options.export_path = optarg; break;
+        default:
+            usage(argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+    if (optind >= argc || options.bin_us == 0 || options.bins == 0 || options.bins > MAX_BINS) {
+        usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+    if (pwcet) {
+        if (pwcet_options.num_probs == 0) {
+            static const double default_probs[] = { 1e-3, 1e-6, 1e-9, 1e-12 };
+            pwcet_options.num_probs = sizeof(default_probs) / sizeof(default_probs[0]);
+            memcpy(pwcet_options.probs, default_probs, sizeof(default_probs));
+        }
+        for (uint32_t q = 0; q < pwcet_options.num_probs; q++) {
+            if (!(pwcet_options.probs[q] > 0.0 && pwcet_options.probs[q] < 1.0)) {
+                usage(argv[0]);
+                return EXIT_FAILURE;
+            }
+        }
+        if (pwcet_options.block == 0) {
+            usage(argv[0]);
+            return EXIT_FAILURE;
+        }
+        return pwcet_estimate(&argv[optind], argc - optind, &pwcet_options) ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+    if (options.threads == 0) {
+        long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+        options.threads = (cpus > 0) ? (uint32_t)cpus : 1;
+    }
+    if (options.threads > MAX_THREADS) {
+        options.threads = MAX_THREADS;
+    }
+
+    int status = EXIT_SUCCESS;
+    for (int i = optind; i < argc; i++) {
+        bool ok = (golden != NULL) ? compare_captures(golden, argv[i], &tolerance)
+                                   : analyze_file(argv[i], &options);
+        if (!ok) {
+            status = EXIT_FAILURE;
+        }
+    }
+    return status;
+}
+/*-----------------------------------------------------------*/
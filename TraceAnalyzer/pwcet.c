@@ -0,0 +1,419 @@
+/**
+ * @file pwcet.c
+ * @brief Probabilistic WCET estimation from the measured execution times.
+ *
+ * Measurement-based extreme-value analysis: the execution times of each
+ * task are grouped into blocks of consecutive jobs, a Gumbel distribution
+ * is fitted to the block maxima by probability-weighted moments, and the
+ * fitted tail is extrapolated to the requested per-job exceedance
+ * probabilities. The fit is checked with a Kolmogorov-Smirnov test and the
+ * independence of the maxima with their lag-1 autocorrelation.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <math.h>
+#include "analyzer.h"
+
+#define PWCET_MAX_TASKS 16
+#define PWCET_MIN_BLOCKS 10       /* Fewer block maxima: no fit */
+#define EULER_GAMMA 0.5772156649
+#define KS_CRITICAL_5PCT 1.36     /* Asymptotic, divided by sqrt(blocks) */
+
+typedef struct {
+    char name[TRACE_NAME_LEN + 1];
+    uint64_t jobs;             /* Executed jobs */
+    uint64_t exec_max_us;
+    uint64_t block_max_us;     /* Maximum of the current block */
+    uint32_t block_jobs;       /* Jobs in the current block */
+    double* maxima;
+    size_t num_maxima;
+    size_t cap_maxima;
+} pwcet_task_t;
+
+typedef struct {
+    pwcet_task_t tasks[PWCET_MAX_TASKS];
+    uint32_t num_tasks;
+    uint32_t block;
+    bool in_report;            /* A hyperperiod header has been seen in this capture */
+} pwcet_samples_t;
+
+/* Gumbel fit of the block maxima of one task */
+typedef struct {
+    bool fitted;
+    bool degenerate;           /* No variability: the maximum is the estimate */
+    double mu;                 /* Location */
+    double beta;               /* Scale */
+    double ks;                 /* Kolmogorov-Smirnov statistic */
+    double ks_critical;
+    double lag1;               /* Autocorrelation of consecutive maxima */
+    double lag1_limit;
+} gumbel_fit_t;
+
+/*-----------------------------------------------------------*/
+
+static pwcet_task_t* find_task(pwcet_samples_t* s, const char* name, size_t len) {
+    if (len > TRACE_NAME_LEN) {
+        len = TRACE_NAME_LEN;
+    }
+    for (uint32_t i = 0; i < s->num_tasks; i++) {
+        if (strlen(s->tasks[i].name) == len && memcmp(s->tasks[i].name, name, len) == 0) {
+            return &s->tasks[i];
+        }
+    }
+    if (s->num_tasks == PWCET_MAX_TASKS) {
+        return NULL;
+    }
+
+    pwcet_task_t* t = &s->tasks[s->num_tasks++];
+    memset(t, 0, sizeof(*t));
+    memcpy(t->name, name, len);
+    t->name[len] = '\0';
+    return t;
+}
+
+static void samples_hyperperiod(void* ctx, uint32_t hyperperiod) {
+    (void)hyperperiod;
+    ((pwcet_samples_t*)ctx)->in_report = true;
+}
+
+static void samples_job(void* ctx, const job_row_t* row) {
+    pwcet_samples_t* s = ctx;
+
+    /* Skipped jobs have no execution time; partial reports are ignored */
+    if (!s->in_report || row->status == TRACE_STATUS_SKIPPED) {
+        return;
+    }
+
+    pwcet_task_t* t = find_task(s, row->task, row->task_len);
+    if (t == NULL) {
+        return;
+    }
+
+    t->jobs++;
+    if (row->exec_us > t->exec_max_us) {
+        t->exec_max_us = row->exec_us;
+    }
+    if (t->block_jobs == 0 || row->exec_us > t->block_max_us) {
+        t->block_max_us = row->exec_us;
+    }
+    if (++t->block_jobs < s->block) {
+        return;
+    }
+
+    if (t->num_maxima == t->cap_maxima) {
+        t->cap_maxima = t->cap_maxima ? t->cap_maxima * 2 : 256;
+        t->maxima = realloc(t->maxima, t->cap_maxima * sizeof(double));
+        if (t->maxima == NULL) {
+            perror("realloc");
+            exit(EXIT_FAILURE);
+        }
+    }
+    t->maxima[t->num_maxima++] = (double)t->block_max_us;
+    t->block_jobs = 0;
+}
+
+/**
+ * @brief Add the jobs of a capture. Blocks do not span captures: the
+ *        partial last block of each capture is dropped.
+ */
+static bool load_samples(const char* path, pwcet_samples_t* s) {
+    trace_capture_t cap;
+    const trace_sink_t sink = { samples_hyperperiod, samples_job, s };
+
+    if (!trace_open(path, &cap)) {
+        return false;
+    }
+    s->in_report = false;
+    trace_scan(cap.body, cap.body_size, cap.binary, &sink);
+    trace_close(&cap);
+
+    for (uint32_t i = 0; i < s->num_tasks; i++) {
+        s->tasks[i].block_jobs = 0;
+    }
+    return true;
+}
+/*-----------------------------------------------------------*/
+
+static int compare_double(const void* a, const void* b) {
+    double x = *(const double*)a;
+    double y = *(const double*)b;
+    return (x > y) - (x < y);
+}
+
+static double gumbel_cdf(const gumbel_fit_t* fit, double x) {
+    return exp(-exp(-(x - fit->mu) / fit->beta));
+}
+
+/**
+ * @brief Fit a Gumbel distribution to block maxima.
+ *
+ * Lag-1 autocorrelation is computed on the maxima in capture order, then
+ * they are sorted for the probability-weighted moments and the KS test.
+ */
+static void gumbel_fit(double* maxima, size_t n, gumbel_fit_t* fit) {
+    memset(fit, 0, sizeof(*fit));
+    if (n < PWCET_MIN_BLOCKS) {
+        return;
+    }
+    fit->fitted = true;
+
+    double mean = 0.0;
+    for (size_t i = 0; i < n; i++) {
+        mean += maxima[i];
+    }
+    mean /= (double)n;
+
+    double var = 0.0;
+    double cov = 0.0;
+    for (size_t i = 0; i < n; i++) {
+        var += (maxima[i] - mean) * (maxima[i] - mean);
+        if (i > 0) {
+            cov += (maxima[i] - mean) * (maxima[i - 1] - mean);
+        }
+    }
+    fit->lag1 = (var > 0.0) ? cov / var : 0.0;
+    fit->lag1_limit = 2.0 / sqrt((double)n);
+
+    qsort(maxima, n, sizeof(double), compare_double);
+
+    double b1 = 0.0;
+    for (size_t i = 0; i < n; i++) {
+        b1 += ((double)i / (double)(n - 1)) * maxima[i];
+    }
+    b1 /= (double)n;
+
+    fit->beta = (2.0 * b1 - mean) / log(2.0);
+    if (fit->beta <= 1e-9) {
+        fit->degenerate = true;
+        fit->mu = maxima[n - 1];
+        fit->beta = 0.0;
+        return;
+    }
+    fit->mu = mean - EULER_GAMMA * fit->beta;
+
+    for (size_t i = 0; i < n; i++) {
+        double f = gumbel_cdf(fit, maxima[i]);
+        double below = f - (double)i / (double)n;
+        double above = (double)(i + 1) / (double)n - f;
+        if (below > fit->ks) {
+            fit->ks = below;
+        }
+        if (above > fit->ks) {
+            fit->ks = above;
+        }
+    }
+    fit->ks_critical = KS_CRITICAL_5PCT / sqrt((double)n);
+}
+
+/**
+ * @brief Execution time exceeded with probability p by a single job.
+ *
+ * A block maximum stays below x iff all its jobs do, so the per-job
+ * quantile solves F(x) = (1 - p)^block: x = mu - beta * ln(-block * ln(1 - p)).
+ * The result is never below the largest observed execution time.
+ */
+static double pwcet_quantile(const gumbel_fit_t* fit, const pwcet_task_t* t, uint32_t block, double p) {
+    double x = (double)t->exec_max_us;
+    if (!fit->degenerate) {
+        double q = fit->mu - fit->beta * log(-(double)block * log1p(-p));
+        if (q > x) {
+            x = q;
+        }
+    }
+    return x;
+}
+
+static bool fit_accepted(const gumbel_fit_t* fit) {
+    return fit->fitted && (fit->degenerate ||
+                           (fit->ks <= fit->ks_critical && fabs(fit->lag1) <= fit->lag1_limit));
+}
+/*-----------------------------------------------------------*/
+
+/* Budget macro name: PWCET_BUDGET_US_ followed by the upper-case task name */
+static void budget_macro(const char* task, char* macro, size_t size) {
+    size_t len = (size_t)snprintf(macro, size, "PWCET_BUDGET_US_");
+    for (const char* c = task; *c != '\0' && len + 1 < size; c++) {
+        macro[len++] = isalnum((unsigned char)*c) ? (char)toupper((unsigned char)*c) : '_';
+    }
+    macro[len] = '\0';
+}
+
+/* Tasks whose budget macro the firmware needs, with their nominal budgets
+ * (common/pwcet_budgets.h) */
+static const struct {
+    const char* name;
+    uint32_t nominal_us;
+} firmware_tasks[] = {
+    { "Task_A", 1000 }, { "Task_B", 1000 }, { "Task_C", 2000 },
+    { "Task_D", 2000 }, { "Task_E", 4000 }, { "Task_F", 2000 },
+};
+#define NUM_FIRMWARE_TASKS (sizeof(firmware_tasks) / sizeof(firmware_tasks[0]))
+
+static const pwcet_task_t* lookup_task(const pwcet_samples_t* s, const char* name) {
+    for (uint32_t i = 0; i < s->num_tasks; i++) {
+        if (strcmp(s->tasks[i].name, name) == 0) {
+            return &s->tasks[i];
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief Write the budget of one task: its estimate, or a fallback with a
+ *        comment naming the source.
+ *
+ * @return false if a fallback was used
+ */
+static bool export_budget(FILE* f, const pwcet_samples_t* s, const gumbel_fit_t* fits,
+                          const pwcet_options_t* opts, double p, const char* name, uint32_t nominal_us) {
+    const pwcet_task_t* t = lookup_task(s, name);
+    char macro[64];
+
+    budget_macro(name, macro, sizeof(macro));
+    if (t != NULL && fits[t - s->tasks].fitted) {
+        const gumbel_fit_t* fit = &fits[t - s->tasks];
+        if (!fit_accepted(fit)) {
+            fprintf(f, "/* %s: fit rejected by the diagnostics, estimate not reliable */\n", name);
+        }
+        fprintf(f, "#define %s %llu\n", macro, (unsigned long long)ceil(pwcet_quantile(fit, t, opts->block, p)));
+        return true;
+    }
+    if (t != NULL && t->jobs > 0) {
+        fprintf(f, "/* %s: too few jobs to fit, maximum observed in %llu jobs */\n", name,
+                (unsigned long long)t->jobs);
+        fprintf(f, "#define %s %llu\n", macro, (unsigned long long)t->exec_max_us);
+        fprintf(stderr, "Warning: %s budget is its maximum observed execution time, not an estimate\n", name);
+    } else {
+        fprintf(f, "/* %s: not in the captures, nominal budget */\n", name);
+        fprintf(f, "#define %s %u\n", macro, nominal_us);
+        fprintf(stderr, "Warning: %s not in the captures, budget is the nominal %u us\n", name, nominal_us);
+    }
+    return false;
+}
+
+/**
+ * @brief Write the budget header. Every firmware task gets its macro, so
+ *        the header always builds; tasks without a fit fall back to their
+ *        maximum observed or nominal execution time.
+ *
+ * @return false if the file could not be written or a fallback was used
+ */
+static bool export_budgets(const char* path, const pwcet_samples_t* s, const gumbel_fit_t* fits,
+                           const pwcet_options_t* opts, double p) {
+    FILE* f = fopen(path, "w");
+    bool all_estimated = true;
+
+    if (f == NULL) {
+        perror(path);
+        return false;
+    }
+
+    fprintf(f, "#ifndef PWCET_BUDGETS_H\n#define PWCET_BUDGETS_H\n\n");
+    fprintf(f, "/* Execution time budgets per task (us), used with USE_PWCET_BUDGETS.\n");
+    fprintf(f, " * Generated by trace_analyzer -W: Gumbel fit of the maxima of blocks of\n");
+    fprintf(f, " * %u jobs, at a per-job exceedance probability of %g. */\n", opts->block, p);
+    fprintf(f, "#define PWCET_EXCEEDANCE %g\n\n", p);
+
+    for (uint32_t i = 0; i < NUM_FIRMWARE_TASKS; i++) {
+        all_estimated &= export_budget(f, s, fits, opts, p, firmware_tasks[i].name,
+                                       firmware_tasks[i].nominal_us);
+    }
+
+    /* Other fitted tasks of the captures */
+    for (uint32_t i = 0; i < s->num_tasks; i++) {
+        bool firmware = false;
+        for (uint32_t k = 0; k < NUM_FIRMWARE_TASKS; k++) {
+            firmware |= strcmp(s->tasks[i].name, firmware_tasks[k].name) == 0;
+        }
+        if (!firmware && fits[i].fitted) {
+            export_budget(f, s, fits, opts, p, s->tasks[i].name, 0);
+        }
+    }
+
+    fprintf(f, "\n#endif /* PWCET_BUDGETS_H */\n");
+    fclose(f);
+    printf("Budgets at exceedance %g written to %s%s\n", p, path,
+           all_estimated ? "" : " (with fallbacks, see warnings)");
+    return all_estimated;
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Estimate the pWCET of each task over all captures and print them.
+ *
+ * Captures of both schedulers may be mixed; tasks are matched by name.
+ * With opts->export_path set, the estimates at the smallest requested
+ * probability are written as a budget header for the firmware.
+ *
+ * @return true if every task has enough jobs and an accepted fit
+ */
+bool pwcet_estimate(char* const* paths, int num_paths, const pwcet_options_t* opts) {
+    static pwcet_samples_t samples;
+    static gumbel_fit_t fits[PWCET_MAX_TASKS];
+
+    memset(&samples, 0, sizeof(samples));
+    samples.block = opts->block;
+    for (int i = 0; i < num_paths; i++) {
+        if (!load_samples(paths[i], &samples)) {
+            return false;
+        }
+    }
+
+    printf("\n========== pWCET: %d capture(s), blocks of %u jobs ==========\n", num_paths, opts->block);
+    printf("Task     |     Jobs | Blocks | Max obs us | Gumbel mu / beta  | KS D (crit)   | Lag-1 r | Fit ");
+    for (uint32_t q = 0; q < opts->num_probs; q++) {
+        printf("| p=%-8.0e ", opts->probs[q]);
+    }
+    printf("\n");
+
+    bool all_ok = (samples.num_tasks > 0);
+    double p_export = opts->probs[0];
+
+    for (uint32_t q = 1; q < opts->num_probs; q++) {
+        if (opts->probs[q] < p_export) {
+            p_export = opts->probs[q];
+        }
+    }
+
+    for (uint32_t i = 0; i < samples.num_tasks; i++) {
+        pwcet_task_t* t = &samples.tasks[i];
+        gumbel_fit_t* fit = &fits[i];
+
+        gumbel_fit(t->maxima, t->num_maxima, fit);
+        printf("%-8s | %8llu | %6zu | %10llu | ", t->name, (unsigned long long)t->jobs, t->num_maxima,
+               (unsigned long long)t->exec_max_us);
+
+        if (!fit->fitted) {
+            printf("too few blocks (need %u)\n", PWCET_MIN_BLOCKS);
+            all_ok = false;
+            continue;
+        }
+        if (fit->degenerate) {
+            printf("%8.1f / %-6s | %-13s | %7s | DEG ", fit->mu, "0", "-", "-");
+        } else {
+            printf("%8.1f / %-6.2f | %.3f (%.3f) | %7.3f | %s ", fit->mu, fit->beta, fit->ks, fit->ks_critical,
+                   fit->lag1, fit_accepted(fit) ? "OK " : "BAD");
+        }
+        for (uint32_t q = 0; q < opts->num_probs; q++) {
+            printf("| %10.0f ", ceil(pwcet_quantile(fit, t, opts->block, opts->probs[q])));
+        }
+        printf("\n");
+        all_ok = all_ok && fit_accepted(fit);
+    }
+
+    printf("Fit: OK = Gumbel accepted (KS at 5%%, |lag-1 r| < 2/sqrt(blocks)), "
+           "BAD = estimate not reliable, DEG = constant maxima\n");
+
+    bool exported = true;
+    if (opts->export_path != NULL) {
+        exported = export_budgets(opts->export_path, &samples, fits, opts, p_export);
+    }
+
+    for (uint32_t i = 0; i < samples.num_tasks; i++) {
+        free(samples.tasks[i].maxima);
+    }
+    return all_ok && exported;
+}
+/*-----------------------------------------------------------*/
@@ -0,0 +1,252 @@
+/**
+ * @file trace.c
+ * @brief Mapping and decoding of trace captures in the text report format
+ *        of both schedulers and in the binary record format.
+ */
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "trace.h"
+
+#define MAX_FIELDS 8  /* The cyclic report has 8 columns, the FreeRTOS one 7 */
+
+/**
+ * @brief Memory-map a capture and detect its format.
+ */
+bool trace_open(const char* path, trace_capture_t* cap) {
+    memset(cap, 0, sizeof(*cap));
+
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        perror(path);
+        return false;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        perror(path);
+        close(fd);
+        return false;
+    }
+
+    cap->size = (size_t)st.st_size;
+    if (cap->size > 0) {
+        const char* data = mmap(NULL, cap->size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (data == MAP_FAILED) {
+            perror(path);
+            close(fd);
+            return false;
+        }
+        madvise((void*)data, cap->size, MADV_SEQUENTIAL);
+        cap->data = data;
+    }
+    close(fd);
+
+    cap->body = cap->data;
+    cap->body_size = cap->size;
+
+    /* Binary captures start with a file header; skip it and any torn record */
+    trace_file_header_t header;
+    if (cap->size >= sizeof(header)) {
+        memcpy(&header, cap->data, sizeof(header));
+        if (header.magic == TRACE_BIN_MAGIC) {
+            if (header.version != TRACE_BIN_VERSION || header.record_size != sizeof(trace_record_t)) {
+                fprintf(stderr, "%s: unsupported binary trace version %u\n", path, header.version);
+                trace_close(cap);
+                return false;
+            }
+            cap->binary = true;
+            cap->body += sizeof(header);
+            cap->body_size = ((cap->size - sizeof(header)) / sizeof(trace_record_t)) * sizeof(trace_record_t);
+        }
+    }
+    return true;
+}
+/*-----------------------------------------------------------*/
+
+void trace_close(trace_capture_t* cap) {
+    if (cap->data != NULL) {
+        munmap((void*)cap->data, cap->size);
+    }
+    memset(cap, 0, sizeof(*cap));
+}
+/*-----------------------------------------------------------*/
+
+/* Text parsing over the mapped capture, which is not NUL-terminated */
+
+static bool parse_u64(const char* p, const char* end, uint64_t* value) {
+    while (p < end && *p == ' ') {
+        p++;
+    }
+    if (p == end || *p < '0' || *p > '9') {
+        return false;
+    }
+    *value = 0;
+    while (p < end && *p >= '0' && *p <= '9') {
+        *value = *value * 10 + (uint64_t)(*p - '0');
+        p++;
+    }
+    return true;
+}
+
+static void trim(const char** p, const char** end) {
+    while (*p < *end && **p == ' ') {
+        (*p)++;
+    }
+    while (*end > *p && ((*end)[-1] == ' ' || (*end)[-1] == '\r')) {
+        (*end)--;
+    }
+}
+
+/**
+ * @brief Decode a report row of either scheduler.
+ *
+ * @return false for any line that is not a job row
+ */
+static bool parse_text_row(const char* line, const char* end, uint32_t hyperperiod, job_row_t* row) {
+    const char* field[MAX_FIELDS];
+    const char* field_end[MAX_FIELDS];
+    uint32_t n = 0;
+
+    const char* p = line;
+    while (n < MAX_FIELDS) {
+        const char* bar = memchr(p, '|', (size_t)(end - p));
+        field[n] = p;
+        field_end[n] = bar ? bar : end;
+        n++;
+        if (bar == NULL) {
+            break;
+        }
+        p = bar + 1;
+    }
+    if (n < MAX_FIELDS - 1) {
+        return false;
+    }
+
+    /* The cyclic report has a leading frame column */
+    uint32_t base = (n == MAX_FIELDS) ? 1 : 0;
+
+    trim(&field[base], &field_end[base]);
+    if (field[base] == field_end[base] ||
+        !parse_u64(field[base + 1], field_end[base + 1], &row->release_us) ||
+        !parse_u64(field[base + 2], field_end[base + 2], &row->start_us) ||
+        !parse_u64(field[base + 3], field_end[base + 3], &row->finish_us) ||
+        !parse_u64(field[base + 4], field_end[base + 4], &row->deadline_us) ||
+        !parse_u64(field[base + 5], field_end[base + 5], &row->exec_us)) {
+        return false;  /* Column header or separator line */
+    }
+
+    const char* status = field[base + 6];
+    size_t status_len = (size_t)(field_end[base + 6] - status);
+    if (memmem(status, status_len, "SKIP", 4) != NULL) {
+        row->status = TRACE_STATUS_SKIPPED;
+    } else if (memmem(status, status_len, "MISS", 4) != NULL) {
+        row->status = TRACE_STATUS_MISS;
+    } else {
+        row->status = TRACE_STATUS_OK;
+    }
+
+    row->task = field[base];
+    row->task_len = (size_t)(field_end[base] - field[base]);
+    row->hyperperiod = hyperperiod;
+    return true;
+}
+
+static void scan_text(const char* data, size_t size, const trace_sink_t* sink) {
+    const char* p = data;
+    const char* end = data + size;
+    const size_t header_len = sizeof(TRACE_TEXT_HEADER) - 1;
+    uint32_t hyperperiod = 0;  /* Unknown until the first header */
+
+    while (p < end) {
+        const char* nl = memchr(p, '\n', (size_t)(end - p));
+        const char* line_end = nl ? nl : end;
+        size_t len = (size_t)(line_end - p);
+        job_row_t row;
+
+        if (len > header_len && memcmp(p, TRACE_TEXT_HEADER, header_len) == 0) {
+            uint64_t number;
+            if (parse_u64(p + header_len, line_end, &number)) {
+                hyperperiod = (uint32_t)number;
+                sink->hyperperiod(sink->ctx, hyperperiod);
+            }
+        } else if (memchr(p, '|', len) != NULL &&
+                   parse_text_row(p, line_end, hyperperiod, &row)) {
+            sink->job(sink->ctx, &row);
+        }
+        p = line_end + 1;
+    }
+}
+
+static void scan_binary(const char* data, size_t size, const trace_sink_t* sink) {
+    size_t count = size / sizeof(trace_record_t);
+    uint32_t last_hyperperiod = 0;
+
+    for (size_t i = 0; i < count; i++) {
+        trace_record_t rec;
+        job_row_t row;
+
+        memcpy(&rec, data + i * sizeof(trace_record_t), sizeof(rec));
+        row.task = rec.task;
+        row.task_len = strnlen(rec.task, TRACE_NAME_LEN);
+        row.hyperperiod = rec.hyperperiod;
+        row.release_us = rec.release_us;
+        row.start_us = rec.start_us;
+        row.finish_us = rec.finish_us;
+        row.deadline_us = rec.deadline_us;
+        row.exec_us = rec.exec_us;
+        row.status = (rec.status <= TRACE_STATUS_SKIPPED) ? (trace_status_t)rec.status : TRACE_STATUS_MISS;
+
+        if (i == 0 || rec.hyperperiod != last_hyperperiod) {
+            sink->hyperperiod(sink->ctx, rec.hyperperiod);
+            last_hyperperiod = rec.hyperperiod;
+        }
+        sink->job(sink->ctx, &row);
+    }
+}
+
+/**
+ * @brief Decode a part of a capture body and feed it to a sink.
+ *
+ * @param data Start of the part: a hyperperiod header (text) or a record (binary)
+ */
+void trace_scan(const char* data, size_t size, bool binary, const trace_sink_t* sink) {
+    if (binary) {
+        scan_binary(data, size, sink);
+    } else {
+        scan_text(data, size, sink);
+    }
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Move a split point forward to the next chunk boundary.
+ *
+ * Text captures split at hyperperiod headers, binary ones at records.
+ */
+size_t trace_align_split(const trace_capture_t* cap, size_t pos) {
+    const char* data = cap->body;
+    size_t size = cap->body_size;
+    const size_t header_len = sizeof(TRACE_TEXT_HEADER) - 1;
+
+    if (cap->binary) {
+        return pos - pos % sizeof(trace_record_t);
+    }
+    while (pos < size) {
+        const char* hit = memmem(data + pos, size - pos, TRACE_TEXT_HEADER, header_len);
+        if (hit == NULL) {
+            return size;
+        }
+        size_t at = (size_t)(hit - data);
+        if (at == 0 || data[at - 1] == '\n') {
+            return at;
+        }
+        pos = at + 1;
+    }
+    return size;
+}
+/*-----------------------------------------------------------*/
@@ -0,0 +1,43 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "trace_format.h"
+
+/* One job row, as decoded from either format */
+typedef struct {
+    const char* task;         /* Points into the capture, not NUL-terminated */
+    size_t task_len;
+    uint32_t hyperperiod;
+    uint64_t release_us;
+    uint64_t start_us;
+    uint64_t finish_us;
+    uint64_t deadline_us;
+    uint64_t exec_us;
+    trace_status_t status;
+} job_row_t;
+
+/* Receiver of the decoded stream of a capture */
+typedef struct {
+    void (*hyperperiod)(void* ctx, uint32_t hyperperiod);  /* Start of a hyperperiod */
+    void (*job)(void* ctx, const job_row_t* row);
+    void* ctx;
+} trace_sink_t;
+
+/* Memory-mapped capture; the body excludes the binary file header */
+typedef struct {
+    const char* data;
+    size_t size;
+    const char* body;
+    size_t body_size;
+    bool binary;
+} trace_capture_t;
+
+bool trace_open(const char* path, trace_capture_t* cap);
+void trace_close(trace_capture_t* cap);
+size_t trace_align_split(const trace_capture_t* cap, size_t pos);
+void trace_scan(const char* data, size_t size, bool binary, const trace_sink_t* sink);
+
+#endif /* TRACE_H */
@@ -0,0 +1,46 @@
+#ifndef TRACE_FORMAT_H
+#define TRACE_FORMAT_H
+
+#include <stdint.h>
+
+/* Text format: the hyperperiod reports printed by CyclicSched and
+ * FreeRTOS_Intro. Each report starts with this header, followed by the
+ * hyperperiod number; so does the one-line summary printed instead of a
+ * report the trace budget cannot afford. */
+#define TRACE_TEXT_HEADER "========== Hyperperiod "
+
+/* Binary format: a file header followed by fixed-size little-endian job
+ * records, so a capture can be split at any record boundary. */
+#define TRACE_BIN_MAGIC   0x31435254u  /* "TRC1" */
+#define TRACE_BIN_VERSION 1
+#define TRACE_NAME_LEN    8
+
+typedef enum {
+    TRACE_STATUS_OK,
+    TRACE_STATUS_MISS,
+    TRACE_STATUS_SKIPPED
+} trace_status_t;
+
+typedef struct {
+    uint32_t magic;        /* TRACE_BIN_MAGIC */
+    uint16_t version;      /* TRACE_BIN_VERSION */
+    uint16_t record_size;  /* sizeof(trace_record_t) */
+} trace_file_header_t;
+
+typedef struct {
+    uint64_t release_us;
+    uint64_t start_us;
+    uint64_t finish_us;
+    uint64_t deadline_us;
+    uint32_t hyperperiod;          /* Hyperperiod the job was reported in */
+    uint32_t exec_us;
+    char task[TRACE_NAME_LEN];     /* Not NUL-terminated if 8 characters long */
+    uint8_t status;                /* trace_status_t */
+    uint8_t frame;                 /* Minor frame (cyclic executive only) */
+    uint16_t reserved[3];
+} trace_record_t;
+
+_Static_assert(sizeof(trace_file_header_t) == 8, "trace file header layout");
+_Static_assert(sizeof(trace_record_t) == 56, "trace record layout");
+
+#endif /* TRACE_FORMAT_H */
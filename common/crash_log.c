@@ -0,0 +1,169 @@
+/**
+ * @file crash_log.c
+ * @brief Fault handlers and the persistent crash record.
+ *
+ * The stack limit checks cost nothing per context switch: the port loads
+ * PSPLIM with the task's stack end as part of restoring its context, and
+ * the core compares on every push. Enabling the UsageFault makes an
+ * overflow fault with STKOF set instead of escalating to a HardFault on
+ * the core that initialized the log; on the other core it escalates, and
+ * the HardFault handler recognizes it by the same status bit. The
+ * handlers run on the main stack, so an overflow of the main stack itself
+ * is only recorded if the handler's frame still fits above the limit.
+ */
+#include <stdio.h>
+#include <string.h>
+#include "pico/stdlib.h"
+#include "pico/platform.h"
+#include "hardware/exception.h"
+#include "hardware/watchdog.h"
+#include "hardware/structs/m33.h"
+#include "crash_log.h"
+
+#define CRASH_LOG_MAGIC 0x43524153u    /* "CRAS" */
+#define SHCSR_USGFAULTENA (1u << 18)
+#define CFSR_STKOF (1u << 20)          /* UsageFault: stack limit violation */
+#define EXC_RETURN_SPSEL (1u << 2)     /* The exception frame is on the process stack */
+#define CRASH_REBOOT_DELAY_MS 10
+
+extern char __StackBottom[];  /* Core 0 main stack end, from the linker script */
+
+static crash_record_t __uninitialized_ram(crash_record);
+static crash_context_t context_name;
+static bool reboot_after_crash;
+
+static inline uint32_t read_psp(void) {
+    uint32_t value;
+    __asm volatile ("mrs %0, psp" : "=r" (value));
+    return value;
+}
+
+static inline uint32_t read_psplim(void) {
+    uint32_t value;
+    __asm volatile ("mrs %0, psplim" : "=r" (value));
+    return value;
+}
+
+static inline uint32_t read_msp(void) {
+    uint32_t value;
+    __asm volatile ("mrs %0, msp" : "=r" (value));
+    return value;
+}
+
+static inline uint32_t read_msplim(void) {
+    uint32_t value;
+    __asm volatile ("mrs %0, msplim" : "=r" (value));
+    return value;
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Fill the record; the caller resets or halts afterwards.
+ */
+static void store(crash_reason_t reason, const char *context, uint32_t sp, uint32_t sp_limit) {
+    crash_record.magic = CRASH_LOG_MAGIC;
+    crash_record.count++;
+    crash_record.reason = reason;
+    crash_record.core = get_core_num();
+    crash_record.cfsr = m33_hw->cfsr;
+    crash_record.hfsr = m33_hw->hfsr;
+    crash_record.sp = sp;
+    crash_record.sp_limit = sp_limit;
+    crash_record.time_us = time_us_64();
+    strncpy(crash_record.context, (context != NULL) ? context : "?", CRASH_LOG_NAME_LEN - 1);
+    crash_record.context[CRASH_LOG_NAME_LEN - 1] = '\0';
+}
+/*-----------------------------------------------------------*/
+
+static void __attribute__((noreturn)) stop(void) {
+    if (reboot_after_crash) {
+        watchdog_reboot(0, 0, CRASH_REBOOT_DELAY_MS);
+    }
+    while (true) {
+        tight_loop_contents();
+    }
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief UsageFault and HardFault handler.
+ */
+static void crash_fault_handler(void) {
+    uint32_t exc_return = (uint32_t)(uintptr_t)__builtin_return_address(0);
+    bool task = (exc_return & EXC_RETURN_SPSEL) != 0;
+    crash_reason_t reason = (m33_hw->cfsr & CFSR_STKOF) ? CRASH_STACK_OVERFLOW : CRASH_FAULT;
+
+    if (task) {
+        store(reason, (context_name != NULL) ? context_name() : NULL, read_psp(), read_psplim());
+    } else {
+        store(reason, "MSP", read_msp(), read_msplim());
+    }
+    stop();
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Install the fault handlers and the main stack limit of core 0.
+ *        A record left by a power-on is garbage and is cleared.
+ *
+ * @param context Name of the running task, NULL without a kernel
+ * @param reboot Reset through the watchdog after a crash instead of halting
+ */
+void crash_log_init(crash_context_t context, bool reboot) {
+    if (crash_record.magic != CRASH_LOG_MAGIC) {
+        memset(&crash_record, 0, sizeof(crash_record));
+        crash_record.magic = CRASH_LOG_MAGIC;
+    }
+    context_name = context;
+    reboot_after_crash = reboot;
+
+    exception_set_exclusive_handler(HARDFAULT_EXCEPTION, crash_fault_handler);
+    exception_set_exclusive_handler(USAGEFAULT_EXCEPTION, crash_fault_handler);
+    m33_hw->shcsr |= SHCSR_USGFAULTENA;
+
+    if (get_core_num() == 0) {
+        __asm volatile ("msr msplim, %0" : : "r" ((uint32_t)(uintptr_t)__StackBottom));
+    }
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Record a crash found by software, then reset or halt.
+ */
+void crash_log_record(crash_reason_t reason, const char *context) {
+    store(reason, context, 0, 0);
+    stop();
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Last crash not yet reported.
+ *
+ * @return false if there was none since the last call
+ */
+bool crash_log_last(crash_record_t *record) {
+    if (crash_record.reason == CRASH_NONE) {
+        return false;
+    }
+    *record = crash_record;
+    crash_record.reason = CRASH_NONE;
+    return true;
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Print the crash that caused the last reset, if any.
+ */
+void crash_log_print(void) {
+    static const char *reason_names[] = { "none", "stack overflow", "stack overflow (software check)", "fault" };
+    crash_record_t record;
+
+    if (!crash_log_last(&record)) {
+        return;
+    }
+    printf("*** Last reset: %s in %s on core %u at %llu us (CFSR 0x%08x, HFSR 0x%08x, "
+           "SP 0x%08x, limit 0x%08x); %u crash(es) since power-on ***\n",
+           reason_names[record.reason], record.context, record.core, record.time_us,
+           record.cfsr, record.hfsr, record.sp, record.sp_limit, record.count);
+}
+/*-----------------------------------------------------------*/
@@ -0,0 +1,43 @@
+#ifndef CRASH_LOG_H
+#define CRASH_LOG_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/* Persistent crash record: kept in uninitialized RAM, so it survives the
+ * watchdog reset that follows a fault and is reported at the next boot.
+ * Stack overflows are caught by the stack limit registers (PSPLIM for the
+ * tasks, loaded by the kernel port at every context switch, and MSPLIM for
+ * the main stack) and raise a UsageFault at the first push past the limit. */
+
+#define CRASH_LOG_NAME_LEN 16
+
+typedef enum {
+    CRASH_NONE,
+    CRASH_STACK_OVERFLOW,     /* Stack limit violation (UsageFault STKOF) */
+    CRASH_STACK_OVERFLOW_SW,  /* Reported by the kernel's software check */
+    CRASH_FAULT               /* Any other fault */
+} crash_reason_t;
+
+typedef struct {
+    uint32_t magic;
+    uint32_t count;           /* Crashes since power-on */
+    crash_reason_t reason;    /* Last crash, CRASH_NONE once reported */
+    uint32_t core;
+    uint32_t cfsr;            /* Configurable and hard fault status */
+    uint32_t hfsr;
+    uint32_t sp;              /* Stack pointer and limit of the faulting context */
+    uint32_t sp_limit;
+    uint64_t time_us;
+    char context[CRASH_LOG_NAME_LEN];  /* Task name, or "MSP" for the main stack */
+} crash_record_t;
+
+/* Name of the running task, called from the fault handler */
+typedef const char *(*crash_context_t)(void);
+
+void crash_log_init(crash_context_t context, bool reboot);
+void crash_log_record(crash_reason_t reason, const char *context) __attribute__((noreturn));
+bool crash_log_last(crash_record_t *record);
+void crash_log_print(void);
+
+#endif /* CRASH_LOG_H */
@@ -0,0 +1,38 @@
+#ifndef DAG_H
+#define DAG_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define DAG_MAX_TASKS 8
+#define DAG_MAX_CHAIN 4
+
+/* Precedence edge between two tasks (indices into the task set). A job of
+ * the successor released at r may only start once the predecessor's job with
+ * the latest release <= r has completed (or was skipped). */
+typedef struct {
+    uint8_t pred;
+    uint8_t succ;
+} dag_edge_t;
+
+/* Cause-effect chain: tasks[0] is the sensor, tasks[length-1] the actuator */
+typedef struct {
+    const char* name;
+    uint8_t length;
+    uint8_t tasks[DAG_MAX_CHAIN];
+} dag_chain_t;
+
+/* Worst-case bounds of a chain under LET communication */
+typedef struct {
+    uint64_t max_latency_us;  /* Event just after a sensor release -> first actuator output */
+    uint64_t max_age_us;      /* Sensor release -> actuator output using that data */
+} dag_chain_bound_t;
+
+bool dag_is_acyclic(uint8_t num_tasks, const dag_edge_t *edges, uint8_t num_edges);
+bool dag_topological_order(uint8_t num_tasks, const dag_edge_t *edges, uint8_t num_edges,
+                           uint8_t order[DAG_MAX_TASKS]);
+uint32_t dag_pred_job(uint32_t pred_period_ms, uint64_t release_offset_us);
+void dag_analyze_let_chain(const dag_chain_t *chain, const uint32_t *period_ms,
+                           const uint32_t *deadline_ms, dag_chain_bound_t *bound);
+
+#endif /* DAG_H */
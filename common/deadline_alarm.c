@@ -0,0 +1,187 @@
+/**
+ * @file deadline_alarm.c
+ * @brief Deadline alarms on one hardware timer alarm: it is set to the
+ *        earliest armed deadline and reprogrammed each time it fires.
+ *
+ * Disarming only clears the job's slot; an alarm left programmed for it
+ * finds nothing due and moves on to the next deadline. The slots are
+ * shared under a hardware spin lock, so jobs may be armed and disarmed
+ * from tasks, interrupts and either core. The handler runs at the alarm's
+ * interrupt priority: above the scheduler's own interrupt to preempt a job
+ * running in it.
+ */
+#include <stdio.h>
+#include "pico/stdlib.h"
+#include "hardware/irq.h"
+#include "hardware/sync.h"
+#include "hardware/timer.h"
+#include "deadline_alarm.h"
+
+typedef struct {
+    uint64_t deadline_us;
+    uint64_t fired_us;
+    bool armed;
+    bool fired;
+} alarm_slot_t;
+
+static alarm_slot_t slots[DEADLINE_ALARM_MAX_JOBS];
+static deadline_handler_t miss_handler;
+static deadline_alarm_stats_t stats;
+static unsigned int alarm_num;
+static spin_lock_t *alarm_lock;
+static uint64_t programmed_us = UINT64_MAX;  /* Target of the hardware alarm, UINT64_MAX = none */
+static deadline_miss_t queue[DEADLINE_ALARM_QUEUE_LEN];
+static uint32_t queue_head = 0;  /* Oldest record */
+static uint32_t queue_len = 0;
+
+/**
+ * @brief Set the hardware alarm to a target; called with the lock held.
+ */
+static void program(uint64_t target_us) {
+    programmed_us = target_us;
+    if (target_us == UINT64_MAX) {
+        hardware_alarm_cancel(alarm_num);
+        return;
+    }
+    /* A target in the past is not raised by the hardware: retry just ahead */
+    while (hardware_alarm_set_target(alarm_num, from_us_since_boot(target_us))) {
+        target_us = time_us_64() + DEADLINE_ALARM_MIN_LEAD_US;
+        programmed_us = target_us;
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void alarm_callback(unsigned int num) {
+    uint64_t now = time_us_64();
+    uint64_t next = UINT64_MAX;
+    uint64_t due_deadline[DEADLINE_ALARM_MAX_JOBS];
+    uint32_t due = 0;
+
+    uint32_t save = spin_lock_blocking(alarm_lock);
+    for (uint8_t j = 0; j < DEADLINE_ALARM_MAX_JOBS; j++) {
+        alarm_slot_t *slot = &slots[j];
+        if (!slot->armed) {
+            continue;
+        }
+        if (slot->deadline_us <= now) {
+            slot->armed = false;
+            slot->fired = true;
+            slot->fired_us = now;
+            due |= 1u << j;
+            due_deadline[j] = slot->deadline_us;
+            stats.fired++;
+            if (now - slot->deadline_us > stats.latency_max_us) {
+                stats.latency_max_us = (uint32_t)(now - slot->deadline_us);
+            }
+            if (queue_len < DEADLINE_ALARM_QUEUE_LEN) {
+                queue[(queue_head + queue_len++) % DEADLINE_ALARM_QUEUE_LEN] = (deadline_miss_t){
+                    .job = j, .deadline_us = slot->deadline_us,
+                    .latency_us = (uint32_t)(now - slot->deadline_us) };
+            } else {
+                stats.lost++;
+            }
+        } else if (slot->deadline_us < next) {
+            next = slot->deadline_us;
+        }
+    }
+    program(next);
+    spin_unlock(alarm_lock, save);
+
+    for (uint8_t j = 0; due != 0; j++, due >>= 1) {
+        if ((due & 1) && miss_handler != NULL) {
+            miss_handler(j, due_deadline[j], now);
+        }
+    }
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Claim a hardware alarm for the deadlines. Call once, before the
+ *        interrupt accounting is installed so that it covers the alarm.
+ *
+ * @param handler Called for each miss, from the interrupt: counting and
+ *        recovery
+ * @param irq_priority Priority of the alarm interrupt
+ */
+void deadline_alarm_init(deadline_handler_t handler, uint8_t irq_priority) {
+    miss_handler = handler;
+    alarm_lock = spin_lock_instance(spin_lock_claim_unused(true));
+    alarm_num = (unsigned int)hardware_alarm_claim_unused(true);
+    hardware_alarm_set_callback(alarm_num, alarm_callback);
+    irq_set_priority(hardware_alarm_get_irq_num(alarm_num), irq_priority);
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Arm the alarm of a released job; a deadline already passed fires
+ *        at once.
+ *
+ * @param job Task index, below DEADLINE_ALARM_MAX_JOBS
+ */
+void deadline_alarm_arm(uint8_t job, uint64_t deadline_us) {
+    uint32_t save = spin_lock_blocking(alarm_lock);
+    slots[job] = (alarm_slot_t){ .deadline_us = deadline_us, .armed = true };
+    stats.armed++;
+    if (deadline_us < programmed_us) {
+        program(deadline_us);
+    }
+    spin_unlock(alarm_lock, save);
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Disarm the alarm of a completed or skipped job.
+ *
+ * @param fired_us Set to the time the alarm fired, if it did (may be NULL)
+ * @return true if the alarm fired: the job missed its deadline and the
+ *         handler has already run for it
+ */
+bool deadline_alarm_disarm(uint8_t job, uint64_t *fired_us) {
+    uint32_t save = spin_lock_blocking(alarm_lock);
+    alarm_slot_t *slot = &slots[job];
+    bool fired = slot->fired;
+    if (fired && fired_us != NULL) {
+        *fired_us = slot->fired_us;
+    }
+    slot->armed = false;
+    slot->fired = false;
+    spin_unlock(alarm_lock, save);
+    return fired;
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Take the oldest miss record posted by the alarm.
+ *
+ * @return false if the queue is empty
+ */
+bool deadline_alarm_take_miss(deadline_miss_t *miss) {
+    uint32_t save = spin_lock_blocking(alarm_lock);
+    bool taken = queue_len > 0;
+    if (taken) {
+        *miss = queue[queue_head];
+        queue_head = (queue_head + 1) % DEADLINE_ALARM_QUEUE_LEN;
+        queue_len--;
+    }
+    spin_unlock(alarm_lock, save);
+    return taken;
+}
+/*-----------------------------------------------------------*/
+
+void deadline_alarm_get_stats(deadline_alarm_stats_t *out) {
+    uint32_t save = spin_lock_blocking(alarm_lock);
+    *out = stats;
+    spin_unlock(alarm_lock, save);
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Print the alarms fired and how late the handler ran.
+ */
+void deadline_alarm_print(void) {
+    deadline_alarm_stats_t s;
+    deadline_alarm_get_stats(&s);
+    printf("Deadline alarms: %u fired of %u armed, handler latency max %u us, %u record(s) lost\n",
+           s.fired, s.armed, s.latency_max_us, s.lost);
+}
+/*-----------------------------------------------------------*/
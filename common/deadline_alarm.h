@@ -0,0 +1,41 @@
+#ifndef DEADLINE_ALARM_H
+#define DEADLINE_ALARM_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/* Deadline alarms: every released job arms an alarm at its absolute
+ * deadline, and the job's completion disarms it. An alarm that fires finds
+ * the job still pending, posts a miss record and calls the miss handler at
+ * once, from the interrupt, instead of the miss surfacing when (or if) the
+ * job completes. The records wait in a queue for the next report. */
+
+#define DEADLINE_ALARM_MAX_JOBS 8     /* Jobs armed at once, identified by their task index */
+#define DEADLINE_ALARM_MIN_LEAD_US 2  /* A deadline already passed fires this much later */
+#define DEADLINE_ALARM_QUEUE_LEN 16   /* Miss records held until they are taken */
+
+/* Called from the alarm interrupt for each job still pending at its deadline */
+typedef void (*deadline_handler_t)(uint8_t job, uint64_t deadline_us, uint64_t now_us);
+
+/* A miss detected by the alarm */
+typedef struct {
+    uint8_t job;
+    uint64_t deadline_us;
+    uint32_t latency_us;      /* Deadline to detection */
+} deadline_miss_t;
+
+typedef struct {
+    uint32_t armed;           /* Alarms armed since start */
+    uint32_t fired;           /* Deadlines that passed before the job completed */
+    uint32_t latency_max_us;  /* Deadline to handler, worst since start */
+    uint32_t lost;            /* Miss records dropped by a full queue */
+} deadline_alarm_stats_t;
+
+void deadline_alarm_init(deadline_handler_t handler, uint8_t irq_priority);
+void deadline_alarm_arm(uint8_t job, uint64_t deadline_us);
+bool deadline_alarm_disarm(uint8_t job, uint64_t *fired_us);
+bool deadline_alarm_take_miss(deadline_miss_t *miss);
+void deadline_alarm_get_stats(deadline_alarm_stats_t *stats);
+void deadline_alarm_print(void);
+
+#endif /* DEADLINE_ALARM_H */
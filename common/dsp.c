@@ -0,0 +1,331 @@
+/**
+ * @file dsp.c
+ * @brief Fixed-point signal-processing kernels (FIR, FFT, CRC, matrix
+ *        multiply) used as realistic workloads, in a portable C variant and
+ *        a Cortex-M33 DSP extension variant.
+ */
+#include <stdio.h>
+#include <string.h>
+#include "bsp.h"
+#include "dsp.h"
+
+#if defined(__ARM_FEATURE_DSP)
+#include <arm_acle.h>
+#define DSP_HAS_SIMD 1
+#else
+#define DSP_HAS_SIMD 0
+#endif
+
+#define CALIBRATION_CALLS 16
+
+/* Kernel inputs and outputs. Complex values are packed as re (low half) and
+ * im (high half) of a 32-bit word, matching the dual 16-bit instructions. */
+static int16_t fir_input[DSP_FIR_SAMPLES + DSP_FIR_TAPS];
+static int16_t fir_coeffs[DSP_FIR_TAPS];
+static int16_t fir_output[DSP_FIR_SAMPLES];
+static uint32_t fft_input[DSP_FFT_POINTS];
+static uint32_t fft_buffer[DSP_FFT_POINTS];
+static uint32_t fft_twiddle[DSP_FFT_POINTS / 2];
+static uint8_t crc_input[DSP_CRC_BYTES];
+static int16_t mat_a[DSP_MAT_DIM][DSP_MAT_DIM];
+static int16_t mat_bt[DSP_MAT_DIM][DSP_MAT_DIM];  /* B transposed: columns are contiguous */
+static int16_t mat_c[DSP_MAT_DIM][DSP_MAT_DIM];
+
+static const uint32_t crc_nibble_table[16] = {
+    0x00000000, 0x1DB71064, 0x3B6E20C8, 0x26D930AC, 0x76DC4190, 0x6B6B51F4, 0x4DB26158, 0x5005713C,
+    0xEDB88320, 0xF00F9344, 0xD6D6A3E8, 0xCB61B38C, 0x9B64C2B0, 0x86D3D2D4, 0xA00AE278, 0xBDBDF21C
+};
+
+static inline uint32_t pack_complex(int32_t re, int32_t im) {
+    return ((uint32_t)re & 0xFFFF) | ((uint32_t)im << 16);
+}
+
+static inline int16_t complex_re(uint32_t c) {
+    return (int16_t)(c & 0xFFFF);
+}
+
+static inline int16_t complex_im(uint32_t c) {
+    return (int16_t)(c >> 16);
+}
+
+static inline int16_t saturate_q15(int32_t value) {
+    if (value > INT16_MAX) {
+        return INT16_MAX;
+    }
+    if (value < INT16_MIN) {
+        return INT16_MIN;
+    }
+    return (int16_t)value;
+}
+
+static inline uint32_t load_pair(const int16_t* p) {
+    uint32_t pair;
+    memcpy(&pair, p, sizeof(pair));  /* Unaligned for odd sample offsets */
+    return pair;
+}
+
+/**
+ * @brief Fill the kernel inputs and the FFT twiddle factors.
+ */
+void dsp_init(void) {
+    uint32_t lcg = 1;
+
+    for (uint32_t i = 0; i < DSP_FIR_SAMPLES + DSP_FIR_TAPS; i++) {
+        lcg = lcg * 1664525u + 1013904223u;
+        fir_input[i] = (int16_t)(lcg >> 16);
+    }
+    for (uint32_t i = 0; i < DSP_FIR_TAPS; i++) {
+        fir_coeffs[i] = (int16_t)(32767 / DSP_FIR_TAPS);  /* Moving average */
+    }
+    for (uint32_t i = 0; i < DSP_FFT_POINTS; i++) {
+        lcg = lcg * 1664525u + 1013904223u;
+        fft_input[i] = pack_complex((int16_t)(lcg >> 16), 0);
+    }
+    for (uint32_t i = 0; i < DSP_CRC_BYTES; i++) {
+        crc_input[i] = (uint8_t)i;
+    }
+    for (uint32_t r = 0; r < DSP_MAT_DIM; r++) {
+        for (uint32_t c = 0; c < DSP_MAT_DIM; c++) {
+            mat_a[r][c] = (int16_t)((r + 1) * 1000 - c * 300);
+            mat_bt[c][r] = (int16_t)((c + 1) * 700 - r * 200);
+        }
+    }
+
+    /* W^k = exp(-j*2*pi*k/N) by rotation, so no libm is needed */
+    double re = 1.0;
+    double im = 0.0;
+    const double step_re = 0.99518472667219688624;   /* cos(2*pi/64) */
+    const double step_im = -0.09801714032956060199;  /* -sin(2*pi/64) */
+    for (uint32_t k = 0; k < DSP_FFT_POINTS / 2; k++) {
+        fft_twiddle[k] = pack_complex(saturate_q15((int32_t)(re * 32768.0)),
+                                      saturate_q15((int32_t)(im * 32768.0)));
+        double next_re = re * step_re - im * step_im;
+        im = re * step_im + im * step_re;
+        re = next_re;
+    }
+}
+/*-----------------------------------------------------------*/
+
+bool dsp_simd_available(void) {
+    return DSP_HAS_SIMD;
+}
+/*-----------------------------------------------------------*/
+
+const char* dsp_kernel_name(dsp_kernel_t kernel) {
+    static const char* names[DSP_NUM_KERNELS] = { "FIR", "FFT", "CRC32", "MatMul" };
+    return names[kernel];
+}
+/*-----------------------------------------------------------*/
+
+uint32_t dsp_samples_per_call(dsp_kernel_t kernel) {
+    static const uint32_t samples[DSP_NUM_KERNELS] = {
+        DSP_FIR_SAMPLES, DSP_FFT_POINTS, DSP_CRC_BYTES, DSP_MAT_DIM * DSP_MAT_DIM
+    };
+    return samples[kernel];
+}
+/*-----------------------------------------------------------*/
+
+static uint32_t fir_portable(void) {
+    for (uint32_t n = 0; n < DSP_FIR_SAMPLES; n++) {
+        int32_t acc = 0;
+        for (uint32_t k = 0; k < DSP_FIR_TAPS; k++) {
+            acc += (int32_t)fir_input[n + k] * fir_coeffs[k];
+        }
+        fir_output[n] = saturate_q15(acc >> 15);
+    }
+    return (uint16_t)fir_output[DSP_FIR_SAMPLES - 1];
+}
+
+static uint32_t fft_portable(void) {
+    memcpy(fft_buffer, fft_input, sizeof(fft_buffer));
+
+    /* Bit-reversal permutation */
+    for (uint32_t i = 1, j = 0; i < DSP_FFT_POINTS; i++) {
+        uint32_t bit = DSP_FFT_POINTS >> 1;
+        for (; j & bit; bit >>= 1) {
+            j ^= bit;
+        }
+        j ^= bit;
+        if (i < j) {
+            uint32_t t = fft_buffer[i];
+            fft_buffer[i] = fft_buffer[j];
+            fft_buffer[j] = t;
+        }
+    }
+
+    /* Butterflies, halving every stage to stay in Q15 */
+    for (uint32_t len = 2; len <= DSP_FFT_POINTS; len <<= 1) {
+        uint32_t half = len >> 1;
+        uint32_t stride = DSP_FFT_POINTS / len;
+        for (uint32_t i = 0; i < DSP_FFT_POINTS; i += len) {
+            for (uint32_t k = 0; k < half; k++) {
+                uint32_t w = fft_twiddle[k * stride];
+                uint32_t a = fft_buffer[i + k];
+                uint32_t b = fft_buffer[i + k + half];
+                int32_t t_re = ((int32_t)complex_re(b) * complex_re(w) -
+                                (int32_t)complex_im(b) * complex_im(w)) >> 15;
+                int32_t t_im = ((int32_t)complex_re(b) * complex_im(w) +
+                                (int32_t)complex_im(b) * complex_re(w)) >> 15;
+                fft_buffer[i + k] = pack_complex((complex_re(a) + t_re) >> 1,
+                                                 (complex_im(a) + t_im) >> 1);
+                fft_buffer[i + k + half] = pack_complex((complex_re(a) - t_re) >> 1,
+                                                        (complex_im(a) - t_im) >> 1);
+            }
+        }
+    }
+    return fft_buffer[1];
+}
+
+static uint32_t crc_run(void) {
+    uint32_t crc = 0xFFFFFFFF;
+
+    /* The M33 has no CRC instruction: both variants use the nibble table */
+    for (uint32_t i = 0; i < DSP_CRC_BYTES; i++) {
+        crc ^= crc_input[i];
+        crc = (crc >> 4) ^ crc_nibble_table[crc & 0x0F];
+        crc = (crc >> 4) ^ crc_nibble_table[crc & 0x0F];
+    }
+    return ~crc;
+}
+
+static uint32_t matmul_portable(void) {
+    for (uint32_t r = 0; r < DSP_MAT_DIM; r++) {
+        for (uint32_t c = 0; c < DSP_MAT_DIM; c++) {
+            int32_t acc = 0;
+            for (uint32_t k = 0; k < DSP_MAT_DIM; k++) {
+                acc += (int32_t)mat_a[r][k] * mat_bt[c][k];
+            }
+            mat_c[r][c] = saturate_q15(acc >> 15);
+        }
+    }
+    return (uint16_t)mat_c[DSP_MAT_DIM - 1][DSP_MAT_DIM - 1];
+}
+/*-----------------------------------------------------------*/
+
+#if DSP_HAS_SIMD
+static uint32_t fir_simd(void) {
+    for (uint32_t n = 0; n < DSP_FIR_SAMPLES; n++) {
+        int32_t acc = 0;
+        for (uint32_t k = 0; k < DSP_FIR_TAPS; k += 2) {
+            acc = __smlad(load_pair(&fir_input[n + k]), load_pair(&fir_coeffs[k]), acc);
+        }
+        fir_output[n] = (int16_t)__ssat(acc >> 15, 16);
+    }
+    return (uint16_t)fir_output[DSP_FIR_SAMPLES - 1];
+}
+
+static uint32_t fft_simd(void) {
+    memcpy(fft_buffer, fft_input, sizeof(fft_buffer));
+
+    for (uint32_t i = 1, j = 0; i < DSP_FFT_POINTS; i++) {
+        uint32_t bit = DSP_FFT_POINTS >> 1;
+        for (; j & bit; bit >>= 1) {
+            j ^= bit;
+        }
+        j ^= bit;
+        if (i < j) {
+            uint32_t t = fft_buffer[i];
+            fft_buffer[i] = fft_buffer[j];
+            fft_buffer[j] = t;
+        }
+    }
+
+    for (uint32_t len = 2; len <= DSP_FFT_POINTS; len <<= 1) {
+        uint32_t half = len >> 1;
+        uint32_t stride = DSP_FFT_POINTS / len;
+        for (uint32_t i = 0; i < DSP_FFT_POINTS; i += len) {
+            for (uint32_t k = 0; k < half; k++) {
+                uint32_t w = fft_twiddle[k * stride];
+                uint32_t a = fft_buffer[i + k];
+                uint32_t b = fft_buffer[i + k + half];
+                /* Complex multiply: re = dual multiply-subtract, im = exchanged dual multiply-add */
+                uint32_t t = pack_complex(__smusd(b, w) >> 15, __smuadx(b, w) >> 15);
+                fft_buffer[i + k] = __shadd16(a, t);
+                fft_buffer[i + k + half] = __shsub16(a, t);
+            }
+        }
+    }
+    return fft_buffer[1];
+}
+
+static uint32_t matmul_simd(void) {
+    for (uint32_t r = 0; r < DSP_MAT_DIM; r++) {
+        for (uint32_t c = 0; c < DSP_MAT_DIM; c++) {
+            int32_t acc = 0;
+            for (uint32_t k = 0; k < DSP_MAT_DIM; k += 2) {
+                acc = __smlad(load_pair(&mat_a[r][k]), load_pair(&mat_bt[c][k]), acc);
+            }
+            mat_c[r][c] = (int16_t)__ssat(acc >> 15, 16);
+        }
+    }
+    return (uint16_t)mat_c[DSP_MAT_DIM - 1][DSP_MAT_DIM - 1];
+}
+#endif /* DSP_HAS_SIMD */
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Run one call of a kernel.
+ *
+ * The SIMD variant falls back to the portable one where the DSP extension
+ * is not available.
+ *
+ * @return A value of the output, so the work cannot be optimized away
+ */
+uint32_t dsp_run(dsp_kernel_t kernel, dsp_variant_t variant) {
+#if DSP_HAS_SIMD
+    if (variant == DSP_VARIANT_SIMD) {
+        switch (kernel) {
+        case DSP_FIR:    return fir_simd();
+        case DSP_FFT:    return fft_simd();
+        case DSP_MATMUL: return matmul_simd();
+        default:         break;
+        }
+    }
+#else
+    (void)variant;
+#endif
+
+    switch (kernel) {
+    case DSP_FIR:    return fir_portable();
+    case DSP_FFT:    return fft_portable();
+    case DSP_CRC:    return crc_run();
+    case DSP_MATMUL: return matmul_portable();
+    default:         return 0;
+    }
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Number of kernel calls that fill an execution-time budget.
+ *
+ * @param budget_cycles Budget, e.g. one of the EXECUTION_TIME_* values
+ * @return Calls per job, at least 1
+ */
+uint32_t dsp_calibrate(dsp_kernel_t kernel, dsp_variant_t variant, uint32_t budget_cycles) {
+    uint64_t start = time_us_64();
+    for (uint32_t i = 0; i < CALIBRATION_CALLS; i++) {
+        (void)dsp_run(kernel, variant);
+    }
+    uint64_t elapsed_cycles = (time_us_64() - start) * CYCLES_PER_US;
+
+    if (elapsed_cycles == 0) {
+        return budget_cycles;  /* Below timer resolution: assume one cycle per call */
+    }
+    uint64_t calls = ((uint64_t)budget_cycles * CALIBRATION_CALLS) / elapsed_cycles;
+    return (calls > 0) ? (uint32_t)calls : 1;
+}
+/*-----------------------------------------------------------*/
+
+void job_dsp(jobReturn_t* retval, dsp_kernel_t kernel, dsp_variant_t variant, uint32_t calls) {
+    volatile uint32_t sink = 0;
+
+    retval->start = time_us_64();
+
+    for (uint32_t i = 0; i < calls; i++) {
+        sink += dsp_run(kernel, variant);
+    }
+
+    retval->stop = time_us_64();
+    (void)sink;
+}
+/*-----------------------------------------------------------*/
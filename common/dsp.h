@@ -0,0 +1,38 @@
+#ifndef DSP_H
+#define DSP_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "workload.h"
+
+/* Signal-processing workload kernels. The SIMD variant uses the Cortex-M33
+ * DSP extension (dual 16-bit MAC); the portable variant is plain C and is
+ * the only one available where __ARM_FEATURE_DSP is not defined. */
+#define DSP_FIR_TAPS     16   /* Even, so taps pair up for the dual MAC */
+#define DSP_FIR_SAMPLES  64   /* Output samples per call */
+#define DSP_FFT_POINTS   64   /* Radix-2 complex FFT size */
+#define DSP_CRC_BYTES    256  /* Bytes checksummed per call */
+#define DSP_MAT_DIM      8    /* Square matrix dimension (even) */
+
+typedef enum {
+    DSP_FIR,
+    DSP_FFT,
+    DSP_CRC,
+    DSP_MATMUL,
+    DSP_NUM_KERNELS
+} dsp_kernel_t;
+
+typedef enum {
+    DSP_VARIANT_PORTABLE,
+    DSP_VARIANT_SIMD
+} dsp_variant_t;
+
+void dsp_init(void);
+bool dsp_simd_available(void);
+const char* dsp_kernel_name(dsp_kernel_t kernel);
+uint32_t dsp_samples_per_call(dsp_kernel_t kernel);
+uint32_t dsp_run(dsp_kernel_t kernel, dsp_variant_t variant);
+uint32_t dsp_calibrate(dsp_kernel_t kernel, dsp_variant_t variant, uint32_t budget_cycles);
+void job_dsp(jobReturn_t* retval, dsp_kernel_t kernel, dsp_variant_t variant, uint32_t calls);
+
+#endif /* DSP_H */
@@ -0,0 +1,212 @@
+/**
+ * @file fault.c
+ * @brief Timing-fault injection following a scripted or random plan, and
+ *        the log of which scheduler mechanism detected each fault and when.
+ */
+#include <stdio.h>
+#include "bsp.h"
+#include "fault.h"
+#include "fuzz.h"
+
+/* Plan entry with its injection and detection state */
+typedef struct {
+    fault_event_t event;
+    bool injected;
+    bool closed;             /* Detected or masked */
+    bool masked;
+    bool printed;
+    fault_detector_t detector;
+    uint64_t inject_us;
+    uint64_t latency_us;
+} fault_state_t;
+
+static fault_state_t faults[FAULT_MAX_EVENTS];
+static uint32_t num_faults = 0;
+static const char *const *names = NULL;
+static uint8_t (*underlying_switches)(void) = NULL;
+static uint64_t origin_us = 0;
+static bool bounce_high = false;
+
+/* Summary since start */
+static uint32_t injected_total = 0;
+static uint32_t detected_total = 0;
+static uint32_t masked_total = 0;
+static uint64_t latency_max_us = 0;
+
+static const char *kind_names[FAULT_NUM_KINDS] = {
+    "OVERRUN", "LATE_TIMER", "LOST_TICK", "SWITCH_STUCK", "SWITCH_BOUNCE"
+};
+static const char *detector_names[FAULT_NUM_DETECTORS] = { "MISS", "SKIP", "STALL" };
+
+/**
+ * @brief Load a fault plan.
+ *
+ * @param task_names Names indexed by task, used to tag the faults
+ * @param switch_input Switch input outside switch faults (GPIO or generated)
+ */
+void fault_init(const fault_event_t *plan, uint32_t num_events, const char *const *task_names,
+                uint8_t (*switch_input)(void)) {
+    num_faults = (num_events < FAULT_MAX_EVENTS) ? num_events : FAULT_MAX_EVENTS;
+    for (uint32_t i = 0; i < num_faults; i++) {
+        faults[i] = (fault_state_t){ .event = plan[i] };
+    }
+    names = task_names;
+    underlying_switches = switch_input;
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Generate a random plan with the faults spread over a horizon.
+ *
+ * The faults are at least horizon / (num_events + 1) / 2 apart, so each
+ * has time to be detected before the next one.
+ */
+void fault_random_plan(fault_event_t *plan, uint32_t num_events, uint8_t num_tasks,
+                       uint32_t horizon_ms, uint32_t seed) {
+    uint32_t state = (seed != 0) ? seed : 1;
+    uint32_t spacing = horizon_ms / (num_events + 1);
+
+    for (uint32_t i = 0; i < num_events; i++) {
+        fault_event_t *ev = &plan[i];
+        ev->at_ms = (i + 1) * spacing + fuzz_range(&state, 0, spacing / 2);
+        ev->kind = (fault_kind_t)(fuzz_rand(&state) % FAULT_NUM_KINDS);
+        ev->task = (ev->kind == FAULT_OVERRUN) ? (uint8_t)(fuzz_rand(&state) % num_tasks) : FAULT_ANY_TASK;
+        ev->duration_ms = 0;
+
+        switch (ev->kind) {
+        case FAULT_OVERRUN:
+        case FAULT_LATE_TIMER:
+            ev->param = fuzz_range(&state, 500, 4000);
+            break;
+        case FAULT_SWITCH_STUCK:
+        case FAULT_SWITCH_BOUNCE:
+            ev->param = fuzz_range(&state, 0, 255);
+            ev->duration_ms = fuzz_range(&state, 20, 100);
+            break;
+        default:
+            ev->param = 0;
+            break;
+        }
+    }
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Set the instant the plan's at_ms are relative to.
+ */
+void fault_start(uint64_t start_us) {
+    origin_us = start_us;
+}
+/*-----------------------------------------------------------*/
+
+static void mark_injected(fault_state_t *f, uint64_t now_us) {
+    f->injected = true;
+    f->inject_us = now_us;
+    injected_total++;
+}
+
+/**
+ * @brief Take a due fault of a kind at an injection point.
+ *
+ * Each planned fault is injected once, at the first injection point of its
+ * kind (and task) at or after its planned time.
+ *
+ * @param param Filled with the fault parameter
+ * @return true if the caller has to inject the fault now
+ */
+bool fault_pending(fault_kind_t kind, uint8_t task, uint64_t now_us, uint32_t *param) {
+    for (uint32_t i = 0; i < num_faults; i++) {
+        fault_state_t *f = &faults[i];
+        if (!f->injected && f->event.kind == kind &&
+            (f->event.task == FAULT_ANY_TASK || f->event.task == task) &&
+            now_us >= origin_us + (uint64_t)f->event.at_ms * 1000) {
+            mark_injected(f, now_us);
+            *param = f->event.param;
+            return true;
+        }
+    }
+    return false;
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Report a detection: it closes every injected fault still open.
+ */
+void fault_detected(fault_detector_t detector, uint64_t now_us) {
+    for (uint32_t i = 0; i < num_faults; i++) {
+        fault_state_t *f = &faults[i];
+        if (f->injected && !f->closed && now_us >= f->inject_us) {
+            f->closed = true;
+            f->detector = detector;
+            f->latency_us = now_us - f->inject_us;
+            detected_total++;
+            if (f->latency_us > latency_max_us) {
+                latency_max_us = f->latency_us;
+            }
+        }
+    }
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Switch source for workload_set_switch_source(): applies active
+ *        switch faults on top of the underlying input.
+ */
+uint8_t fault_switch_source(void) {
+    uint64_t now = time_us_64();
+
+    for (uint32_t i = 0; i < num_faults; i++) {
+        fault_state_t *f = &faults[i];
+        uint64_t start = origin_us + (uint64_t)f->event.at_ms * 1000;
+        uint64_t end = start + (uint64_t)f->event.duration_ms * 1000;
+
+        if ((f->event.kind != FAULT_SWITCH_STUCK && f->event.kind != FAULT_SWITCH_BOUNCE) ||
+            now < start || now >= end) {
+            continue;
+        }
+        if (!f->injected) {
+            mark_injected(f, now);
+        }
+        if (f->event.kind == FAULT_SWITCH_STUCK) {
+            return (uint8_t)f->event.param;
+        }
+        bounce_high = !bounce_high;  /* Every read sees the other level */
+        return bounce_high ? (uint8_t)f->event.param : (uint8_t)~f->event.param;
+    }
+    return (underlying_switches != NULL) ? underlying_switches() : 0;
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Print the faults closed since the last call and a summary.
+ *
+ * Faults not detected within FAULT_DETECTION_WINDOW_US are closed as masked.
+ */
+void fault_print_log(uint64_t now_us) {
+    for (uint32_t i = 0; i < num_faults; i++) {
+        fault_state_t *f = &faults[i];
+        if (f->injected && !f->closed && now_us - f->inject_us >= FAULT_DETECTION_WINDOW_US) {
+            f->closed = true;
+            f->masked = true;
+            masked_total++;
+        }
+        if (!f->closed || f->printed) {
+            continue;
+        }
+        f->printed = true;
+
+        const char *task = (f->event.task != FAULT_ANY_TASK && names != NULL) ? names[f->event.task] : "-";
+        printf("Fault %-13s %-6s at %llu us (param %u): ", kind_names[f->event.kind], task,
+               f->inject_us - origin_us, f->event.param);
+        if (f->masked) {
+            printf("masked, not detected within %u us\n", FAULT_DETECTION_WINDOW_US);
+        } else {
+            printf("detected by %s after %llu us\n", detector_names[f->detector], f->latency_us);
+        }
+    }
+    if (injected_total > 0) {
+        printf("Faults: injected %u, detected %u (max latency %llu us), masked %u\n",
+               injected_total, detected_total, latency_max_us, masked_total);
+    }
+}
+/*-----------------------------------------------------------*/
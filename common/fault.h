@@ -0,0 +1,47 @@
+#ifndef FAULT_H
+#define FAULT_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define FAULT_MAX_EVENTS 16
+#define FAULT_ANY_TASK UINT8_MAX         /* Event not tied to one task */
+#define FAULT_DETECTION_WINDOW_US 100000 /* Undetected after one hyperperiod: masked */
+
+typedef enum {
+    FAULT_OVERRUN,       /* Job runs param us longer than its workload */
+    FAULT_LATE_TIMER,    /* Dispatch delayed by param us, as a late timer interrupt */
+    FAULT_LOST_TICK,     /* One scheduler tick is lost */
+    FAULT_SWITCH_STUCK,  /* Switches read param for duration_ms */
+    FAULT_SWITCH_BOUNCE, /* Switches alternate between param and its complement for duration_ms */
+    FAULT_NUM_KINDS
+} fault_kind_t;
+
+/* Scheduler mechanism that noticed a fault */
+typedef enum {
+    FAULT_DETECT_MISS,   /* Deadline miss */
+    FAULT_DETECT_SKIP,   /* Admission test skipped a job */
+    FAULT_DETECT_STALL,  /* Dispatch a full period (frame) late */
+    FAULT_NUM_DETECTORS
+} fault_detector_t;
+
+/* Planned fault; at_ms is relative to the scheduler start */
+typedef struct {
+    uint32_t at_ms;
+    fault_kind_t kind;
+    uint8_t task;          /* Task index, or FAULT_ANY_TASK */
+    uint32_t param;
+    uint32_t duration_ms;  /* Switch faults only */
+} fault_event_t;
+
+void fault_init(const fault_event_t *plan, uint32_t num_events, const char *const *task_names,
+                uint8_t (*switch_input)(void));
+void fault_random_plan(fault_event_t *plan, uint32_t num_events, uint8_t num_tasks,
+                       uint32_t horizon_ms, uint32_t seed);
+void fault_start(uint64_t start_us);
+bool fault_pending(fault_kind_t kind, uint8_t task, uint64_t now_us, uint32_t *param);
+void fault_detected(fault_detector_t detector, uint64_t now_us);
+uint8_t fault_switch_source(void);
+void fault_print_log(uint64_t now_us);
+
+#endif /* FAULT_H */
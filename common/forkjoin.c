@@ -0,0 +1,84 @@
+/**
+ * @file forkjoin.c
+ * @brief Fork-join execution of divisible jobs on both RP2350 cores.
+ *
+ * The bare-metal transport uses the inter-core SIO FIFO: core 1 runs a
+ * worker loop that pops a job pointer, executes segment 1 and pushes the
+ * pointer back as the join signal. FreeRTOS builds provide their own
+ * transport on top of fj_run_segment().
+ */
+#include "bsp.h"
+#include "pico/multicore.h"
+#include "forkjoin.h"
+
+/**
+ * @brief Core 1 worker loop: execute the forked segment of each job.
+ */
+static void fj_core1_worker(void) {
+    for (;;) {
+        fj_job_t *job = (fj_job_t *)(uintptr_t)multicore_fifo_pop_blocking();
+
+        for (uint8_t s = 1; s < job->num_segments; s++) {
+            fj_run_segment(job, s);
+        }
+        multicore_fifo_push_blocking((uint32_t)(uintptr_t)job);
+    }
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Start the fork-join worker on core 1 (bare-metal builds only).
+ */
+void fj_core1_init(void) {
+    multicore_launch_core1(fj_core1_worker);
+}
+/*-----------------------------------------------------------*/
+
+void fj_run_segment(fj_job_t *job, uint8_t segment) {
+    job->func(&job->segments[segment], segment, job->num_segments);
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Run a job split over both cores and wait for all segments.
+ *
+ * @param job Job to run; segment timestamps are filled in
+ * @param retval Fork and join times, so the job logs like a sequential one
+ */
+void fj_run(fj_job_t *job, jobReturn_t *retval) {
+    job->fork_time = time_us_64();
+    if (job->num_segments > 1) {
+        multicore_fifo_push_blocking((uint32_t)(uintptr_t)job);
+    }
+
+    fj_run_segment(job, 0);
+
+    if (job->num_segments > 1) {
+        (void)multicore_fifo_pop_blocking();  /* Join */
+    }
+    job->join_time = time_us_64();
+
+    retval->start = job->fork_time;
+    retval->stop = job->join_time;
+}
+/*-----------------------------------------------------------*/
+
+void fj_stats(const fj_job_t *job, fj_stats_t *stats) {
+    uint64_t last_start = job->fork_time;
+    uint64_t last_stop = job->fork_time;
+
+    stats->work_us = 0;
+    for (uint8_t s = 0; s < job->num_segments; s++) {
+        stats->work_us += job->segments[s].stop - job->segments[s].start;
+        if (job->segments[s].start > last_start) {
+            last_start = job->segments[s].start;
+        }
+        if (job->segments[s].stop > last_stop) {
+            last_stop = job->segments[s].stop;
+        }
+    }
+    stats->span_us = job->join_time - job->fork_time;
+    stats->fork_us = last_start - job->fork_time;
+    stats->join_us = job->join_time - last_stop;
+}
+/*-----------------------------------------------------------*/
@@ -0,0 +1,31 @@
+#ifndef FORKJOIN_H
+#define FORKJOIN_H
+
+#include <stdint.h>
+#include "workload.h"
+
+#define FJ_MAX_SEGMENTS 2  /* One segment per RP2350 core */
+
+/* Fork-join job: segment 0 runs on the forking core, the others on core 1 */
+typedef struct {
+    job_segment_t func;                     /* Divisible workload */
+    uint8_t num_segments;                   /* Segments to split the job into */
+    jobReturn_t segments[FJ_MAX_SEGMENTS];  /* Start/stop of each segment */
+    uint64_t fork_time;                     /* Segments handed out */
+    uint64_t join_time;                     /* All segments finished and joined */
+} fj_job_t;
+
+/* Speedup and synchronization overhead of a fork-join job */
+typedef struct {
+    uint64_t span_us;      /* Fork to join */
+    uint64_t work_us;      /* Sum of segment execution times */
+    uint64_t fork_us;      /* Fork to latest segment start */
+    uint64_t join_us;      /* Latest segment stop to join */
+} fj_stats_t;
+
+void fj_core1_init(void);
+void fj_run(fj_job_t *job, jobReturn_t *retval);
+void fj_run_segment(fj_job_t *job, uint8_t segment);
+void fj_stats(const fj_job_t *job, fj_stats_t *stats);
+
+#endif /* FORKJOIN_H */
@@ -0,0 +1,39 @@
+#ifndef FPU_CONTEXT_H
+#define FPU_CONTEXT_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/* Floating-point context of the running thread. The first FP instruction
+ * sets CONTROL.FPCA; from then on every exception entry reserves s0-s15
+ * (stacked lazily) and the FreeRTOS port saves and restores s16-s31 at
+ * each switch of the thread. Threads that never touch the FPU switch
+ * without them. */
+
+#define CONTROL_FPCA (1u << 2)
+
+static inline bool fpu_context_active(void) {
+    uint32_t control;
+    __asm volatile ("mrs %0, control" : "=r" (control));
+    return (control & CONTROL_FPCA) != 0;
+}
+
+/**
+ * @brief Drop the FP context of the calling thread: its switches skip the
+ *        FP registers until it executes an FP instruction again.
+ *
+ * Only call where no FP register holds live data, e.g. between two jobs.
+ *
+ * @return true if there was a context to drop
+ */
+static inline bool fpu_context_release(void) {
+    uint32_t control;
+    __asm volatile ("mrs %0, control" : "=r" (control));
+    if ((control & CONTROL_FPCA) == 0) {
+        return false;
+    }
+    __asm volatile ("msr control, %0\n\tisb" : : "r" (control & ~CONTROL_FPCA) : "memory");
+    return true;
+}
+
+#endif /* FPU_CONTEXT_H */
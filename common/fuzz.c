@@ -0,0 +1,78 @@
+/**
+ * @file fuzz.c
+ * @brief Generated switch inputs for Task_C and reporting of the run-time
+ *        invariants checked by the schedulers.
+ */
+#include <stdio.h>
+#include "fuzz.h"
+
+/* Switch values that exercise the boundaries of Task_C: the wrap at 0, the
+ * shortest jobs, the middle of the range and the longest jobs. */
+static const uint8_t edge_values[] = { 0, 1, 2, 127, 128, 254, 255 };
+#define NUM_EDGE_VALUES (sizeof(edge_values) / sizeof(edge_values[0]))
+
+static uint32_t switch_state = 1;
+static uint8_t switch_value = 0;
+
+void fuzz_init(uint32_t seed) {
+    switch_state = (seed != 0) ? seed : 1;  /* xorshift must not start at 0 */
+    switch_value = 0;
+}
+/*-----------------------------------------------------------*/
+
+uint32_t fuzz_rand(uint32_t *state) {
+    uint32_t x = *state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *state = x;
+    return x;
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Uniform value in [lo, hi]
+ */
+uint32_t fuzz_range(uint32_t *state, uint32_t lo, uint32_t hi) {
+    return lo + fuzz_rand(state) % (hi - lo + 1);
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Draw the switch value of the next Task_C job.
+ *
+ * A quarter of the draws are edge values, the rest uniform, so boundary
+ * cases show up within a few hyperperiods.
+ */
+void fuzz_next_switch(void) {
+    if ((fuzz_rand(&switch_state) & 3) == 0) {
+        switch_value = edge_values[fuzz_rand(&switch_state) % NUM_EDGE_VALUES];
+    } else {
+        switch_value = (uint8_t)fuzz_rand(&switch_state);
+    }
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Switch source for workload_set_switch_source(): the last drawn
+ *        value, so the scheduler's admission test and the job agree.
+ */
+uint8_t fuzz_switch_source(void) {
+    return switch_value;
+}
+/*-----------------------------------------------------------*/
+
+bool fuzz_invariants_hold(const invariants_t *inv) {
+    return inv->early_starts == 0 && inv->dropped_logs == 0 &&
+           inv->miss_mismatches == 0 && inv->stalls == 0 && inv->job_count_mismatches == 0;
+}
+/*-----------------------------------------------------------*/
+
+void fuzz_print_invariants(const invariants_t *inv) {
+    printf("Self-check: %s (early starts %u, dropped logs %u, miss mismatches %u, "
+           "stalls %u, job count mismatches %u, max lateness %llu us)\n",
+           fuzz_invariants_hold(inv) ? "OK" : "VIOLATED", inv->early_starts, inv->dropped_logs,
+           inv->miss_mismatches, inv->stalls, inv->job_count_mismatches,
+           (unsigned long long)inv->max_lateness_us);
+}
+/*-----------------------------------------------------------*/
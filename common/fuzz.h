@@ -0,0 +1,28 @@
+#ifndef FUZZ_H
+#define FUZZ_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/* Property-based self-check: generated inputs plus run-time invariants that
+ * must hold for any input. A seed reproduces the whole input sequence. */
+
+/* Invariant violations observed by a scheduler */
+typedef struct {
+    uint32_t early_starts;      /* Jobs started before their release */
+    uint32_t dropped_logs;      /* Jobs not recorded because the log was full */
+    uint32_t miss_mismatches;   /* Hyperperiods whose miss counter disagrees with the log */
+    uint32_t stalls;            /* Releases served more than a period (frame) late */
+    uint32_t job_count_mismatches; /* Hyperperiods logging another number of jobs than they release */
+    uint64_t max_lateness_us;   /* Largest release-to-dispatch delay */
+} invariants_t;
+
+void fuzz_init(uint32_t seed);
+uint32_t fuzz_rand(uint32_t *state);
+uint32_t fuzz_range(uint32_t *state, uint32_t lo, uint32_t hi);
+void fuzz_next_switch(void);
+uint8_t fuzz_switch_source(void);
+bool fuzz_invariants_hold(const invariants_t *inv);
+void fuzz_print_invariants(const invariants_t *inv);
+
+#endif /* FUZZ_H */
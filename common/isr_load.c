@@ -0,0 +1,284 @@
+/**
+ * @file isr_load.c
+ * @brief Interrupt load accounting: time spent in SysTick and in every
+ *        enabled IRQ, per source and per window, and its sporadic model
+ *        for the response-time analysis.
+ *
+ * The handlers in the RAM vector table are replaced by a trampoline that
+ * reads the cycle counter on entry and exit and calls the original
+ * handler. Nested interrupts are subtracted from the interrupted handler,
+ * so every source is charged its self time only. PendSV and SVCall are
+ * left alone: the FreeRTOS context switch depends on their exception frame.
+ *
+ * The per-source accumulators of both cores are updated and sampled under
+ * a hardware spin lock: the 64-bit busy time cannot be read in one access,
+ * and the sampler on one core resets the counters of the other.
+ */
+#include <stdio.h>
+#include "bsp.h"
+#include "hardware/irq.h"
+#include "hardware/sync.h"
+#include "hardware/structs/scb.h"
+#include "hardware/structs/m33.h"
+#include "pico/platform.h"
+#include "workload.h"
+#include "isr_load.h"
+
+#define ISR_LOAD_NUM_CORES 2
+#define NUM_EXCEPTIONS (16 + NUM_IRQS)
+#define BURST_WINDOW_CYCLES (ISR_LOAD_BURST_WINDOW_US * CYCLES_PER_US)
+
+/* Per core and source, in cycles */
+typedef struct {
+    uint32_t count;
+    uint64_t busy;
+    uint32_t max;
+    uint32_t min_gap;        /* 0 = fewer than two activations */
+    uint32_t last_entry;
+    bool seen;
+} source_cycles_t;
+
+/* Per core state of the trampoline */
+typedef struct {
+    uint32_t depth;
+    uint32_t nested[ISR_LOAD_MAX_NESTING];  /* Cycles to subtract from each level */
+    uint32_t pause_start;
+    uint32_t pause_nested;
+    uint32_t burst_start;
+    uint32_t burst_cycles;
+    uint32_t burst_max;
+    source_cycles_t sources[ISR_LOAD_MAX_SOURCES];
+} core_load_t;
+
+static irq_handler_t original[ISR_LOAD_MAX_SOURCES];
+static uint16_t exception_of[ISR_LOAD_MAX_SOURCES];
+static int8_t slot_of[NUM_EXCEPTIONS];
+static uint8_t num_sources = 0;
+static core_load_t cores[ISR_LOAD_NUM_CORES];
+static uint64_t window_start_us = 0;
+static spin_lock_t *load_lock;  /* Guards cores[].sources of both cores */
+
+static inline uint32_t cycles_now(void) {
+    return m33_hw->dwt_cyccnt;
+}
+
+/**
+ * @brief Vector table entry of every instrumented exception.
+ */
+static void __not_in_flash_func(isr_trampoline)(void) {
+    core_load_t *core = &cores[get_core_num()];
+    int8_t slot = slot_of[__get_current_exception()];
+    uint32_t entry = cycles_now();
+    uint32_t level = core->depth;
+
+    if (level >= ISR_LOAD_MAX_NESTING) {
+        original[slot]();
+        return;
+    }
+    core->depth++;
+    core->nested[level] = 0;
+
+    original[slot]();
+
+    uint32_t total = cycles_now() - entry;
+    uint32_t self = total - core->nested[level];
+    core->depth--;
+
+    source_cycles_t *source = &core->sources[slot];
+    uint32_t save = spin_lock_blocking(load_lock);
+    if (source->seen) {
+        uint32_t gap = entry - source->last_entry;
+        if (source->min_gap == 0 || gap < source->min_gap) {
+            source->min_gap = gap;
+        }
+    }
+    source->last_entry = entry;
+    source->seen = true;
+    source->count++;
+    source->busy += self;
+    if (self > source->max) {
+        source->max = self;
+    }
+    spin_unlock(load_lock, save);
+
+    if (level > 0) {
+        core->nested[level - 1] += total;
+    }
+
+    /* Bursts: interrupt time within a window opened by an activation,
+     * ordered by exit since nested handlers finish first */
+    uint32_t exit = entry + total;
+    if (exit - core->burst_start >= BURST_WINDOW_CYCLES) {
+        core->burst_start = exit;
+        core->burst_cycles = 0;
+    }
+    core->burst_cycles += self;
+    if (core->burst_cycles > core->burst_max) {
+        core->burst_max = core->burst_cycles;
+    }
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Instrument SysTick and every IRQ enabled so far.
+ *
+ * Call after the scheduler has installed its handlers and enabled its
+ * interrupts; IRQs enabled later are not accounted.
+ *
+ * @return Number of instrumented sources
+ */
+uint8_t isr_load_init(void) {
+    irq_handler_t *vectors = (irq_handler_t *)(uintptr_t)scb_hw->vtor;
+
+    m33_hw->demcr |= M33_DEMCR_TRCENA_BITS;
+    m33_hw->dwt_ctrl |= M33_DWT_CTRL_CYCCNTENA_BITS;
+
+    if (load_lock == NULL) {
+        load_lock = spin_lock_instance(spin_lock_claim_unused(true));
+    }
+    for (int e = 0; e < NUM_EXCEPTIONS; e++) {
+        slot_of[e] = -1;
+    }
+    window_start_us = time_us_64();
+
+    for (int e = ISR_LOAD_SYSTICK; e < NUM_EXCEPTIONS && num_sources < ISR_LOAD_MAX_SOURCES; e++) {
+        if (e > ISR_LOAD_SYSTICK && !irq_is_enabled(e - 16)) {
+            continue;
+        }
+        uint32_t save = save_and_disable_interrupts();
+        original[num_sources] = vectors[e];
+        exception_of[num_sources] = (uint16_t)e;
+        slot_of[e] = (int8_t)num_sources;
+        vectors[e] = isr_trampoline;
+        num_sources++;
+        restore_interrupts(save);
+    }
+    return num_sources;
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Stop charging the current handler: application work (a job, a
+ *        report) follows in interrupt context. No-op outside interrupts.
+ */
+void isr_load_pause(void) {
+    core_load_t *core = &cores[get_core_num()];
+
+    if (core->depth > 0 && core->depth <= ISR_LOAD_MAX_NESTING) {
+        core->pause_start = cycles_now();
+        core->pause_nested = core->nested[core->depth - 1];
+    }
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Charge the current handler again after isr_load_pause().
+ */
+void isr_load_resume(void) {
+    core_load_t *core = &cores[get_core_num()];
+
+    if (core->depth > 0 && core->depth <= ISR_LOAD_MAX_NESTING) {
+        uint32_t *nested = &core->nested[core->depth - 1];
+        /* Interrupts nested in the paused work are already in *nested */
+        uint32_t paused = cycles_now() - core->pause_start - (*nested - core->pause_nested);
+        *nested += paused;
+    }
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Interrupt load since the previous sample; starts a new window.
+ */
+void isr_load_sample(isr_load_t *load) {
+    uint64_t now = time_us_64();
+    uint32_t burst_max = 0;
+
+    load->num_sources = num_sources;
+    load->window_us = now - window_start_us;
+    load->busy_us = 0;
+    window_start_us = now;
+
+    for (uint8_t s = 0; s < num_sources; s++) {
+        isr_source_t *out = &load->sources[s];
+        *out = (isr_source_t){ .exception = exception_of[s] };
+
+        for (int c = 0; c < ISR_LOAD_NUM_CORES; c++) {
+            /* A consistent snapshot, also while the other core's handlers run */
+            uint32_t save = spin_lock_blocking(load_lock);
+            source_cycles_t *source = &cores[c].sources[s];
+            uint32_t count = source->count;
+            uint64_t busy = source->busy;
+            uint32_t max = source->max;
+            uint32_t min_gap = source->min_gap;
+            source->count = 0;
+            source->busy = 0;
+            spin_unlock(load_lock, save);
+
+            out->count += count;
+            out->busy_us += busy / CYCLES_PER_US;
+            if (max / CYCLES_PER_US > out->max_us) {
+                out->max_us = max / CYCLES_PER_US;
+            }
+            uint32_t gap = min_gap / CYCLES_PER_US;
+            if (min_gap > 0 && (out->min_interarrival_us == 0 || gap < out->min_interarrival_us)) {
+                out->min_interarrival_us = (gap > 0) ? gap : 1;
+            }
+        }
+        load->busy_us += out->busy_us;
+    }
+
+    for (int c = 0; c < ISR_LOAD_NUM_CORES; c++) {
+        if (cores[c].burst_max > burst_max) {
+            burst_max = cores[c].burst_max;
+        }
+    }
+    load->burst_max_us = burst_max / CYCLES_PER_US;
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Print the interrupt load of a window, one line per source.
+ */
+void isr_load_print(const isr_load_t *load) {
+    uint64_t load_x100 = (load->window_us > 0) ? (load->busy_us * 10000) / load->window_us : 0;
+
+    printf("Interrupt load: %llu us of %llu us (%llu.%02llu%%), worst burst %u us in %u us\n",
+           load->busy_us, load->window_us, load_x100 / 100, load_x100 % 100,
+           load->burst_max_us, ISR_LOAD_BURST_WINDOW_US);
+    for (uint8_t s = 0; s < load->num_sources; s++) {
+        const isr_source_t *source = &load->sources[s];
+        if (source->exception == ISR_LOAD_SYSTICK) {
+            printf("  SysTick  ");
+        } else {
+            printf("  IRQ %-5u", source->exception - 16);
+        }
+        printf(": %5u activations, %6llu us, max %4u us, min gap %6u us\n",
+               source->count, source->busy_us, source->max_us, source->min_interarrival_us);
+    }
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Sporadic model of the observed interrupt sources.
+ *
+ * Worst activation and shortest gap since start; a source seen only once
+ * is assumed to fire at most once per window.
+ *
+ * @return Number of entries written to irqs
+ */
+uint8_t isr_load_model(const isr_load_t *load, rta_irq_t *irqs, uint8_t max_irqs) {
+    uint8_t n = 0;
+
+    for (uint8_t s = 0; s < load->num_sources && n < max_irqs; s++) {
+        const isr_source_t *source = &load->sources[s];
+        if (source->max_us == 0 && source->count == 0) {
+            continue;
+        }
+        irqs[n].wcet_us = (source->max_us > 0) ? source->max_us : 1;
+        irqs[n].min_interarrival_us = (source->min_interarrival_us > 0) ?
+                                      source->min_interarrival_us : (uint32_t)load->window_us;
+        n++;
+    }
+    return n;
+}
+/*-----------------------------------------------------------*/
@@ -0,0 +1,39 @@
+#ifndef ISR_LOAD_H
+#define ISR_LOAD_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "rta.h"
+
+#define ISR_LOAD_MAX_SOURCES 8        /* SysTick plus the enabled IRQs */
+#define ISR_LOAD_MAX_NESTING 8        /* Nested interrupt levels per core */
+#define ISR_LOAD_BURST_WINDOW_US 1000 /* Window of the worst-case burst */
+#define ISR_LOAD_SYSTICK 15           /* Exception number of SysTick; IRQ n is 16 + n */
+
+/* One interrupt source. Times are self times: nested interrupts and
+ * application work paused with isr_load_pause() are not counted. */
+typedef struct {
+    uint16_t exception;           /* Exception number */
+    uint32_t count;               /* Activations in the window */
+    uint64_t busy_us;             /* Time in the window */
+    uint32_t max_us;              /* Longest activation since start */
+    uint32_t min_interarrival_us; /* Shortest gap between activations since start, 0 = one so far */
+} isr_source_t;
+
+/* Interrupt load of a window, from one isr_load_sample() to the next */
+typedef struct {
+    isr_source_t sources[ISR_LOAD_MAX_SOURCES];
+    uint8_t num_sources;
+    uint64_t window_us;
+    uint64_t busy_us;
+    uint32_t burst_max_us;        /* Worst interrupt time in ISR_LOAD_BURST_WINDOW_US since start */
+} isr_load_t;
+
+uint8_t isr_load_init(void);
+void isr_load_pause(void);
+void isr_load_resume(void);
+void isr_load_sample(isr_load_t *load);
+void isr_load_print(const isr_load_t *load);
+uint8_t isr_load_model(const isr_load_t *load, rta_irq_t *irqs, uint8_t max_irqs);
+
+#endif /* ISR_LOAD_H */
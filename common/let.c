@@ -0,0 +1,151 @@
+/**
+ * @file let.c
+ * @brief Logical Execution Time (LET) channels shared by the cyclic
+ *        executive and the FreeRTOS periodic tasks.
+ *
+ * The 64-bit stamps cannot be read or written in one access, and the
+ * reader may run on the other core or preempt the writer. Each buffer
+ * therefore has a sequence counter the single writer makes odd when it takes
+ * the buffer and even again once the stamp is set. A reader that sees an odd
+ * counter treats the buffer as not yet published instead of waiting for it,
+ * and re-reads only when the counter moved under it, i.e. when the writer
+ * progressed: no lock, and no reader can stall behind a preempted writer.
+ */
+#include "hardware/sync.h"
+#include "let.h"
+
+#define LET_NEVER UINT64_MAX  /* Stamp of a buffer that is not (yet) visible */
+
+/* Token handed to chained tasks before their producer published anything. */
+static const let_token_t let_empty_token = { .seq = 0, .origin_us = 0 };
+
+/**
+ * @brief Initialize a channel on caller-provided storage.
+ *
+ * @param ch Channel to initialize
+ * @param storage LET_NUM_BUFFERS consecutive payloads of size bytes each
+ * @param size Payload size in bytes
+ */
+void let_init(let_channel_t *ch, void *storage, size_t size) {
+    for (uint32_t i = 0; i < LET_NUM_BUFFERS; i++) {
+        ch->buffers[i] = (uint8_t *)storage + (i * size);
+        ch->valid_from[i] = LET_NEVER;
+        ch->seq[i] = 0;
+    }
+    ch->size = size;
+    ch->latest = LET_NUM_BUFFERS - 1;  /* First commit goes to buffer 0 */
+    ch->published = 0;
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Read the stamp of one buffer.
+ *
+ * @param stamp Set to the buffer's stamp, LET_NEVER while the writer owns it
+ * @return false if the writer changed the buffer during the read
+ */
+static bool let_read_stamp(const let_channel_t *ch, uint32_t idx, uint64_t *stamp) {
+    uint32_t seq = ch->seq[idx];
+
+    if (seq & 1) {
+        *stamp = LET_NEVER;
+        return true;
+    }
+    __dmb();
+    *stamp = ch->valid_from[idx];
+    __dmb();
+    return ch->seq[idx] == seq;
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Sample a channel at a job release.
+ *
+ * @param ch Channel to read
+ * @param release_us Logical release time of the reading job
+ * @return Newest payload published at or before the release, NULL if none
+ */
+const void *let_sample(const let_channel_t *ch, uint64_t release_us) {
+    for (;;) {
+        uint32_t idx = ch->latest;
+        uint64_t stamp;
+
+        __dmb();
+        if (!let_read_stamp(ch, idx, &stamp)) {
+            continue;
+        }
+        /* Newest commit belongs to a later deadline: fall back to the one before */
+        if (stamp > release_us) {
+            idx = (idx + LET_NUM_BUFFERS - 1) % LET_NUM_BUFFERS;
+            if (!let_read_stamp(ch, idx, &stamp)) {
+                continue;
+            }
+        }
+        return (stamp <= release_us) ? ch->buffers[idx] : NULL;
+    }
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Get the buffer the writer fills during its job (zero copy).
+ *
+ * The buffer is neither the newest nor the previous commit, and its odd
+ * counter hides it from readers that picked it up before it was rotated.
+ */
+void *let_write_buffer(let_channel_t *ch) {
+    uint32_t next = (ch->latest + 1) % LET_NUM_BUFFERS;
+
+    ch->seq[next]++;
+    __dmb();
+    return ch->buffers[next];
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Commit the write buffer, visible from the job's logical deadline.
+ *
+ * @param ch Channel to publish on
+ * @param deadline_us Absolute deadline of the writing job
+ */
+void let_publish(let_channel_t *ch, uint64_t deadline_us) {
+    uint32_t next = (ch->latest + 1) % LET_NUM_BUFFERS;
+
+    /* Payload and stamp are visible before the counter turns even, and the
+     * counter before the index flips */
+    ch->valid_from[next] = deadline_us;
+    __dmb();
+    ch->seq[next]++;
+    __dmb();
+    ch->latest = next;
+    ch->published++;
+}
+/*-----------------------------------------------------------*/
+
+const let_token_t *let_token_sample(const let_channel_t *in, uint64_t release_us) {
+    if (in == NULL) {
+        return NULL;  /* Head of a chain */
+    }
+
+    const let_token_t *token = let_sample(in, release_us);
+    return (token != NULL) ? token : &let_empty_token;
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Publish the token of a finished job.
+ *
+ * Heads of a chain (no input token) become the origin of the data; chained
+ * tasks forward the origin of the token they sampled at release.
+ */
+void let_token_publish(let_channel_t *out, const let_token_t *in_token,
+                       uint32_t seq, uint64_t release_us, uint64_t deadline_us) {
+    if (out == NULL) {
+        return;
+    }
+
+    let_token_t *token = let_write_buffer(out);
+    token->seq = seq;
+    token->origin_us = (in_token != NULL) ? in_token->origin_us : release_us;
+    let_publish(out, deadline_us);
+}
+/*-----------------------------------------------------------*/
@@ -0,0 +1,49 @@
+#ifndef LET_H
+#define LET_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+/* Logical Execution Time (LET) communication.
+ *
+ * A job samples its inputs at its release and publishes its outputs at its
+ * deadline, so the data a job sees only depends on the release/deadline
+ * instants and never on when the jobs actually ran. Channels are single
+ * writer / multiple reader. The writer fills a buffer in place (zero copy)
+ * and commits it stamped with its logical deadline; a reader selects the
+ * newest buffer whose stamp is not after its own release. No lock is taken:
+ * each buffer carries a sequence counter that is odd while the writer owns
+ * it, and a reader retries only when the writer made progress (see let.c).
+ *
+ * Three buffers are rotated: the newest committed one, the one before it
+ * (still visible to readers released before the newest deadline) and the one
+ * being written. A pointer returned by let_sample() therefore stays valid for
+ * at least one writer period after the reader's release. */
+#define LET_NUM_BUFFERS 3
+
+typedef struct {
+    void *buffers[LET_NUM_BUFFERS];                 /* Caller-provided payload storage */
+    size_t size;                                    /* Payload size in bytes */
+    volatile uint64_t valid_from[LET_NUM_BUFFERS];  /* Logical publication instant (us), read under seq */
+    volatile uint32_t seq[LET_NUM_BUFFERS];         /* Odd while the writer owns the buffer */
+    volatile uint32_t latest;                       /* Index of newest committed buffer */
+    uint32_t published;                             /* Number of commits */
+} let_channel_t;
+
+/* Token carried by the periodic tasks: identifies the producing job and the
+ * release of the job at the head of the chain the data originates from. */
+typedef struct {
+    uint32_t seq;        /* Job index of the producer */
+    uint64_t origin_us;  /* Release time of the originating (sensor) job */
+} let_token_t;
+
+void let_init(let_channel_t *ch, void *storage, size_t size);
+const void *let_sample(const let_channel_t *ch, uint64_t release_us);
+void *let_write_buffer(let_channel_t *ch);
+void let_publish(let_channel_t *ch, uint64_t deadline_us);
+
+const let_token_t *let_token_sample(const let_channel_t *in, uint64_t release_us);
+void let_token_publish(let_channel_t *out, const let_token_t *in_token,
+                       uint32_t seq, uint64_t release_us, uint64_t deadline_us);
+
+#endif /* LET_H */
@@ -0,0 +1,130 @@
+/**
+ * @file overload.c
+ * @brief Sliding-window demand estimates and the overload early warning.
+ *
+ * The estimator takes the largest execution time in each task's window:
+ * a single long job keeps the estimate up for a whole window, so the
+ * warning does not flicker with the workload. The state is not locked;
+ * the caller serializes recording and prediction.
+ */
+#include <stdio.h>
+#include "overload.h"
+
+/**
+ * @brief Reset the estimator.
+ *
+ * @param window Jobs per task in the window, at most OVERLOAD_MAX_WINDOW
+ * @param threshold_us Headroom below which the warning is raised
+ */
+void overload_init(overload_t *ov, uint8_t num_tasks, uint8_t window, int32_t threshold_us) {
+    *ov = (overload_t){0};
+    ov->num_tasks = (num_tasks < OVERLOAD_MAX_TASKS) ? num_tasks : OVERLOAD_MAX_TASKS;
+    ov->window = (window < 1) ? 1 : ((window < OVERLOAD_MAX_WINDOW) ? window : OVERLOAD_MAX_WINDOW);
+    ov->threshold_us = threshold_us;
+    ov->headroom_min_us = INT32_MAX;
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Add the execution time of a completed job to its task's window.
+ */
+void overload_record(overload_t *ov, uint8_t task, uint32_t exec_us) {
+    if (task >= ov->num_tasks) {
+        return;
+    }
+    overload_task_t *t = &ov->tasks[task];
+    t->exec_us[t->next] = exec_us;
+    t->next = (uint8_t)((t->next + 1) % ov->window);
+    if (t->count < ov->window) {
+        t->count++;
+    }
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Announce the execution time of a task's next jobs.
+ *
+ * Replaces the measured window until the next forecast, for a task whose
+ * demand is set from outside (Task_C by the switches) and may drop as
+ * well as rise.
+ */
+void overload_forecast(overload_t *ov, uint8_t task, uint32_t exec_us) {
+    if (task >= ov->num_tasks) {
+        return;
+    }
+    ov->tasks[task].forecast = true;
+    ov->tasks[task].forecast_us = exec_us;
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Estimated execution time of a task's next job: the forecast, or
+ *        the largest in its window (0 before its first job).
+ */
+uint32_t overload_demand_us(const overload_t *ov, uint8_t task) {
+    if (task >= ov->num_tasks) {
+        return 0;
+    }
+    const overload_task_t *t = &ov->tasks[task];
+    if (t->forecast) {
+        return t->forecast_us;
+    }
+    uint32_t demand = 0;
+    for (uint8_t i = 0; i < t->count; i++) {
+        if (t->exec_us[i] > demand) {
+            demand = t->exec_us[i];
+        }
+    }
+    return demand;
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Take the scheduler's predicted headroom and update the warning.
+ *
+ * @param headroom_us Time left in the tightest window with every task at
+ *        its estimate; negative predicts a miss
+ * @return true if the warning was raised by this prediction
+ */
+bool overload_predict(overload_t *ov, int32_t headroom_us, uint64_t now_us) {
+    bool was_warning = ov->warning;
+
+    ov->predictions++;
+    ov->headroom_us = headroom_us;
+    if (headroom_us < ov->headroom_min_us) {
+        ov->headroom_min_us = headroom_us;
+    }
+    if (headroom_us < 0) {
+        ov->predicted_misses++;
+    }
+    ov->warning = headroom_us < ov->threshold_us;
+    if (!ov->warning || was_warning) {
+        return false;
+    }
+
+    ov->warnings++;
+    ov->warning_headroom_us = headroom_us;
+    ov->warning_us = now_us;
+    return true;
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Print the estimates and the warning state.
+ */
+void overload_print(const overload_t *ov) {
+    printf("Overload estimate (window %u jobs):", ov->window);
+    for (uint8_t t = 0; t < ov->num_tasks; t++) {
+        printf(" %u%s", overload_demand_us(ov, t), ov->tasks[t].forecast ? "*" : "");
+    }
+    printf(" us (* forecast)\n");
+    if (ov->predictions == 0) {
+        printf("Overload headroom: no prediction yet\n");
+        return;
+    }
+    printf("Overload headroom: last %ld us, min %ld us, warn below %ld us; %u warning(s), "
+           "%u predicted miss(es)%s\n", (long)ov->headroom_us, (long)ov->headroom_min_us,
+           (long)ov->threshold_us, ov->warnings, ov->predicted_misses,
+           ov->warning ? " - WARNING ACTIVE" : "");
+}
+/*-----------------------------------------------------------*/
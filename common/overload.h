@@ -0,0 +1,48 @@
+#ifndef OVERLOAD_H
+#define OVERLOAD_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/* Online overload prediction. The execution times of the last jobs of each
+ * task form a sliding window whose maximum is the task's demand estimate;
+ * a task whose next execution time is known in advance (Task_C from the
+ * switches) is forecast instead. The scheduler turns the estimates into
+ * the headroom of its tightest window, and the predictor raises an early
+ * warning while that headroom is below the threshold, before the miss. */
+
+#define OVERLOAD_MAX_TASKS 8
+#define OVERLOAD_MAX_WINDOW 32  /* Jobs per task in the window */
+
+/* Execution times of the last jobs of one task */
+typedef struct {
+    uint32_t exec_us[OVERLOAD_MAX_WINDOW];
+    uint8_t next;
+    uint8_t count;
+    bool forecast;               /* forecast_us replaces the window */
+    uint32_t forecast_us;
+} overload_task_t;
+
+typedef struct {
+    overload_task_t tasks[OVERLOAD_MAX_TASKS];
+    uint8_t num_tasks;
+    uint8_t window;
+    int32_t threshold_us;        /* Warn while the headroom is below this */
+    bool warning;                /* Raised at the last prediction */
+    int32_t headroom_us;         /* Last prediction */
+    int32_t headroom_min_us;     /* Lowest prediction since start */
+    uint32_t predictions;
+    uint32_t warnings;           /* Times the warning was raised */
+    uint32_t predicted_misses;   /* Predictions with negative headroom */
+    int32_t warning_headroom_us; /* At the last warning */
+    uint64_t warning_us;         /* Time of the last warning */
+} overload_t;
+
+void overload_init(overload_t *ov, uint8_t num_tasks, uint8_t window, int32_t threshold_us);
+void overload_record(overload_t *ov, uint8_t task, uint32_t exec_us);
+void overload_forecast(overload_t *ov, uint8_t task, uint32_t exec_us);
+uint32_t overload_demand_us(const overload_t *ov, uint8_t task);
+bool overload_predict(overload_t *ov, int32_t headroom_us, uint64_t now_us);
+void overload_print(const overload_t *ov);
+
+#endif /* OVERLOAD_H */
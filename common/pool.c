@@ -0,0 +1,169 @@
+/**
+ * @file pool.c
+ * @brief Fixed-block pool allocator for payloads and trace buffers.
+ *
+ * Every size class is a static array of equal blocks; free blocks are
+ * linked through their first word. Allocation pops and free pushes, under
+ * a hardware spin lock with interrupts disabled, so both are constant time
+ * and safe from interrupts and from the other core. The class of a freed
+ * block follows from its address. Blocks are 8-byte aligned.
+ */
+#include <stdio.h>
+#include "hardware/sync.h"
+#include "pool.h"
+
+/* Blocks per class; storage is 11 KB */
+#define POOL_BLOCKS_16  64
+#define POOL_BLOCKS_32  64
+#define POOL_BLOCKS_64  32
+#define POOL_BLOCKS_128 16
+#define POOL_BLOCKS_256 16
+
+typedef struct pool_block {
+    struct pool_block *next;
+} pool_block_t;
+
+typedef struct {
+    uint16_t block_size;
+    uint16_t num_blocks;
+    uint8_t *storage;
+    pool_block_t *free_list;
+    pool_stats_t stats;
+} pool_class_t;
+
+static uint8_t storage_16[16 * POOL_BLOCKS_16] __attribute__((aligned(8)));
+static uint8_t storage_32[32 * POOL_BLOCKS_32] __attribute__((aligned(8)));
+static uint8_t storage_64[64 * POOL_BLOCKS_64] __attribute__((aligned(8)));
+static uint8_t storage_128[128 * POOL_BLOCKS_128] __attribute__((aligned(8)));
+static uint8_t storage_256[256 * POOL_BLOCKS_256] __attribute__((aligned(8)));
+
+/* Ascending block sizes */
+static pool_class_t classes[POOL_NUM_CLASSES] = {
+    { .block_size = 16,  .num_blocks = POOL_BLOCKS_16,  .storage = storage_16 },
+    { .block_size = 32,  .num_blocks = POOL_BLOCKS_32,  .storage = storage_32 },
+    { .block_size = 64,  .num_blocks = POOL_BLOCKS_64,  .storage = storage_64 },
+    { .block_size = 128, .num_blocks = POOL_BLOCKS_128, .storage = storage_128 },
+    { .block_size = 256, .num_blocks = POOL_BLOCKS_256, .storage = storage_256 },
+};
+
+static spin_lock_t *pool_lock;
+
+/**
+ * @brief Link all blocks into their free lists. Call once before use.
+ */
+void pool_init(void) {
+    pool_lock = spin_lock_instance(spin_lock_claim_unused(true));
+
+    for (uint8_t c = 0; c < POOL_NUM_CLASSES; c++) {
+        pool_class_t *cls = &classes[c];
+        cls->free_list = NULL;
+        for (int b = cls->num_blocks - 1; b >= 0; b--) {
+            pool_block_t *block = (pool_block_t *)&cls->storage[b * cls->block_size];
+            block->next = cls->free_list;
+            cls->free_list = block;
+        }
+        cls->stats = (pool_stats_t){ .block_size = cls->block_size, .num_blocks = cls->num_blocks };
+    }
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Allocate a block of at least size bytes.
+ *
+ * @return Block, NULL if size exceeds POOL_MAX_BLOCK or all fitting
+ *         classes are empty
+ */
+void *pool_alloc(size_t size) {
+    pool_block_t *block = NULL;
+    uint8_t first = 0;
+
+    while (first < POOL_NUM_CLASSES && classes[first].block_size < size) {
+        first++;
+    }
+    if (first == POOL_NUM_CLASSES) {
+        return NULL;
+    }
+
+    uint32_t save = spin_lock_blocking(pool_lock);
+    uint8_t c = first;
+    while (c < POOL_NUM_CLASSES && classes[c].free_list == NULL) {
+        c++;
+    }
+    /* Fallbacks and failures are charged to the class the request belongs to */
+    if (c == POOL_NUM_CLASSES) {
+        classes[first].stats.failures++;
+    } else {
+        pool_class_t *cls = &classes[c];
+        block = cls->free_list;
+        cls->free_list = block->next;
+        if (++cls->stats.in_use > cls->stats.high_water) {
+            cls->stats.high_water = cls->stats.in_use;
+        }
+        if (c != first) {
+            classes[first].stats.fallbacks++;
+        }
+    }
+    spin_unlock(pool_lock, save);
+    return block;
+}
+/*-----------------------------------------------------------*/
+
+static pool_class_t *class_of(const void *block) {
+    const uint8_t *p = block;
+
+    for (uint8_t c = 0; c < POOL_NUM_CLASSES; c++) {
+        pool_class_t *cls = &classes[c];
+        if (p >= cls->storage && p < cls->storage + (size_t)cls->block_size * cls->num_blocks) {
+            return cls;
+        }
+    }
+    return NULL;
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Return a block; NULL and pointers outside the pool are ignored.
+ */
+void pool_free(void *block) {
+    pool_class_t *cls = class_of(block);
+
+    if (cls == NULL) {
+        return;
+    }
+    uint32_t save = spin_lock_blocking(pool_lock);
+    ((pool_block_t *)block)->next = cls->free_list;
+    cls->free_list = block;
+    cls->stats.in_use--;
+    spin_unlock(pool_lock, save);
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Usable size of a block, 0 outside the pool.
+ */
+size_t pool_block_size(const void *block) {
+    pool_class_t *cls = class_of(block);
+    return (cls != NULL) ? cls->block_size : 0;
+}
+/*-----------------------------------------------------------*/
+
+void pool_get_stats(uint8_t cls, pool_stats_t *stats) {
+    uint32_t save = spin_lock_blocking(pool_lock);
+    *stats = classes[cls].stats;
+    spin_unlock(pool_lock, save);
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Print the occupancy of every size class.
+ */
+void pool_print(void) {
+    printf("Pool: block | in use | high water | fallbacks | failures\n");
+    for (uint8_t c = 0; c < POOL_NUM_CLASSES; c++) {
+        pool_stats_t stats;
+        pool_get_stats(c, &stats);
+        printf("      %5u | %3u/%-3u| %10u | %9u | %8u\n", stats.block_size, stats.in_use,
+               stats.num_blocks, stats.high_water, stats.fallbacks, stats.failures);
+    }
+}
+/*-----------------------------------------------------------*/
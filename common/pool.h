@@ -0,0 +1,33 @@
+#ifndef POOL_H
+#define POOL_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+/* Fixed-block pool allocator: one free list per size class, constant-time
+ * allocation and free from tasks, interrupts and either core. A request
+ * takes the smallest class that fits and falls back to larger classes
+ * when it is empty. */
+
+#define POOL_NUM_CLASSES 5
+#define POOL_MAX_BLOCK 256    /* Largest request served */
+
+/* Occupancy of one size class */
+typedef struct {
+    uint16_t block_size;
+    uint16_t num_blocks;
+    uint16_t in_use;
+    uint16_t high_water;      /* Most blocks in use at once */
+    uint32_t fallbacks;       /* Requests of this class served by a larger one */
+    uint32_t failures;        /* Requests of this class with every fitting class empty */
+} pool_stats_t;
+
+void pool_init(void);
+void *pool_alloc(size_t size);
+void pool_free(void *block);
+size_t pool_block_size(const void *block);
+void pool_get_stats(uint8_t cls, pool_stats_t *stats);
+void pool_print(void);
+
+#endif /* POOL_H */
@@ -0,0 +1,17 @@
+#ifndef PWCET_BUDGETS_H
+#define PWCET_BUDGETS_H
+
+/* Execution time budgets per task (us), used with USE_PWCET_BUDGETS.
+ * These are the nominal EXECUTION_TIME_* budgets; replace this file with
+ * the estimates of captured runs:
+ *   trace_analyzer -W -q 1e-9 -o ../common/pwcet_budgets.h capture... */
+#define PWCET_EXCEEDANCE 0
+
+#define PWCET_BUDGET_US_TASK_A 1000
+#define PWCET_BUDGET_US_TASK_B 1000
+#define PWCET_BUDGET_US_TASK_C 2000
+#define PWCET_BUDGET_US_TASK_D 2000
+#define PWCET_BUDGET_US_TASK_E 4000
+#define PWCET_BUDGET_US_TASK_F 2000
+
+#endif /* PWCET_BUDGETS_H */
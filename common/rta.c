@@ -0,0 +1,406 @@
+/**
+ * @file rta.c
+ * @brief Fixed-priority response-time analysis, partitioning of a task set
+ *        over the two cores, semi-partitioning by splitting tasks and
+ *        compositional analysis of a partition served by a periodic resource.
+ */
+#include <stddef.h>
+#include "rta.h"
+
+/* Task set assigned to one core (whole tasks and portions) */
+typedef struct {
+    rta_task_t tasks[RTA_MAX_TASKS];
+    uint8_t count;
+} core_set_t;
+
+/**
+ * @brief Worst-case response time of task i, measured from its release.
+ *
+ * Classic recurrence R = C_i + sum_{j in hp(i)} ceil((R + J_j) / T_j) * C_j,
+ * where tasks of equal priority are counted as interfering.
+ *
+ * @return Response time including the task's own jitter, or RTA_UNSCHEDULABLE
+ */
+uint32_t rta_response_time(const rta_task_t *tasks, uint8_t num_tasks, uint8_t i) {
+    return rta_response_time_irq(tasks, num_tasks, i, NULL, 0);
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Worst-case time interrupts can take from a window of window_us.
+ *
+ * Each source fires at most ceil(window / min inter-arrival) times.
+ */
+uint64_t rta_irq_interference(const rta_irq_t *irqs, uint8_t num_irqs, uint64_t window_us) {
+    uint64_t interference = 0;
+
+    for (uint8_t k = 0; k < num_irqs; k++) {
+        uint64_t gap = (irqs[k].min_interarrival_us > 0) ? irqs[k].min_interarrival_us : 1;
+        interference += ((window_us + gap - 1) / gap) * irqs[k].wcet_us;
+    }
+    return interference;
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Response time of task i with interrupt interference.
+ *
+ * The recurrence of rta_response_time() plus rta_irq_interference(R): the
+ * interrupt handlers preempt every task.
+ */
+uint32_t rta_response_time_irq(const rta_task_t *tasks, uint8_t num_tasks, uint8_t i,
+                               const rta_irq_t *irqs, uint8_t num_irqs) {
+    uint64_t response = tasks[i].wcet_us;
+
+    for (;;) {
+        uint64_t next = tasks[i].wcet_us + rta_irq_interference(irqs, num_irqs, response);
+        for (uint8_t j = 0; j < num_tasks; j++) {
+            if (j != i && tasks[j].priority >= tasks[i].priority) {
+                uint64_t releases = (response + tasks[j].jitter_us + tasks[j].period_us - 1) /
+                                    tasks[j].period_us;
+                next += releases * tasks[j].wcet_us;
+            }
+        }
+        if (next + tasks[i].jitter_us > tasks[i].deadline_us) {
+            return RTA_UNSCHEDULABLE;
+        }
+        if (next == response) {
+            return (uint32_t)(response + tasks[i].jitter_us);
+        }
+        response = next;
+    }
+}
+/*-----------------------------------------------------------*/
+
+bool rta_schedulable(const rta_task_t *tasks, uint8_t num_tasks) {
+    for (uint8_t i = 0; i < num_tasks; i++) {
+        if (rta_response_time(tasks, num_tasks, i) == RTA_UNSCHEDULABLE) {
+            return false;
+        }
+    }
+    return true;
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Time needed to receive `demand` us from a periodic resource (Pi, Theta).
+ *
+ * Inverse of the supply bound function of the periodic resource model: in
+ * the worst case the budget is supplied at the start of one period and at
+ * the end of the next, a blackout of 2 * (Pi - Theta), and then Theta every Pi.
+ */
+static uint64_t supply_time(uint64_t demand, uint32_t resource_period_us, uint32_t resource_budget_us) {
+    if (demand == 0) {
+        return 0;
+    }
+    uint64_t full_periods = (demand - 1) / resource_budget_us;
+    uint64_t rest = demand - full_periods * resource_budget_us;
+    return 2 * (uint64_t)(resource_period_us - resource_budget_us) +
+           full_periods * resource_period_us + rest;
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Worst-case response time of task i inside a periodic resource.
+ *
+ * Compositional analysis of a partition that only receives resource_budget_us
+ * every resource_period_us: the demand of the recurrence in rta_response_time()
+ * is served by the resource's supply bound instead of a dedicated processor.
+ *
+ * @return Response time including the task's own jitter, or RTA_UNSCHEDULABLE
+ */
+uint32_t rta_response_time_supply(const rta_task_t *tasks, uint8_t num_tasks, uint8_t i,
+                                  uint32_t resource_period_us, uint32_t resource_budget_us) {
+    if (resource_budget_us == 0 || resource_budget_us > resource_period_us) {
+        return RTA_UNSCHEDULABLE;
+    }
+
+    uint64_t response = supply_time(tasks[i].wcet_us, resource_period_us, resource_budget_us);
+
+    for (;;) {
+        uint64_t demand = tasks[i].wcet_us;
+        for (uint8_t j = 0; j < num_tasks; j++) {
+            if (j != i && tasks[j].priority >= tasks[i].priority) {
+                uint64_t releases = (response + tasks[j].jitter_us + tasks[j].period_us - 1) /
+                                    tasks[j].period_us;
+                demand += releases * tasks[j].wcet_us;
+            }
+        }
+        uint64_t next = supply_time(demand, resource_period_us, resource_budget_us);
+        if (next + tasks[i].jitter_us > tasks[i].deadline_us) {
+            return RTA_UNSCHEDULABLE;
+        }
+        if (next == response) {
+            return (uint32_t)(response + tasks[i].jitter_us);
+        }
+        response = next;
+    }
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Smallest budget per resource period that keeps a partition schedulable.
+ *
+ * @return Budget in us, or RTA_UNSCHEDULABLE if even the full period is not enough
+ */
+uint32_t rta_min_supply_budget(const rta_task_t *tasks, uint8_t num_tasks, uint32_t resource_period_us) {
+    uint32_t low = 1;
+    uint32_t high = resource_period_us;
+    uint32_t budget = RTA_UNSCHEDULABLE;
+
+    /* Schedulability is monotone in the budget */
+    while (low <= high) {
+        uint32_t mid = low + (high - low) / 2;
+        bool ok = true;
+        for (uint8_t i = 0; i < num_tasks && ok; i++) {
+            ok = rta_response_time_supply(tasks, num_tasks, i, resource_period_us, mid) != RTA_UNSCHEDULABLE;
+        }
+        if (ok) {
+            budget = mid;
+            high = mid - 1;
+        } else {
+            low = mid + 1;
+        }
+    }
+    return budget;
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Try to add a task to a core; keeps it only if the core stays schedulable.
+ */
+static bool core_try_add(core_set_t *core, const rta_task_t *task) {
+    if (core->count >= RTA_MAX_TASKS) {
+        return false;
+    }
+    core->tasks[core->count++] = *task;
+    if (!rta_schedulable(core->tasks, core->count)) {
+        core->count--;
+        return false;
+    }
+    return true;
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Split a task: largest first-portion budget on `first`, rest on `second`.
+ *
+ * As in highest-priority task splitting, the first portion runs at the
+ * highest priority on its core, so it completes within its budget. The second
+ * portion keeps the task's priority and is released when the first completes,
+ * which is modeled as release jitter equal to the first portion's response time.
+ */
+static uint32_t core_try_split(core_set_t *first, core_set_t *second, const rta_task_t *task) {
+    uint32_t low = 1;
+    uint32_t high = task->wcet_us - 1;
+    uint32_t budget = 0;
+    rta_task_t portion = *task;
+
+    portion.priority = RTA_SPLIT_PRIORITY;
+
+    if (task->wcet_us < 2 || first->count >= RTA_MAX_TASKS) {
+        return 0;
+    }
+
+    /* Schedulability of the first core is monotone in the budget */
+    while (low <= high) {
+        uint32_t mid = low + (high - low) / 2;
+        portion.wcet_us = mid;
+        first->tasks[first->count] = portion;
+        if (rta_schedulable(first->tasks, first->count + 1)) {
+            budget = mid;
+            low = mid + 1;
+        } else {
+            high = mid - 1;
+        }
+    }
+    if (budget == 0) {
+        return 0;
+    }
+
+    portion.wcet_us = budget;
+    first->tasks[first->count++] = portion;
+    uint32_t first_response = rta_response_time(first->tasks, first->count, first->count - 1);
+
+    rta_task_t rest = *task;
+    rest.wcet_us = task->wcet_us - budget;
+    rest.jitter_us = first_response;
+    if (!core_try_add(second, &rest)) {
+        first->count--;
+        return 0;
+    }
+    return budget;
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Place a task on the first core it fits on (no splitting).
+ */
+static bool place_whole(core_set_t *cores, const rta_task_t *task, rta_assignment_t *assignment) {
+    for (uint8_t c = 0; c < RTA_NUM_CORES; c++) {
+        if (core_try_add(&cores[c], task)) {
+            assignment->core = c;
+            assignment->split_core = c;
+            return true;
+        }
+    }
+    return false;
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Split a task over the first pair of cores that can host it.
+ */
+static bool place_split(core_set_t *cores, const rta_task_t *task, rta_assignment_t *assignment) {
+    for (uint8_t c = 0; c < RTA_NUM_CORES; c++) {
+        uint8_t other = (c + 1) % RTA_NUM_CORES;
+        uint32_t budget = core_try_split(&cores[c], &cores[other], task);
+        if (budget > 0) {
+            assignment->core = c;
+            assignment->split_core = other;
+            assignment->budget_us = budget;
+            return true;
+        }
+    }
+    return false;
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Assign tasks to cores using RTA as the fit test.
+ *
+ * Regular tasks are placed first-fit in priority order. With split_on_failure
+ * a task that fits on no core is split instead of rejecting the set, so the
+ * result dominates pure partitioning. Selected tasks are placed last and
+ * split so that their first portion uses the capacity left on a core and the
+ * remainder migrates to the other core; they are only kept whole if they fit
+ * on a single core's leftover capacity.
+ *
+ * @param selected Per-task flag for tasks to split, or NULL
+ * @param split_on_failure Split regular tasks that do not fit (semi-partitioning)
+ * @param assignment Filled with the core(s) and budget of each task
+ * @return true if every task was assigned
+ */
+bool rta_partition(const rta_task_t *tasks, uint8_t num_tasks, const bool *selected,
+                   bool split_on_failure, rta_assignment_t *assignment) {
+    core_set_t cores[RTA_NUM_CORES] = {0};
+    bool assigned[RTA_MAX_TASKS] = {false};
+
+    for (uint8_t n = 0; n < num_tasks; n++) {
+        /* Highest priority unassigned task next, selected tasks last */
+        uint8_t i = num_tasks;
+        for (uint8_t t = 0; t < num_tasks; t++) {
+            bool t_selected = (selected != NULL) && selected[t];
+            bool i_selected = (i < num_tasks) && (selected != NULL) && selected[i];
+            if (assigned[t]) {
+                continue;
+            }
+            if (i == num_tasks || (i_selected && !t_selected) ||
+                (i_selected == t_selected && tasks[t].priority > tasks[i].priority)) {
+                i = t;
+            }
+        }
+        assigned[i] = true;
+        assignment[i].budget_us = 0;
+
+        bool placed;
+        if (selected != NULL && selected[i]) {
+            placed = place_split(cores, &tasks[i], &assignment[i]) ||
+                     place_whole(cores, &tasks[i], &assignment[i]);
+        } else {
+            placed = place_whole(cores, &tasks[i], &assignment[i]) ||
+                     (split_on_failure && place_split(cores, &tasks[i], &assignment[i]));
+        }
+
+        if (!placed) {
+            return false;
+        }
+    }
+    return true;
+}
+/*-----------------------------------------------------------*/
+
+static uint32_t xorshift32(uint32_t *state) {
+    uint32_t x = *state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *state = x;
+    return x;
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief r^(1/m) for r in [0, 1) by bisection, which keeps libm out of the firmware.
+ */
+static float nth_root(float r, uint8_t m) {
+    float low = 0.0f;
+    float high = 1.0f;
+
+    for (int it = 0; it < 24; it++) {
+        float mid = (low + high) / 2.0f;
+        float power = 1.0f;
+        for (uint8_t k = 0; k < m; k++) {
+            power *= mid;
+        }
+        if (power < r) {
+            low = mid;
+        } else {
+            high = mid;
+        }
+    }
+    return low;
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Fraction of random task sets accepted by (semi-)partitioning.
+ *
+ * Six tasks with periods from the lab's period set, implicit deadlines,
+ * rate-monotonic priorities and utilizations drawn with UUniFast.
+ *
+ * @param utilization_pct Total utilization of each set (e.g. 150 = 1.5)
+ * @param num_sets Number of random task sets
+ * @param allow_split Split tasks that do not fit (semi-partitioning)
+ * @param seed PRNG state, updated
+ * @return Accepted task sets in percent
+ */
+uint32_t rta_acceptance_ratio(uint32_t utilization_pct, uint32_t num_sets, bool allow_split,
+                              uint32_t *seed) {
+    static const uint32_t periods_ms[] = {5, 10, 20, 25, 50, 100};
+    const uint8_t num_tasks = 6;
+    rta_task_t tasks[RTA_MAX_TASKS];
+    rta_assignment_t assignment[RTA_MAX_TASKS];
+    uint32_t accepted = 0;
+
+    for (uint32_t s = 0; s < num_sets; s++) {
+        float remaining = utilization_pct / 100.0f;
+
+        for (uint8_t i = 0; i < num_tasks; i++) {
+            float u = remaining;
+            if (i < num_tasks - 1) {
+                /* UUniFast: next = remaining * rand^(1 / (n - i - 1)) */
+                float r = (xorshift32(seed) & 0xFFFFFF) / (float)0x1000000;
+                float next = remaining * nth_root(r, num_tasks - i - 1);
+                u = remaining - next;
+                remaining = next;
+            }
+
+            uint32_t period_ms = periods_ms[xorshift32(seed) % 6];
+            tasks[i].period_us = period_ms * 1000;
+            tasks[i].deadline_us = tasks[i].period_us;
+            tasks[i].wcet_us = (uint32_t)(u * tasks[i].period_us);
+            if (tasks[i].wcet_us == 0) {
+                tasks[i].wcet_us = 1;
+            }
+            tasks[i].jitter_us = 0;
+            tasks[i].priority = (uint8_t)(200 - period_ms);  /* Rate monotonic */
+        }
+
+        if (rta_partition(tasks, num_tasks, NULL, allow_split, assignment)) {
+            accepted++;
+        }
+    }
+    return (accepted * 100) / num_sets;
+}
+/*-----------------------------------------------------------*/
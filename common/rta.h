@@ -0,0 +1,49 @@
+#ifndef RTA_H
+#define RTA_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define RTA_MAX_TASKS 8
+#define RTA_NUM_CORES 2
+#define RTA_UNSCHEDULABLE UINT32_MAX
+#define RTA_SPLIT_PRIORITY UINT8_MAX  /* Priority of the first portion of a split task */
+
+/* Fixed-priority task (or portion of a split task) for response-time analysis */
+typedef struct {
+    uint32_t period_us;
+    uint32_t deadline_us;   /* Relative to the task's release */
+    uint32_t wcet_us;
+    uint32_t jitter_us;     /* Release jitter, e.g. response time of a previous portion */
+    uint8_t priority;       /* Larger value = higher priority (FreeRTOS convention) */
+} rta_task_t;
+
+/* Interrupt source: sporadic interference above every task's priority */
+typedef struct {
+    uint32_t min_interarrival_us;
+    uint32_t wcet_us;
+} rta_irq_t;
+
+/* Core assignment of a task. Split tasks run budget_us on core at the
+ * highest priority, then migrate and run the remainder on split_core at
+ * their own priority. */
+typedef struct {
+    uint8_t core;
+    uint8_t split_core;
+    uint32_t budget_us;     /* 0 = not split */
+} rta_assignment_t;
+
+uint32_t rta_response_time(const rta_task_t *tasks, uint8_t num_tasks, uint8_t i);
+uint64_t rta_irq_interference(const rta_irq_t *irqs, uint8_t num_irqs, uint64_t window_us);
+uint32_t rta_response_time_irq(const rta_task_t *tasks, uint8_t num_tasks, uint8_t i,
+                               const rta_irq_t *irqs, uint8_t num_irqs);
+bool rta_schedulable(const rta_task_t *tasks, uint8_t num_tasks);
+uint32_t rta_response_time_supply(const rta_task_t *tasks, uint8_t num_tasks, uint8_t i,
+                                  uint32_t resource_period_us, uint32_t resource_budget_us);
+uint32_t rta_min_supply_budget(const rta_task_t *tasks, uint8_t num_tasks, uint32_t resource_period_us);
+bool rta_partition(const rta_task_t *tasks, uint8_t num_tasks, const bool *selected,
+                   bool split_on_failure, rta_assignment_t *assignment);
+uint32_t rta_acceptance_ratio(uint32_t utilization_pct, uint32_t num_sets, bool allow_split,
+                              uint32_t *seed);
+
+#endif /* RTA_H */
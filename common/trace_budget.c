@@ -0,0 +1,121 @@
+/**
+ * @file trace_budget.c
+ * @brief CPU time budget of the periodic reports: chooses between full
+ *        reports, full reports on a fixed 1-of-N sampling grid and
+ *        summaries, from the measured cost of each kind of report.
+ *
+ * Sampling is deterministic, so a trend shows up at a steady rate instead
+ * of in random gaps. Periods with a deadline miss or a skipped job always
+ * get a full report; their cost is taken from later periods' budget.
+ */
+#include <stdio.h>
+#include "trace_budget.h"
+
+/**
+ * @brief Start with full reports until their cost is known.
+ */
+void trace_budget_init(trace_budget_t *tb, uint32_t budget_us) {
+    *tb = (trace_budget_t){ .budget_us = budget_us, .mode = TRACE_FULL, .sample_every = 1 };
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Mode from the cost estimates: a full report every N periods and
+ *        summaries in between must fit in N periods of budget.
+ */
+static void update_mode(trace_budget_t *tb) {
+    uint32_t full = tb->full_cost_us;
+    uint32_t summary = tb->summary_cost_us;
+
+    if (full <= tb->budget_us) {
+        tb->mode = TRACE_FULL;
+        tb->sample_every = 1;
+    } else if (summary >= tb->budget_us) {
+        tb->mode = TRACE_SUMMARY;
+    } else {
+        uint32_t n = (full - summary + (tb->budget_us - summary) - 1) / (tb->budget_us - summary);
+        tb->mode = (n <= TRACE_MAX_SAMPLE_EVERY) ? TRACE_SAMPLED : TRACE_SUMMARY;
+        tb->sample_every = n;
+    }
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Start of a period's report: full report or summary.
+ *
+ * @param anomaly The period missed a deadline or skipped a job
+ * @return true for a full report
+ */
+bool trace_budget_detail(trace_budget_t *tb, bool anomaly) {
+    bool detail;
+    int64_t cap = (int64_t)tb->budget_us * TRACE_MAX_SAMPLE_EVERY;
+
+    tb->periods++;
+    tb->since_full++;
+    tb->credit_us += tb->budget_us;
+    if (tb->credit_us > cap) {
+        tb->credit_us = cap;
+    }
+
+    switch (tb->mode) {
+    case TRACE_FULL:
+        detail = true;
+        break;
+    case TRACE_SAMPLED:
+        /* On the grid; a sample after an escalation waits for the credit */
+        detail = (tb->since_full >= tb->sample_every && tb->credit_us >= (int64_t)tb->full_cost_us);
+        break;
+    default:
+        detail = false;
+        break;
+    }
+
+    if (anomaly && !detail) {
+        detail = true;
+        tb->escalations++;
+    }
+    if (detail) {
+        tb->since_full = 0;
+        tb->full_reports++;
+    } else {
+        tb->detail_dropped++;
+    }
+    return detail;
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief End of a period's report: charge its measured cost.
+ *
+ * @param detail The report was a full one
+ */
+void trace_budget_charge(trace_budget_t *tb, bool detail, uint32_t cost_us) {
+    uint32_t *estimate = detail ? &tb->full_cost_us : &tb->summary_cost_us;
+
+    /* First measurement taken as is, then averaged over ~4 reports */
+    *estimate = (*estimate == 0) ? cost_us : *estimate - (*estimate >> 2) + (cost_us >> 2);
+    tb->last_cost_us = cost_us;
+    tb->spent_us += cost_us;
+    tb->credit_us -= cost_us;
+    update_mode(tb);
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Print the budget consumption and the detail given up.
+ */
+void trace_budget_print(const trace_budget_t *tb) {
+    static const char *mode_names[] = { "full", "sampled", "summary" };
+    uint32_t mean_us = (tb->periods > 0) ? (uint32_t)(tb->spent_us / tb->periods) : 0;
+
+    printf("Trace budget: %s", mode_names[tb->mode]);
+    if (tb->mode == TRACE_SAMPLED) {
+        printf(" 1/%u", tb->sample_every);
+    }
+    printf(", %u us per period, spent last %u us mean %u us, credit %lld us\n",
+           tb->budget_us, tb->last_cost_us, mean_us, tb->credit_us);
+    printf("  report cost: full %u us, summary %u us; detail dropped %u of %u periods, "
+           "%u escalation(s)\n", tb->full_cost_us, tb->summary_cost_us,
+           tb->detail_dropped, tb->periods, tb->escalations);
+}
+/*-----------------------------------------------------------*/
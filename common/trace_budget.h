@@ -0,0 +1,40 @@
+#ifndef TRACE_BUDGET_H
+#define TRACE_BUDGET_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define TRACE_MAX_SAMPLE_EVERY 16  /* Sparsest sampling before falling back to summaries */
+
+/* Report detail the budget affords */
+typedef enum {
+    TRACE_FULL,      /* Full report every period */
+    TRACE_SAMPLED,   /* Full report 1 of sample_every periods, summaries in between */
+    TRACE_SUMMARY    /* Summaries only; full reports only for anomalies */
+} trace_mode_t;
+
+/* CPU time budget of the periodic reports. Each period earns budget_us of
+ * credit and each report is charged its measured cost; a period with an
+ * anomaly always gets a full report, even on credit. */
+typedef struct {
+    uint32_t budget_us;         /* Per period */
+    trace_mode_t mode;
+    uint32_t sample_every;      /* Periods per full report in TRACE_SAMPLED */
+    int64_t credit_us;          /* Unspent budget, negative after escalations */
+    uint32_t full_cost_us;      /* Running average of a full report */
+    uint32_t summary_cost_us;   /* Running average of a summary */
+    uint32_t last_cost_us;
+    uint32_t since_full;        /* Periods since the last full report */
+    uint32_t periods;
+    uint32_t full_reports;
+    uint32_t escalations;       /* Full reports forced by an anomaly */
+    uint32_t detail_dropped;    /* Periods reported as a summary only */
+    uint64_t spent_us;          /* Total report time */
+} trace_budget_t;
+
+void trace_budget_init(trace_budget_t *tb, uint32_t budget_us);
+bool trace_budget_detail(trace_budget_t *tb, bool anomaly);
+void trace_budget_charge(trace_budget_t *tb, bool detail, uint32_t cost_us);
+void trace_budget_print(const trace_budget_t *tb);
+
+#endif /* TRACE_BUDGET_H */
@@ -10,8 +10,19 @@
 #include <stdio.h>
 #include <inttypes.h>
 #include "bsp.h" 
+#include "hardware/timer.h"
+#include "hardware/regs/addressmap.h"
 #include "workload.h"
 
+#define STRESS_SRAM_BYTES  (64 * 1024)
+#define STRESS_BANK_BYTES  (1 * 1024)   /* Scratch X also holds core 1's stack */
+#define STRESS_XIP_BYTES   (32 * 1024)
+
+/* Buffers touched by the memory interference kernels */
+static uint32_t stress_sram[STRESS_SRAM_BYTES / 4];
+static uint32_t __scratch_x("stress") stress_bank[STRESS_BANK_BYTES / 4];
+static const uint32_t stress_xip[STRESS_XIP_BYTES / 4] = { 1 };  /* const: stays in flash */
+
 void job_A(jobReturn_t* retval) {
     retval->start = time_us_64();
 
@@ -30,9 +41,32 @@ void job_B(jobReturn_t* retval) {
 }
 /*-----------------------------------------------------------*/
 
-void job_C(jobReturn_t* retval) {
-    retval->start = time_us_64();
+static switch_source_t switch_source = NULL;  /* NULL: GPIO switches */
+
+/**
+ * @brief Replace the GPIO switches as the input of Task_C, e.g. by a
+ *        generated input sequence. NULL restores the switches.
+ */
+void workload_set_switch_source(switch_source_t source) {
+    switch_source = source;
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Current switch value (0-255) of the selected input
+ */
+uint8_t workload_switch_value(void) {
+    if (switch_source != NULL) {
+        return switch_source();
+    }
+    return workload_read_switches();
+}
+/*-----------------------------------------------------------*/
 
+/**
+ * @brief Switch value (0-255) read from the GPIO switches
+ */
+uint8_t workload_read_switches(void) {
     // Read GPIO switches to determine delay time
     bool bit7 = BSP_GetInput(SW_10);  /* SW_10 - MSB */
     bool bit6 = BSP_GetInput(SW_11);  /* SW_11 */
@@ -44,15 +78,40 @@ void job_C(jobReturn_t* retval) {
     bool bit0 = BSP_GetInput(SW_17);  /* SW_17 - LSB */
 
     // Construct 8-bit value from switches (0-255)
-    uint8_t switch_value = (bit7 << 7) | (bit6 << 6) | (bit5 << 5) | (bit4 << 4) |
-                           (bit3 << 3) | (bit2 << 2) | (bit1 << 1) | bit0;
+    return (bit7 << 7) | (bit6 << 6) | (bit5 << 5) | (bit4 << 4) |
+           (bit3 << 3) | (bit2 << 2) | (bit1 << 1) | bit0;
+}
+/*-----------------------------------------------------------*/
 
-    // Calculate delay time: map 0-255 to 0-8000us, then subtract 10us
-    // (switch_value * 8000 / 256) - 10 = (switch_value * 31.25) - 10
-    uint32_t delay_us = ((switch_value * 8000) / 256) - 10;
-    uint32_t delay_cycles = delay_us * CYCLES_PER_US;
+/**
+ * @brief Execution time of a Task_C job at a switch value: 0-255 mapped to
+ *        0-8000 us, the time the schedulers budget and forecast for the job
+ */
+uint32_t job_C_exec_us(uint8_t switch_value) {
+    return ((uint32_t)switch_value * 8000) / 256;
+}
+/*-----------------------------------------------------------*/
 
-    BSP_WaitClkCycles(delay_cycles);
+/**
+ * @brief Execution time of Task_C selected by the GPIO switches
+ *
+ * The busy-wait is JOB_C_OVERHEAD_US shorter than job_C_exec_us(), for the
+ * job's own overhead. At switch 0 the job returns at once instead of
+ * wrapping to a ~28 s wait.
+ *
+ * @return Busy-wait length of the next Task_C job in clock cycles
+ */
+uint32_t job_C_cycles(void) {
+    uint32_t exec_us = job_C_exec_us(workload_switch_value());
+    uint32_t delay_us = (exec_us > JOB_C_OVERHEAD_US) ? exec_us - JOB_C_OVERHEAD_US : 0;
+    return delay_us * CYCLES_PER_US;
+}
+/*-----------------------------------------------------------*/
+
+void job_C(jobReturn_t* retval) {
+    retval->start = time_us_64();
+
+    BSP_WaitClkCycles(job_C_cycles());
 
     retval->stop = time_us_64();
 }
@@ -83,4 +142,106 @@ void job_F(jobReturn_t* retval) {
 
     retval->stop = time_us_64();
 }
-/*-----------------------------------------------------------*/
\ No newline at end of file
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Busy-wait for an explicit number of cycles (portions of split jobs).
+ */
+void job_run_cycles(jobReturn_t* retval, uint32_t cycles) {
+    retval->start = time_us_64();
+
+    BSP_WaitClkCycles(cycles);
+
+    retval->stop = time_us_64();
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Run one segment of a divisible busy-wait.
+ *
+ * The work is split into equal parts; the last segment also takes the
+ * remainder so that all segments together execute exactly `cycles`.
+ */
+static void run_segment(uint32_t cycles, uint8_t segment, uint8_t num_segments, jobReturn_t* retval) {
+    uint32_t part = cycles / num_segments;
+
+    if (segment == num_segments - 1) {
+        part += cycles % num_segments;
+    }
+
+    job_run_cycles(retval, part);
+}
+/*-----------------------------------------------------------*/
+
+void job_E_segment(jobReturn_t* retval, uint8_t segment, uint8_t num_segments) {
+    run_segment(EXECUTION_TIME_E, segment, num_segments, retval);
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Memory/peripheral access kernel with a configurable pattern.
+ *
+ * @param cfg Target, access pattern and footprint
+ * @param accesses Number of word accesses to perform
+ * @return Sum of the values read, so the accesses cannot be optimized away
+ */
+uint32_t mem_stress(const mem_stress_t* cfg, uint32_t accesses) {
+    volatile uint32_t* base;
+    uint32_t words;
+    uint32_t sum = 0;
+    uint32_t index = 0;
+    uint32_t lcg = 12345;
+
+    switch (cfg->target) {
+    case MEM_TARGET_SRAM_BANK:
+        base = stress_bank;
+        words = STRESS_BANK_BYTES / 4;
+        break;
+    case MEM_TARGET_XIP:
+        /* Same flash contents, but every read goes to the QSPI flash */
+        base = (volatile uint32_t*)((uintptr_t)stress_xip - XIP_BASE + XIP_NOCACHE_NOALLOC_BASE);
+        words = STRESS_XIP_BYTES / 4;
+        break;
+    case MEM_TARGET_PERIPH:
+        base = (volatile uint32_t*)&timer_hw->timerawl;
+        words = 1;
+        break;
+    case MEM_TARGET_SRAM:
+    default:
+        base = stress_sram;
+        words = STRESS_SRAM_BYTES / 4;
+        break;
+    }
+    if (cfg->footprint / 4 != 0 && cfg->footprint / 4 < words) {
+        words = cfg->footprint / 4;
+    }
+
+    uint32_t step = (cfg->pattern == MEM_ACCESS_STRIDED && cfg->stride >= 4) ? cfg->stride / 4 : 1;
+    bool write = cfg->write && (cfg->target == MEM_TARGET_SRAM || cfg->target == MEM_TARGET_SRAM_BANK);
+
+    for (uint32_t i = 0; i < accesses; i++) {
+        if (write) {
+            base[index] += 1;
+        } else {
+            sum += base[index];
+        }
+
+        if (cfg->pattern == MEM_ACCESS_RANDOM) {
+            lcg = lcg * 1664525u + 1013904223u;
+            index = (lcg >> 8) % words;
+        } else {
+            index = (index + step) % words;
+        }
+    }
+    return sum;
+}
+/*-----------------------------------------------------------*/
+
+void job_mem_stress(jobReturn_t* retval, const mem_stress_t* cfg, uint32_t accesses) {
+    retval->start = time_us_64();
+
+    (void)mem_stress(cfg, accesses);
+
+    retval->stop = time_us_64();
+}
+/*-----------------------------------------------------------*/
@@ -11,11 +11,18 @@
 #define EXECUTION_TIME_E ((4 * CYCLES_PER_MS) - (CYCLES_PER_US * 10))
 #define EXECUTION_TIME_F ((2 * CYCLES_PER_MS) - (CYCLES_PER_US * 10))
 
+/* Task_C's execution time follows the switches; this is all switches on */
+#define JOB_C_OVERHEAD_US 10  /* Left out of Task_C's busy-wait for the job's overhead */
+#define EXECUTION_TIME_C_MAX ((((255 * 8000) / 256) - JOB_C_OVERHEAD_US) * CYCLES_PER_US)
+
 typedef struct {
     uint64_t start;
     uint64_t stop;
 } jobReturn_t;
 
+/* Divisible job: runs segment `segment` of `num_segments` equal parts */
+typedef void (*job_segment_t)(jobReturn_t* retval, uint8_t segment, uint8_t num_segments);
+
 void job_A(jobReturn_t* retval);
 void job_B(jobReturn_t* retval);
 void job_C(jobReturn_t* retval);
@@ -23,4 +30,42 @@ void job_D(jobReturn_t* retval);
 void job_E(jobReturn_t* retval);
 void job_F(jobReturn_t* retval);
 
+void job_E_segment(jobReturn_t* retval, uint8_t segment, uint8_t num_segments);
+
+/* Source of the 8-bit switch value that selects Task_C's execution time */
+typedef uint8_t (*switch_source_t)(void);
+
+void workload_set_switch_source(switch_source_t source);
+uint8_t workload_switch_value(void);
+uint8_t workload_read_switches(void);
+uint32_t job_C_exec_us(uint8_t switch_value);
+uint32_t job_C_cycles(void);
+void job_run_cycles(jobReturn_t* retval, uint32_t cycles);
+
+/* Memory interference kernels: unlike the busy-waits above they contend
+ * for the bus fabric, so they can inflate the other core's jobs. */
+typedef enum {
+    MEM_TARGET_SRAM,       /* Striped main SRAM (banks 0-7) */
+    MEM_TARGET_SRAM_BANK,  /* Single non-striped bank (scratch X, SRAM8) */
+    MEM_TARGET_XIP,        /* XIP flash through the uncached alias */
+    MEM_TARGET_PERIPH      /* APB peripheral register reads (timer) */
+} mem_target_t;
+
+typedef enum {
+    MEM_ACCESS_SEQUENTIAL, /* Consecutive words */
+    MEM_ACCESS_STRIDED,    /* Fixed stride in bytes */
+    MEM_ACCESS_RANDOM      /* Pseudo-random words within the footprint */
+} mem_access_t;
+
+typedef struct {
+    mem_target_t target;
+    mem_access_t pattern;
+    uint32_t stride;       /* Bytes between accesses (MEM_ACCESS_STRIDED) */
+    uint32_t footprint;    /* Bytes covered, clipped to the target buffer */
+    bool write;            /* Read-modify-write instead of read (SRAM targets) */
+} mem_stress_t;
+
+uint32_t mem_stress(const mem_stress_t* cfg, uint32_t accesses);
+void job_mem_stress(jobReturn_t* retval, const mem_stress_t* cfg, uint32_t accesses);
+
 #endif /* WORKLOAD_H */